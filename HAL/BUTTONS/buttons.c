@@ -0,0 +1,194 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Button Driver
+ *  File        : buttons.c
+ *  Description : Interrupt driven, timer debounced seat heating level buttons
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "HAL/BUTTONS/buttons.h"
+#include "HAL/BUTTONS/debounce.h"
+#include "gpio.h"
+#include "GPTM.h"
+#include "SERVICES/TRACE/trace.h"
+
+/*------------------------------------------------------------------------------
+ *  LOCAL DEFINITIONS
+ *----------------------------------------------------------------------------*/
+#define BUTTONS_PRESSED_LEVEL   0   /**< Buttons pull the pin low, pull-ups are enabled */
+
+/*------------------------------------------------------------------------------
+ *  LOCAL DATA
+ *----------------------------------------------------------------------------*/
+
+/*
+ * GPIOPortF_Handler, GPIOPortB_Handler and TIMER1A_Handler share one priority,
+ * so they never preempt each other and the state below needs no locking.
+ */
+static DEBOUNCE_StateType asButtonsState[BUTTONS_COUNT];
+static BUTTONS_CallbackType pfButtonsPressCallback = 0;
+
+/*------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Samples a button pin
+ * @return 1 if the button is pressed
+ */
+static uint8_t prvButtonIsPressed(BUTTONS_IdType eButton)
+{
+    switch(eButton)
+    {
+        case BUTTONS_SW1: return (GPIO_SW1GetState() == BUTTONS_PRESSED_LEVEL);
+        case BUTTONS_SW2: return (GPIO_SW2GetState() == BUTTONS_PRESSED_LEVEL);
+        default:          return (GPIO_EXTSWGetState() == BUTTONS_PRESSED_LEVEL);
+    }
+}
+
+/**
+ * @brief Masks or unmasks the edge interrupt of a button
+ */
+static void prvButtonEdgeInterruptSet(BUTTONS_IdType eButton, uint8_t ui8Enable)
+{
+    switch(eButton)
+    {
+        case BUTTONS_SW1:
+            if(ui8Enable) GPIO_PortFInterruptEnable(GPIO_SW1_PIN_MASK); else GPIO_PortFInterruptDisable(GPIO_SW1_PIN_MASK);
+            break;
+        case BUTTONS_SW2:
+            if(ui8Enable) GPIO_PortFInterruptEnable(GPIO_SW2_PIN_MASK); else GPIO_PortFInterruptDisable(GPIO_SW2_PIN_MASK);
+            break;
+        default:
+            if(ui8Enable) GPIO_PortBInterruptEnable(GPIO_EXTSW_PIN_MASK); else GPIO_PortBInterruptDisable(GPIO_EXTSW_PIN_MASK);
+            break;
+    }
+}
+
+/**
+ * @brief Reports a debounced press to the application
+ */
+static void prvButtonNotify(BUTTONS_IdType eButton, DEBOUNCE_EventType eEvent)
+{
+    if((eEvent == DEBOUNCE_EVENT_PRESS) && (pfButtonsPressCallback != 0))
+    {
+        pfButtonsPressCallback(eButton);
+    }
+}
+
+/**
+ * @brief Handles an edge interrupt of one button
+ *
+ * The pin interrupt stays masked while the button bounces; the debounce timer
+ * samples it instead and unmasks it once the button is idle again.
+ */
+static void prvButtonEdge(BUTTONS_IdType eButton)
+{
+    prvButtonEdgeInterruptSet(eButton, 0);
+    prvButtonNotify(eButton, DEBOUNCE_edge(&asButtonsState[eButton], prvButtonIsPressed(eButton)));
+
+    if(!GPTM_Timer1IsRunning())
+    {
+        GPTM_Timer1Start();
+    }
+}
+
+/*------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Arms the edge interrupts of all buttons and the debounce timer
+ */
+void BUTTONS_init(BUTTONS_CallbackType pfPressCallback)
+{
+    uint8_t ui8Button;
+
+    for(ui8Button = 0; ui8Button < BUTTONS_COUNT; ui8Button++)
+    {
+        DEBOUNCE_init(&asButtonsState[ui8Button]);
+    }
+    pfButtonsPressCallback = pfPressCallback;
+
+    GPTM_Timer1PeriodicInit(BUTTONS_TICK_PERIOD_MS);
+    GPIO_SW1EdgeTriggeredInterruptInit();
+    GPIO_SW2EdgeTriggeredInterruptInit();
+    GPIO_EXTSWEdgeTriggeredInterruptInit();
+}
+
+/**
+ * @brief GPIO PORTF interrupt: SW1 and SW2 edges
+ */
+void GPIOPortF_Handler(void)
+{
+    uint32 ui32Status;
+
+    TRACE_ISR_ENTER(TRACE_ISR_GPIOF);
+    ui32Status = GPIO_PortFGetInterruptStatus();
+    if(ui32Status & GPIO_SW1_PIN_MASK)
+    {
+        prvButtonEdge(BUTTONS_SW1);
+    }
+    if(ui32Status & GPIO_SW2_PIN_MASK)
+    {
+        prvButtonEdge(BUTTONS_SW2);
+    }
+    TRACE_ISR_EXIT(TRACE_ISR_GPIOF);
+}
+
+/**
+ * @brief GPIO PORTB interrupt: external button edge
+ */
+void GPIOPortB_Handler(void)
+{
+    TRACE_ISR_ENTER(TRACE_ISR_GPIOB);
+    if(GPIO_PortBGetInterruptStatus() & GPIO_EXTSW_PIN_MASK)
+    {
+        prvButtonEdge(BUTTONS_EXT);
+    }
+    TRACE_ISR_EXIT(TRACE_ISR_GPIOB);
+}
+
+/**
+ * @brief Timer1A interrupt: one debounce sample of every active button
+ *
+ * The timer is stopped once every button is idle, so it only wakes the CPU
+ * for a few ticks around each press.
+ */
+void TIMER1A_Handler(void)
+{
+    uint8_t ui8Button;
+    uint8_t ui8Active = 0;
+
+    TRACE_ISR_ENTER(TRACE_ISR_TIMER1A);
+    GPTM_Timer1ClearInterrupt();
+
+    for(ui8Button = 0; ui8Button < BUTTONS_COUNT; ui8Button++)
+    {
+        DEBOUNCE_StateType *psState = &asButtonsState[ui8Button];
+
+        if(DEBOUNCE_isIdle(psState))
+        {
+            continue;
+        }
+
+        prvButtonNotify((BUTTONS_IdType)ui8Button, DEBOUNCE_tick(psState, prvButtonIsPressed((BUTTONS_IdType)ui8Button)));
+
+        if(DEBOUNCE_isIdle(psState))
+        {
+            prvButtonEdgeInterruptSet((BUTTONS_IdType)ui8Button, 1);
+        }
+        else
+        {
+            ui8Active++;
+        }
+    }
+
+    if(ui8Active == 0)
+    {
+        GPTM_Timer1Stop();
+    }
+    TRACE_ISR_EXIT(TRACE_ISR_TIMER1A);
+}
@@ -0,0 +1,65 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Button Driver
+ *  File        : buttons.h
+ *  Description : Interrupt driven, timer debounced seat heating level buttons
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef HAL_BUTTONS_BUTTONS_H_
+#define HAL_BUTTONS_BUTTONS_H_
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Buttons_Configuration Button settings
+ * @{
+ */
+#define BUTTONS_TICK_PERIOD_MS   5    /**< Debounce sampling period, Timer1A only runs while a button settles */
+/** @} */
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Buttons handled by the driver
+ */
+typedef enum {
+    BUTTONS_SW1,      /**< On-board SW1 (PF4) */
+    BUTTONS_SW2,      /**< On-board SW2 (PF0) */
+    BUTTONS_EXT,      /**< External button (PB0) */
+    BUTTONS_COUNT
+} BUTTONS_IdType;
+
+/**
+ * @brief Press notification, called from interrupt context (priority 5)
+ */
+typedef void (*BUTTONS_CallbackType)(BUTTONS_IdType eButton);
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Buttons_Functions Button Functions
+ * @{
+ */
+
+/**
+ * @brief Arms the edge interrupts of all buttons and the debounce timer
+ * @param pfPressCallback Called once for every debounced press
+ *
+ * The pins must already be configured as inputs by GPIO_BuiltinButtonsLedsInit().
+ */
+void BUTTONS_init(BUTTONS_CallbackType pfPressCallback);
+
+/** @} */
+
+#endif /* HAL_BUTTONS_BUTTONS_H_ */
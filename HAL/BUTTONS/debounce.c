@@ -0,0 +1,99 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Button Driver
+ *  File        : debounce.c
+ *  Description : Hardware independent debounce state machine for push buttons
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "HAL/BUTTONS/debounce.h"
+
+/*------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Puts a button in the idle state
+ */
+void DEBOUNCE_init(DEBOUNCE_StateType *psState)
+{
+    psState->eState = DEBOUNCE_STATE_IDLE;
+    psState->ui8Count = 0;
+}
+
+/**
+ * @brief Feeds an edge interrupt
+ *
+ * A press is reported on the leading edge, so the latency is the interrupt
+ * latency; the bounce that follows is absorbed by the PRESSED state.
+ */
+DEBOUNCE_EventType DEBOUNCE_edge(DEBOUNCE_StateType *psState, uint8_t ui8Pressed)
+{
+    if(psState->eState != DEBOUNCE_STATE_IDLE)
+    {
+        return DEBOUNCE_EVENT_NONE;
+    }
+
+    psState->ui8Count = 0;
+    if(ui8Pressed)
+    {
+        psState->eState = DEBOUNCE_STATE_PRESSED;
+        return DEBOUNCE_EVENT_PRESS;
+    }
+
+    /* Bounced back before the pin was read, or a spike: let the samples decide */
+    psState->eState = DEBOUNCE_STATE_SETTLING;
+    return DEBOUNCE_EVENT_NONE;
+}
+
+/**
+ * @brief Feeds one periodic sample of the pin
+ */
+DEBOUNCE_EventType DEBOUNCE_tick(DEBOUNCE_StateType *psState, uint8_t ui8Pressed)
+{
+    switch(psState->eState)
+    {
+        case DEBOUNCE_STATE_SETTLING:
+            if(!ui8Pressed)
+            {
+                /* Released on the first sample already: it was a spike */
+                psState->eState = DEBOUNCE_STATE_IDLE;
+                psState->ui8Count = 0;
+            }
+            else if(++psState->ui8Count >= DEBOUNCE_PRESS_TICKS)
+            {
+                psState->eState = DEBOUNCE_STATE_PRESSED;
+                psState->ui8Count = 0;
+                return DEBOUNCE_EVENT_PRESS;
+            }
+            break;
+
+        case DEBOUNCE_STATE_PRESSED:
+            if(ui8Pressed)
+            {
+                psState->ui8Count = 0;
+            }
+            else if(++psState->ui8Count >= DEBOUNCE_RELEASE_TICKS)
+            {
+                psState->eState = DEBOUNCE_STATE_IDLE;
+                psState->ui8Count = 0;
+                return DEBOUNCE_EVENT_RELEASE;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return DEBOUNCE_EVENT_NONE;
+}
+
+/**
+ * @brief Tells whether the button needs no more ticks
+ */
+uint8_t DEBOUNCE_isIdle(const DEBOUNCE_StateType *psState)
+{
+    return (psState->eState == DEBOUNCE_STATE_IDLE);
+}
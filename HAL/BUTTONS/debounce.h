@@ -0,0 +1,96 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Button Driver
+ *  File        : debounce.h
+ *  Description : Hardware independent debounce state machine for push buttons
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef HAL_BUTTONS_DEBOUNCE_H_
+#define HAL_BUTTONS_DEBOUNCE_H_
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Debounce_Configuration Debounce timing, in ticks of the debounce timer
+ * @{
+ */
+#define DEBOUNCE_PRESS_TICKS     2     /**< Stable pressed ticks to accept a press whose edge was a glitch */
+#define DEBOUNCE_RELEASE_TICKS   4     /**< Stable released ticks before the button is idle again */
+/** @} */
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Debouncer states
+ */
+typedef enum {
+    DEBOUNCE_STATE_IDLE,       /**< Released and stable, waiting for an edge interrupt */
+    DEBOUNCE_STATE_SETTLING,   /**< Edge seen but the pin read released, confirming by sampling */
+    DEBOUNCE_STATE_PRESSED     /**< Press reported, waiting for a stable release */
+} DEBOUNCE_StateIdType;
+
+/**
+ * @brief Events reported by the debouncer
+ */
+typedef enum {
+    DEBOUNCE_EVENT_NONE,
+    DEBOUNCE_EVENT_PRESS,
+    DEBOUNCE_EVENT_RELEASE
+} DEBOUNCE_EventType;
+
+/**
+ * @brief Per-button debouncer state
+ */
+typedef struct {
+    DEBOUNCE_StateIdType eState;   /**< Current state */
+    uint8_t ui8Count;              /**< Consecutive samples counted in the current state */
+} DEBOUNCE_StateType;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Debounce_Functions Debounce State Machine
+ * @{
+ */
+
+/**
+ * @brief Puts a button in the idle state
+ */
+void DEBOUNCE_init(DEBOUNCE_StateType *psState);
+
+/**
+ * @brief Feeds an edge interrupt
+ * @param ui8Pressed Pin level read in the interrupt, 1 if the button is pressed
+ * @return DEBOUNCE_EVENT_PRESS straight away when an idle button reads pressed
+ *
+ * Edges are ignored outside the idle state; the caller is expected to mask
+ * the pin interrupt until DEBOUNCE_isIdle() is true again.
+ */
+DEBOUNCE_EventType DEBOUNCE_edge(DEBOUNCE_StateType *psState, uint8_t ui8Pressed);
+
+/**
+ * @brief Feeds one periodic sample of the pin
+ * @param ui8Pressed Pin level, 1 if the button is pressed
+ * @return Event confirmed by this sample
+ */
+DEBOUNCE_EventType DEBOUNCE_tick(DEBOUNCE_StateType *psState, uint8_t ui8Pressed);
+
+/**
+ * @brief Tells whether the button needs no more ticks
+ */
+uint8_t DEBOUNCE_isIdle(const DEBOUNCE_StateType *psState);
+
+/** @} */
+
+#endif /* HAL_BUTTONS_DEBOUNCE_H_ */
@@ -0,0 +1,44 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Heater Driver
+ *  File        : heater.c
+ *  Description : Seat heater outputs driven by hardware PWM
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "HAL/HEATER/heater.h"
+#include "pwm.h"
+
+/*------------------------------------------------------------------------------
+ *  LOCAL DATA
+ *----------------------------------------------------------------------------*/
+
+/** PWM output wired to each heater */
+static const PWM_ChannelType aeHeaterChannels[HEATER_SEAT_COUNT] = {
+    PWM_CHANNEL_PF3, PWM_CHANNEL_PB2
+};
+
+/*------------------------------------------------------------------------------
+ *  GLOBAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Starts the PWM outputs of all heaters at 0% duty
+ */
+void HEATER_init(void)
+{
+    PWM_Init();
+}
+
+/**
+ * @brief Commands the duty cycle of a heater
+ */
+void HEATER_setDuty(HEATER_SeatType eSeat, uint8_t ui8DutyPercent)
+{
+    if(eSeat < HEATER_SEAT_COUNT)
+    {
+        PWM_SetDuty(aeHeaterChannels[eSeat], ui8DutyPercent);
+    }
+}
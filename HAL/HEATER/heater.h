@@ -0,0 +1,53 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Heater Driver
+ *  File        : heater.h
+ *  Description : Seat heater outputs driven by hardware PWM
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef HAL_HEATER_HEATER_H_
+#define HAL_HEATER_HEATER_H_
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Heater outputs
+ */
+typedef enum {
+    HEATER_SEAT1,     /**< PF3 (on-board green LED), PWM module 1 */
+    HEATER_SEAT2,     /**< PB2 (external green LED), Timer3A PWM */
+    HEATER_SEAT_COUNT
+} HEATER_SeatType;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Heater_Functions Heater Output Functions
+ * @{
+ */
+
+/**
+ * @brief Starts the PWM outputs of all heaters at 0% duty
+ *
+ * Call after GPIO_BuiltinButtonsLedsInit() and RGB_init(), which set the pins up as plain GPIO.
+ */
+void HEATER_init(void);
+
+/**
+ * @brief Commands the duty cycle of a heater
+ * @param ui8DutyPercent 0-100, held by the hardware until the next call
+ */
+void HEATER_setDuty(HEATER_SeatType eSeat, uint8_t ui8DutyPercent);
+
+/** @} */
+
+#endif /* HAL_HEATER_HEATER_H_ */
@@ -9,100 +9,208 @@
  *  INCLUDES
  *----------------------------------------------------------------------------*/
 #include "HAL/POTS/pots.h"
+#include "HAL/POTS/pots_filter.h"
 #include <stdint.h>
+#include <stdbool.h>
 #include "inc/hw_memmap.h"
 #include "driverlib/adc.h"
 #include "driverlib/gpio.h"
 #include "driverlib/sysctl.h"
+#include "driverlib/interrupt.h"
+#include "inc/hw_ints.h"
+#include "GPTM.h"
+#include "SERVICES/SPSC_RING/spsc_ring.h"
+#include "SERVICES/TRACE/trace.h"
 
 /*------------------------------------------------------------------------------
  *  LOCAL DEFINITIONS
  *----------------------------------------------------------------------------*/
-#define ADC_SEQUENCE_NUM       3   /**< ADC sequence number to use */
-#define ADC_SAMPLE_WAIT        false /**< Don't wait for samples when checking status */
+#define ADC_SEQUENCE_NUM       1   /**< ADC sequence number to use (4 steps deep) */
+#define ADC_SEQUENCE_DEPTH     4   /**< FIFO depth of sequencer 1 */
 
 /*------------------------------------------------------------------------------
- *  FUNCTIONS DEFINITIONS
+ *  LOCAL DATA
+ *----------------------------------------------------------------------------*/
+
+/** ADC channel sampled by each sequencer step */
+static const uint32_t aui32PotsAdcChannels[4] = {
+    ADC_CTL_CH0, ADC_CTL_CH1, ADC_CTL_CH2, ADC_CTL_CH3
+};
+
+/** Port E pin carrying each ADC channel */
+static const uint8_t aui8PotsAdcPins[4] = {
+    GPIO_PIN_3, GPIO_PIN_2, GPIO_PIN_1, GPIO_PIN_0
+};
+
+/** One ring per channel: the ADC ISR produces, the seat task of that channel consumes */
+static uint16_t aui16PotsRingStorage[POTS_CHANNEL_COUNT][POTS_RING_CAPACITY];
+static SPSC_RingType asPotsRings[POTS_CHANNEL_COUNT];
+
+/** Samples dropped because a channel ring was full */
+static volatile uint32_t ui32PotsOverruns = 0;
+
+/** Timebase (low 32 bits) of the last conversion, a single word so readers never see it torn */
+static volatile uint32_t ui32PotsLastSampleTime = 0;
+
+/** Consumer side results, only touched by the consumer of each channel */
+static uint32_t aui32PotsLatest[POTS_CHANNEL_COUNT];
+static uint32_t aui32PotsAverage[POTS_CHANNEL_COUNT];
+static uint32_t aui32PotsFiltered[POTS_CHANNEL_COUNT];
+static FILTER_StateType asPotsFilters[POTS_CHANNEL_COUNT];
+
+/*------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
  *----------------------------------------------------------------------------*/
 
 /**
- * @brief Initializes POT1 hardware (ADC channel 0 on PE3)
+ * @brief Empties a channel ring and refreshes its latest/average/filtered values
  */
-void POT1_init(void)
+static void POTS_drain(uint32_t ui32Channel)
 {
-    /* Enable required peripherals */
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
-
-    /* Configure PE3 as ADC input */
-    GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_3);
+    uint16_t ui16Sample;
+    uint32_t ui32Sum = 0;
+    uint32_t ui32Count = 0;
+
+    uint16_t ui16Filtered = 0;
+
+    while(SPSC_pop(&asPotsRings[ui32Channel], &ui16Sample))
+    {
+        ui32Sum += ui16Sample;
+        ui32Count++;
+        ui16Filtered = FILTER_process(&asPotsFilters[ui32Channel], ui16Sample);
+    }
+
+    if(ui32Count != 0)
+    {
+        aui32PotsLatest[ui32Channel] = ui16Sample;
+        aui32PotsAverage[ui32Channel] = ui32Sum / ui32Count;
+        aui32PotsFiltered[ui32Channel] = ui16Filtered;
+    }
 }
 
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
 /**
- * @brief Gets current value from POT1
- * @return Raw ADC value (0-4095)
+ * @brief Configures sample sequencer 1 once with one step per seat sensor
  */
-uint32_t POT1_getValue(void)
+void POTS_init(void)
 {
-    uint32_t pui32ADC0Value[1];
+    uint32_t ui32Step;
+    uint8_t ui8Pins = 0;
 
-    /* Configure ADC sequence */
-    ADCSequenceConfigure(ADC0_BASE, ADC_SEQUENCE_NUM, ADC_TRIGGER_PROCESSOR, 0);
-    ADCSequenceStepConfigure(ADC0_BASE, ADC_SEQUENCE_NUM, 0,
-                           ADC_CTL_CH0 | ADC_CTL_IE | ADC_CTL_END);
+    /* Enable required peripherals */
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
 
-    /* Enable and clear interrupt */
+    /* Configure every sensor pin as ADC input */
+    for(ui32Step = 0; ui32Step < POTS_CHANNEL_COUNT; ui32Step++)
+    {
+        ui8Pins |= aui8PotsAdcPins[ui32Step];
+    }
+    GPIOPinTypeADC(GPIO_PORTE_BASE, ui8Pins);
+
+    for(ui32Step = 0; ui32Step < POTS_CHANNEL_COUNT; ui32Step++)
+    {
+        SPSC_init(&asPotsRings[ui32Step], aui16PotsRingStorage[ui32Step],
+                  sizeof(uint16_t), POTS_RING_CAPACITY);
+        FILTER_init(&asPotsFilters[ui32Step]);
+    }
+
+    /* Let the ADC average POTS_HW_OVERSAMPLE conversions into every sample */
+    ADCHardwareOversampleConfigure(ADC0_BASE, POTS_HW_OVERSAMPLE);
+
+    /* Configure ADC sequence: one step per channel, interrupt flag on the last one */
+    ADCSequenceDisable(ADC0_BASE, ADC_SEQUENCE_NUM);
+    ADCSequenceConfigure(ADC0_BASE, ADC_SEQUENCE_NUM, ADC_TRIGGER_TIMER, 0);
+    for(ui32Step = 0; ui32Step < POTS_CHANNEL_COUNT; ui32Step++)
+    {
+        uint32_t ui32Config = aui32PotsAdcChannels[ui32Step];
+
+        if(ui32Step == (POTS_CHANNEL_COUNT - 1))
+        {
+            ui32Config |= ADC_CTL_IE | ADC_CTL_END;
+        }
+        ADCSequenceStepConfigure(ADC0_BASE, ADC_SEQUENCE_NUM, ui32Step, ui32Config);
+    }
+
+    /* Enable sequence and its interrupt, it does not call any RTOS API */
     ADCSequenceEnable(ADC0_BASE, ADC_SEQUENCE_NUM);
     ADCIntClear(ADC0_BASE, ADC_SEQUENCE_NUM);
+    ADCIntEnable(ADC0_BASE, ADC_SEQUENCE_NUM);
+    IntEnable(INT_ADC0SS1);
 
-    /* Trigger conversion and wait for completion */
-    ADCProcessorTrigger(ADC0_BASE, ADC_SEQUENCE_NUM);
-    while(!ADCIntStatus(ADC0_BASE, ADC_SEQUENCE_NUM, ADC_SAMPLE_WAIT));
-
-    /* Clear interrupt and read value */
-    ADCIntClear(ADC0_BASE, ADC_SEQUENCE_NUM);
-    ADCSequenceDataGet(ADC0_BASE, ADC_SEQUENCE_NUM, pui32ADC0Value);
-
-    return pui32ADC0Value[0];
+    /* Start the sampling clock */
+    GPTM_Timer0AdcTriggerInit(POTS_SAMPLE_PERIOD_MS);
 }
 
 /**
- * @brief Initializes POT2 hardware (ADC channel 1 on PE2)
+ * @brief Most recent raw value of a channel, never blocks
  */
-void POT2_init(void)
+uint32_t POTS_getLatestValue(uint32_t ui32Channel)
 {
-    /* Enable required peripherals */
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE);
+    POTS_drain(ui32Channel);
+    return aui32PotsLatest[ui32Channel];
+}
 
-    /* Configure PE2 as ADC input */
-    GPIOPinTypeADC(GPIO_PORTE_BASE, GPIO_PIN_2);
+/**
+ * @brief Mean of the raw values converted since the previous read, never blocks
+ */
+uint32_t POTS_getAverageValue(uint32_t ui32Channel)
+{
+    POTS_drain(ui32Channel);
+    return aui32PotsAverage[ui32Channel];
 }
 
 /**
- * @brief Gets current value from POT2
- * @return Raw ADC value (0-4095)
+ * @brief Filtered value of a channel, never blocks
  */
-uint32_t POT2_getValue(void)
+uint32_t POTS_getFilteredValue(uint32_t ui32Channel)
 {
-    uint32_t pui32ADC0Value[1];
+    POTS_drain(ui32Channel);
+    return aui32PotsFiltered[ui32Channel];
+}
 
-    /* Configure ADC sequence */
-    ADCSequenceConfigure(ADC0_BASE, ADC_SEQUENCE_NUM, ADC_TRIGGER_PROCESSOR, 0);
-    ADCSequenceStepConfigure(ADC0_BASE, ADC_SEQUENCE_NUM, 0,
-                           ADC_CTL_CH1 | ADC_CTL_IE | ADC_CTL_END);
+/**
+ * @brief Time of the most recent conversion
+ */
+uint32_t POTS_getLastSampleTime(void)
+{
+    return ui32PotsLastSampleTime;
+}
 
-    /* Enable and clear interrupt */
-    ADCSequenceEnable(ADC0_BASE, ADC_SEQUENCE_NUM);
-    ADCIntClear(ADC0_BASE, ADC_SEQUENCE_NUM);
+/**
+ * @brief Samples dropped because a channel ring was full
+ */
+uint32_t POTS_getOverruns(void)
+{
+    return ui32PotsOverruns;
+}
 
-    /* Trigger conversion and wait for completion */
-    ADCProcessorTrigger(ADC0_BASE, ADC_SEQUENCE_NUM);
-    while(!ADCIntStatus(ADC0_BASE, ADC_SEQUENCE_NUM, ADC_SAMPLE_WAIT));
+/**
+ * @brief ADC0 sequencer 1 interrupt handler
+ *
+ * Producer of every channel ring: one sample per channel per timer period.
+ */
+void ADC0SS1_Handler(void)
+{
+    uint32_t aui32Samples[ADC_SEQUENCE_DEPTH];
+    uint32_t ui32Channel;
 
-    /* Clear interrupt and read value */
+    TRACE_ISR_ENTER(TRACE_ISR_ADC0SS1);
     ADCIntClear(ADC0_BASE, ADC_SEQUENCE_NUM);
-    ADCSequenceDataGet(ADC0_BASE, ADC_SEQUENCE_NUM, pui32ADC0Value);
-
-    return pui32ADC0Value[0];
+    ADCSequenceDataGet(ADC0_BASE, ADC_SEQUENCE_NUM, aui32Samples);
+
+    for(ui32Channel = 0; ui32Channel < POTS_CHANNEL_COUNT; ui32Channel++)
+    {
+        uint16_t ui16Sample = (uint16_t)aui32Samples[ui32Channel];
+
+        if(!SPSC_push(&asPotsRings[ui32Channel], &ui16Sample))
+        {
+            ui32PotsOverruns++;
+        }
+    }
+    ui32PotsLastSampleTime = (uint32_t)GPTM_WTimer0Read64();
+    TRACE_ISR_EXIT(TRACE_ISR_ADC0SS1);
 }
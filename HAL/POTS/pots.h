@@ -18,13 +18,41 @@
  *----------------------------------------------------------------------------*/
 
 /**
- * @defgroup Potentiometer_Max_Values Maximum ADC values for potentiometers
+ * @defgroup Potentiometer_Max_Values Maximum ADC value of a seat sensor
  * @{
  */
-#define POT1_MAX_VALUE   4096    /**< Maximum ADC value for POT1 (12-bit resolution) */
-#define POT2_MAX_VALUE   4096    /**< Maximum ADC value for POT2 (12-bit resolution) */
+#define POTS_MAX_VALUE   4096    /**< Full scale of every channel (12-bit resolution) */
 /** @} */
 
+/**
+ * @defgroup Potentiometer_Channels Seat sensor channels sampled together
+ * @{
+ */
+#define POTS_CHANNEL_COUNT   2       /**< Number of seat sensors converted per trigger (1-4), channel n is CHn */
+/** @} */
+
+/**
+ * @defgroup Potentiometer_Acquisition Timer-triggered acquisition settings
+ * @{
+ */
+#define POTS_SAMPLE_PERIOD_MS  10    /**< Timer0A period triggering one conversion of all channels */
+#define POTS_RING_CAPACITY     16    /**< Samples buffered per channel between two reads (power of 2) */
+#define POTS_HW_OVERSAMPLE     16    /**< ADCSAC hardware averaging per conversion: 0 (off), 2, 4 ... 64 */
+/** @} */
+
+/**
+ * @defgroup Potentiometer_Temperature Raw value to seat temperature scaling
+ * @{
+ */
+#define POTS_TEMP_MAX_C        45    /**< Temperature at full scale, the pot emulates a 0-45 C sensor */
+#define POTS_RAW_TO_CELSIUS(raw)  ((uint8_t)(((uint32_t)(raw) * POTS_TEMP_MAX_C) / POTS_MAX_VALUE))
+#define POTS_RAW_TO_CELSIUS_Q8(raw)  ((int32_t)((((uint32_t)(raw) * POTS_TEMP_MAX_C) << 8) / POTS_MAX_VALUE))  /**< 1/256 C */
+/** @} */
+
+#if (POTS_CHANNEL_COUNT < 1) || (POTS_CHANNEL_COUNT > 4)
+#error "POTS_CHANNEL_COUNT must be between 1 and 4 (sample sequencer 1 depth)"
+#endif
+
 /*------------------------------------------------------------------------------
  *  Function Declarations
  *----------------------------------------------------------------------------*/
@@ -35,26 +63,58 @@
  */
 
 /**
- * @brief Initializes hardware for POT1 (ADC Channel 0)
+ * @brief Configures sample sequencer 1 once with one step per seat sensor
+ *
+ * Steps 0..POTS_CHANNEL_COUNT-1 sample CH0..CH3 (PE3, PE2, PE1, PE0). The
+ * sequence is triggered by Timer0A every POTS_SAMPLE_PERIOD_MS and its
+ * interrupt pushes the results into one lock-free ring per channel.
  */
-void POT1_init(void);
+void POTS_init(void);
 
 /**
- * @brief Reads current value from POT1
+ * @brief Most recent raw value of a channel, never blocks
+ *
+ * Each channel has a single-consumer ring: the latest/average getters of a
+ * given channel must only be called from one task.
+ *
+ * @param ui32Channel Channel index (0 .. POTS_CHANNEL_COUNT-1)
  * @return Raw ADC value (0-4095)
  */
-uint32_t POT1_getValue(void);
+uint32_t POTS_getLatestValue(uint32_t ui32Channel);
 
 /**
- * @brief Initializes hardware for POT2 (ADC Channel 1)
+ * @brief Mean of the raw values converted since the previous read, never blocks
+ * @param ui32Channel Channel index (0 .. POTS_CHANNEL_COUNT-1)
+ * @return Raw ADC value (0-4095), the previous mean if nothing new arrived
  */
-void POT2_init(void);
+uint32_t POTS_getAverageValue(uint32_t ui32Channel);
 
 /**
- * @brief Reads current value from POT2
- * @return Raw ADC value (0-4095)
+ * @brief Raw values converted since the previous read, passed through the
+ *        median + IIR pipeline of pots_filter.h, never blocks
+ * @param ui32Channel Channel index (0 .. POTS_CHANNEL_COUNT-1)
+ * @return Filtered ADC value (0-4095)
+ */
+uint32_t POTS_getFilteredValue(uint32_t ui32Channel);
+
+/**
+ * @brief Time of the most recent conversion, for sensor to actuator latency
+ * @return Low 32 bits of the WTimer0 timebase (GPTM_TIMEBASE_HZ), wraps
+ */
+uint32_t POTS_getLastSampleTime(void);
+
+/**
+ * @brief Samples dropped because a channel ring was full, all channels together
+ *
+ * A rising count means a consumer reads its channel less often than every
+ * POTS_RING_CAPACITY sample periods.
+ */
+uint32_t POTS_getOverruns(void);
+
+/**
+ * @brief ADC0 sequencer 1 interrupt handler, must be placed in the vector table
  */
-uint32_t POT2_getValue(void);
+void ADC0SS1_Handler(void);
 
 /** @} */
 
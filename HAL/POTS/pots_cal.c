@@ -0,0 +1,53 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Potentiometer Driver
+ *  File        : pots_cal.c
+ *  Description : Fixed-point raw ADC code to temperature conversion with
+ *                per-channel calibration
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "HAL/POTS/pots_cal.h"
+#include "HAL/POTS/pots.h"
+
+/*------------------------------------------------------------------------------
+ *  LOCAL DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+#define CAL_RAW_MAX            ((uint32_t)POTS_MAX_VALUE - 1U)
+#define CAL_FRACTION_MASK      ((1U << CAL_CURVE_SHIFT) - 1U)
+
+#if ((POTS_MAX_VALUE >> CAL_CURVE_SHIFT) + 1) != CAL_CURVE_POINTS
+#error "pots_cal_curves.c does not match POTS_MAX_VALUE, run tools/gen_temp_lut.py"
+#endif
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Temperature of a raw ADC code through the channel's curve and trim
+ */
+int32_t CAL_toCelsiusQ8(const CAL_ChannelType *psChannel, uint32_t ui32Raw)
+{
+    const int16_t *pi16Segment;
+    int32_t i32Fraction;
+    int32_t i32CurveQ8;
+
+    if(ui32Raw > CAL_RAW_MAX)
+    {
+        ui32Raw = CAL_RAW_MAX;
+    }
+
+    /* The last code stays below the final entry, so index + 1 is always in the table */
+    pi16Segment = &psChannel->pi16CurveQ8[ui32Raw >> CAL_CURVE_SHIFT];
+    i32Fraction = (int32_t)(ui32Raw & CAL_FRACTION_MASK);
+
+    /* Arithmetic shift of a falling segment rounds towards -inf, below 1/256 C */
+    i32CurveQ8 = pi16Segment[0] + (((pi16Segment[1] - pi16Segment[0]) * i32Fraction) >> CAL_CURVE_SHIFT);
+
+    return ((i32CurveQ8 * psChannel->i32GainQ14 + (1 << (CAL_GAIN_FRAC_BITS - 1))) >> CAL_GAIN_FRAC_BITS)
+           + psChannel->i32OffsetQ8;
+}
@@ -0,0 +1,85 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Potentiometer Driver
+ *  File        : pots_cal.h
+ *  Description : Fixed-point raw ADC code to temperature conversion with
+ *                per-channel calibration
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef HAL_POTS_POTS_CAL_H_
+#define HAL_POTS_POTS_CAL_H_
+
+/*
+ * A channel converts through a sensor curve, a table of CAL_CURVE_POINTS
+ * temperatures generated by tools/gen_temp_lut.py (pots_cal_curves.c), then
+ * through its own linear trim:
+ *
+ *   T = curve(raw) * gain + offset
+ *
+ * The curve is interpolated linearly between the two entries around the raw
+ * code: one table step is 2^CAL_CURVE_SHIFT codes, so the index and the
+ * weight are a shift and a mask. A conversion is two loads, two multiplies
+ * and a few adds, no division and no floating point.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "HAL/POTS/pots_cal_curves.h"
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Calibration_Configuration Calibration settings
+ * @{
+ */
+#define CAL_GAIN_FRAC_BITS     14    /**< Trim gain is Q2.14, up to 2.0 with a Q8 125 C curve */
+#define CAL_TEMP_FRAC_BITS     8     /**< Temperatures are Q8 degrees C, as PI_TEMP_FRAC_BITS */
+/** @} */
+
+/**
+ * @brief Q2.14 trim gain from a literal, folded by the compiler
+ */
+#define CAL_GAIN_Q14(gain)     ((int32_t)((gain) * (1L << CAL_GAIN_FRAC_BITS) + 0.5))
+
+/**
+ * @brief Q8 trim offset in degrees C from a literal, rounded to the nearest 1/256 C
+ */
+#define CAL_OFFSET_Q8(tempC)   ((int32_t)((tempC) * (1L << CAL_TEMP_FRAC_BITS) + (((tempC) < 0) ? -0.5 : 0.5)))
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Calibration of one sensor channel
+ */
+typedef struct {
+    const int16_t *pi16CurveQ8;         /**< Sensor curve, CAL_CURVE_POINTS entries in Q8 C */
+    int32_t i32GainQ14;                 /**< Trim gain, CAL_GAIN_Q14(1.0) leaves the curve as is */
+    int32_t i32OffsetQ8;                /**< Trim offset added after the gain */
+} CAL_ChannelType;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Calibration_Functions Calibration Functions
+ * @{
+ */
+
+/**
+ * @brief Temperature of a raw ADC code through the channel's curve and trim
+ * @param psChannel Channel calibration
+ * @param ui32Raw   Raw or filtered ADC code, codes past 4095 read as 4095
+ * @return Temperature in 1/256 C
+ */
+int32_t CAL_toCelsiusQ8(const CAL_ChannelType *psChannel, uint32_t ui32Raw);
+
+/** @} */
+
+#endif /* HAL_POTS_POTS_CAL_H_ */
@@ -0,0 +1,38 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Potentiometer Driver
+ *  File        : pots_cal_curves.c
+ *  Description : Temperature curves of the seat sensor calibration
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/* Generated by tools/gen_temp_lut.py, do not edit */
+
+#include "HAL/POTS/pots_cal_curves.h"
+
+/* Potentiometer, 0 to 45 C, in 1/256 C */
+const int16_t ai16CalCurvePot[CAL_CURVE_POINTS] =
+{
+         0,    180,    360,    540,    720,    900,   1080,   1260,
+      1440,   1620,   1800,   1980,   2160,   2340,   2520,   2700,
+      2880,   3060,   3240,   3420,   3600,   3780,   3960,   4140,
+      4320,   4500,   4680,   4860,   5040,   5220,   5400,   5580,
+      5760,   5940,   6120,   6300,   6480,   6660,   6840,   7020,
+      7200,   7380,   7560,   7740,   7920,   8100,   8280,   8460,
+      8640,   8820,   9000,   9180,   9360,   9540,   9720,   9900,
+     10080,  10260,  10440,  10620,  10800,  10980,  11160,  11340,
+     11520
+};
+
+/* NTC 10000 ohm at 25 C, B 3950 K, 10000 ohm pull-up, -40 to 125 C, in 1/256 C */
+const int16_t ai16CalCurveNtc[CAL_CURVE_POINTS] =
+{
+     32000,  32000,  32000,  28861,  26010,  23875,  22171,  20754,
+     19541,  18479,  17533,  16679,  15899,  15181,  14513,  13889,
+     13302,  12746,  12218,  11713,  11230,  10765,  10317,   9882,
+      9461,   9051,   8651,   8259,   7876,   7499,   7128,   6762,
+      6400,   6041,   5686,   5332,   4979,   4627,   4275,   3921,
+      3566,   3209,   2848,   2483,   2113,   1736,   1352,    959,
+       555,    139,   -291,   -738,  -1206,  -1698,  -2219,  -2775,
+     -3375,  -4031,  -4759,  -5586,  -6554,  -7739,  -9311, -10240,
+    -10240
+};
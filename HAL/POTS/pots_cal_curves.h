@@ -0,0 +1,28 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Potentiometer Driver
+ *  File        : pots_cal_curves.h
+ *  Description : Temperature curves of the seat sensor calibration
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/* Generated by tools/gen_temp_lut.py, do not edit */
+
+#ifndef HAL_POTS_POTS_CAL_CURVES_H_
+#define HAL_POTS_POTS_CAL_CURVES_H_
+
+#include <stdint.h>
+
+#define CAL_CURVE_SHIFT        6       /**< Raw codes per table step, as a power of 2 */
+#define CAL_CURVE_POINTS       65      /**< Entries per table, the last one at full scale */
+#define CAL_CURVE_MIN_C        (-40)   /**< Tables are clamped to this range */
+#define CAL_CURVE_MAX_C        125
+
+/* Parameters of the NTC curve, for the host accuracy test */
+#define CAL_NTC_R25_OHM        10000
+#define CAL_NTC_BETA_K         3950
+#define CAL_NTC_PULLUP_OHM     10000
+
+extern const int16_t ai16CalCurvePot[CAL_CURVE_POINTS];     /**< 0 to POTS_TEMP_MAX_C, linear */
+extern const int16_t ai16CalCurveNtc[CAL_CURVE_POINTS];     /**< NTC to ground, pull-up to VREF */
+
+#endif /* HAL_POTS_POTS_CAL_CURVES_H_ */
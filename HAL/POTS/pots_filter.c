@@ -0,0 +1,123 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Potentiometer Driver
+ *  File        : pots_filter.c
+ *  Description : Integer-only median and IIR filter kernels for seat sensors
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "HAL/POTS/pots_filter.h"
+
+/*------------------------------------------------------------------------------
+ *  LOCAL DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/** Compare-exchange step of the sorting networks */
+#define FILTER_SORT2(a, b)  do { if((a) > (b)) { uint16_t t = (a); (a) = (b); (b) = t; } } while(0)
+
+/*------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Median of the first ui8Count entries (1..5) with fixed sorting networks
+ */
+static uint16_t FILTER_medianOf(const uint16_t *pui16Values, uint8_t ui8Count)
+{
+    uint16_t a = pui16Values[0];
+    uint16_t b, c, d, e;
+
+    switch(ui8Count)
+    {
+        case 1:
+            return a;
+        case 2:
+            return (uint16_t)((a + pui16Values[1] + 1) >> 1);
+        case 3:
+            b = pui16Values[1]; c = pui16Values[2];
+            FILTER_SORT2(a, b); FILTER_SORT2(b, c); FILTER_SORT2(a, b);
+            return b;
+        case 4:
+            b = pui16Values[1]; c = pui16Values[2]; d = pui16Values[3];
+            FILTER_SORT2(a, b); FILTER_SORT2(c, d); FILTER_SORT2(a, c);
+            FILTER_SORT2(b, d); FILTER_SORT2(b, c);
+            return (uint16_t)((b + c + 1) >> 1);
+        default:
+            /* 7 compare-exchanges are enough to place the median of 5 in c */
+            b = pui16Values[1]; c = pui16Values[2]; d = pui16Values[3]; e = pui16Values[4];
+            FILTER_SORT2(a, b); FILTER_SORT2(d, e); FILTER_SORT2(a, d);
+            FILTER_SORT2(b, e); FILTER_SORT2(c, d); FILTER_SORT2(b, c);
+            FILTER_SORT2(c, d);
+            return c;
+    }
+}
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Clears a channel filter state
+ */
+void FILTER_init(FILTER_StateType *psState)
+{
+    uint8_t ui8Index;
+
+    for(ui8Index = 0; ui8Index < FILTER_MEDIAN_SIZE; ui8Index++)
+    {
+        psState->aui16Window[ui8Index] = 0;
+    }
+    psState->ui8WindowIndex = 0;
+    psState->ui8WindowCount = 0;
+    psState->ui32IirStateQ8 = 0;
+    psState->ui8IirPrimed = 0;
+}
+
+/**
+ * @brief Adds a sample to the median window
+ */
+uint16_t FILTER_median(FILTER_StateType *psState, uint16_t ui16Sample)
+{
+    psState->aui16Window[psState->ui8WindowIndex] = ui16Sample;
+    psState->ui8WindowIndex = (uint8_t)((psState->ui8WindowIndex + 1) % FILTER_MEDIAN_SIZE);
+    if(psState->ui8WindowCount < FILTER_MEDIAN_SIZE)
+    {
+        psState->ui8WindowCount++;
+    }
+
+    return FILTER_medianOf(psState->aui16Window, psState->ui8WindowCount);
+}
+
+/**
+ * @brief First-order low pass y += (x - y) / 2^FILTER_IIR_SHIFT, in Q8
+ */
+uint16_t FILTER_iir(FILTER_StateType *psState, uint16_t ui16Sample)
+{
+    int32_t i32InputQ8 = (int32_t)ui16Sample << FILTER_IIR_FRAC_BITS;
+    int32_t i32StateQ8 = (int32_t)psState->ui32IirStateQ8;
+
+    if(!psState->ui8IirPrimed)
+    {
+        /* Start from the first sample instead of ramping up from zero */
+        i32StateQ8 = i32InputQ8;
+        psState->ui8IirPrimed = 1;
+    }
+    else
+    {
+        /* Arithmetic shift of a negative step rounds towards -inf, fine at Q8 */
+        i32StateQ8 += (i32InputQ8 - i32StateQ8) >> FILTER_IIR_SHIFT;
+    }
+
+    psState->ui32IirStateQ8 = (uint32_t)i32StateQ8;
+    return (uint16_t)((i32StateQ8 + (1 << (FILTER_IIR_FRAC_BITS - 1))) >> FILTER_IIR_FRAC_BITS);
+}
+
+/**
+ * @brief Full pipeline: median (spike rejection) then IIR (noise smoothing)
+ */
+uint16_t FILTER_process(FILTER_StateType *psState, uint16_t ui16Sample)
+{
+    return FILTER_iir(psState, FILTER_median(psState, ui16Sample));
+}
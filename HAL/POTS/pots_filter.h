@@ -0,0 +1,83 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Potentiometer Driver
+ *  File        : pots_filter.h
+ *  Description : Integer-only median and IIR filter kernels for seat sensors
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef HAL_POTS_POTS_FILTER_H_
+#define HAL_POTS_POTS_FILTER_H_
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Filter_Configuration Filter pipeline settings
+ * @{
+ */
+#ifndef FILTER_MEDIAN_SIZE
+#define FILTER_MEDIAN_SIZE     3     /**< Median window: 1 (bypass), 3 or 5 samples */
+#endif
+#define FILTER_IIR_SHIFT       3     /**< IIR weight of a new sample is 1/2^shift, 0 bypasses */
+#define FILTER_IIR_FRAC_BITS   8     /**< Fraction bits kept in the IIR state (Q8) */
+/** @} */
+
+#if (FILTER_MEDIAN_SIZE != 1) && (FILTER_MEDIAN_SIZE != 3) && (FILTER_MEDIAN_SIZE != 5)
+#error "FILTER_MEDIAN_SIZE must be 1, 3 or 5"
+#endif
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Per-channel filter state
+ */
+typedef struct {
+    uint16_t aui16Window[FILTER_MEDIAN_SIZE];   /**< Last raw samples, circular */
+    uint8_t ui8WindowIndex;                     /**< Next slot to overwrite */
+    uint8_t ui8WindowCount;                     /**< Valid samples in the window */
+    uint32_t ui32IirStateQ8;                    /**< IIR output in Q8 */
+    uint8_t ui8IirPrimed;                       /**< IIR state holds a valid output */
+} FILTER_StateType;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Filter_Functions Filter Kernels
+ * @{
+ */
+
+/**
+ * @brief Clears a channel filter state
+ */
+void FILTER_init(FILTER_StateType *psState);
+
+/**
+ * @brief Adds a sample to the median window
+ * @return Median of the window (of the samples seen so far while it fills up)
+ */
+uint16_t FILTER_median(FILTER_StateType *psState, uint16_t ui16Sample);
+
+/**
+ * @brief First-order low pass y += (x - y) / 2^FILTER_IIR_SHIFT, in Q8
+ * @return Filtered value rounded to the input scale
+ */
+uint16_t FILTER_iir(FILTER_StateType *psState, uint16_t ui16Sample);
+
+/**
+ * @brief Full pipeline: median (spike rejection) then IIR (noise smoothing)
+ */
+uint16_t FILTER_process(FILTER_StateType *psState, uint16_t ui16Sample);
+
+/** @} */
+
+#endif /* HAL_POTS_POTS_FILTER_H_ */
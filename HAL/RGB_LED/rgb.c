@@ -15,6 +15,7 @@
 #include "driverlib/debug.h"
 #include "driverlib/gpio.h"
 #include "driverlib/sysctl.h"
+#include "gpio.h"
 
 /*------------------------------------------------------------------------------
  *  Functions Definitions
@@ -44,7 +45,7 @@ void RGB_init(void)
  */
 void RGB_RedLedOn(void)
 {
-    GPIOPinWrite(RED_PORT_BASE, RED_PIN, RED_PIN);
+    GPIO_WritePattern(GPIO_OUTPUT_PORTB, RED_PIN, RED_PIN);
 }
 
 /**
@@ -52,7 +53,7 @@ void RGB_RedLedOn(void)
  */
 void RGB_GreenLedOn(void)
 {
-    GPIOPinWrite(GREEN_PORT_BASE, GREEN_PIN, GREEN_PIN);
+    GPIO_WritePattern(GPIO_OUTPUT_PORTB, GREEN_PIN, GREEN_PIN);
 }
 
 /**
@@ -60,7 +61,7 @@ void RGB_GreenLedOn(void)
  */
 void RGB_BlueLedOn(void)
 {
-    GPIOPinWrite(BLUE_PORT_BASE, BLUE_PIN, BLUE_PIN);
+    GPIO_WritePattern(GPIO_OUTPUT_PORTB, BLUE_PIN, BLUE_PIN);
 }
 
 /**
@@ -68,7 +69,7 @@ void RGB_BlueLedOn(void)
  */
 void RGB_RedLedOff(void)
 {
-    GPIOPinWrite(RED_PORT_BASE, RED_PIN, 0x00);
+    GPIO_WritePattern(GPIO_OUTPUT_PORTB, RED_PIN, 0x00);
 }
 
 /**
@@ -76,7 +77,7 @@ void RGB_RedLedOff(void)
  */
 void RGB_GreenLedOff(void)
 {
-    GPIOPinWrite(GREEN_PORT_BASE, GREEN_PIN, 0x00);
+    GPIO_WritePattern(GPIO_OUTPUT_PORTB, GREEN_PIN, 0x00);
 }
 
 /**
@@ -84,5 +85,16 @@ void RGB_GreenLedOff(void)
  */
 void RGB_BlueLedOff(void)
 {
-    GPIOPinWrite(BLUE_PORT_BASE, BLUE_PIN, 0x00);
+    GPIO_WritePattern(GPIO_OUTPUT_PORTB, BLUE_PIN, 0x00);
+}
+
+/**
+ * @brief Sets all three LEDs at once
+ *
+ * One store to the masked PORTB data alias, so the colour never shows an
+ * intermediate mix and other PORTB pins are left alone.
+ */
+void RGB_setColor(RGB_ColorType eColor)
+{
+    GPIO_WritePattern(GPIO_OUTPUT_PORTB, RGB_PINS, (uint8)eColor);
 }
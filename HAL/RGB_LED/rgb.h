@@ -35,10 +35,32 @@
 #define RED_PIN                 GPIO_PIN_1         /**< Red LED pin number */
 #define GREEN_PIN               GPIO_PIN_2         /**< Green LED pin number */
 #define BLUE_PIN                GPIO_PIN_3         /**< Blue LED pin number */
+#define RGB_PINS                (RED_PIN | GREEN_PIN | BLUE_PIN)
 /**
   * @}
   */
 
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Colours as the pin pattern on PORTB
+ *
+ * Green shares PB2 with the seat 2 heater PWM; once the PWM owns the pin the
+ * green component has no effect.
+ */
+typedef enum {
+    RGB_COLOR_OFF     = 0,
+    RGB_COLOR_RED     = RED_PIN,
+    RGB_COLOR_GREEN   = GREEN_PIN,
+    RGB_COLOR_BLUE    = BLUE_PIN,
+    RGB_COLOR_YELLOW  = RED_PIN | GREEN_PIN,
+    RGB_COLOR_MAGENTA = RED_PIN | BLUE_PIN,
+    RGB_COLOR_CYAN    = GREEN_PIN | BLUE_PIN,
+    RGB_COLOR_WHITE   = RGB_PINS
+} RGB_ColorType;
+
 /*------------------------------------------------------------------------------
  *  Function Declarations
  *----------------------------------------------------------------------------*/
@@ -82,6 +104,11 @@ void RGB_GreenLedOff(void);
  */
 void RGB_BlueLedOff(void);
 
+/**
+ * @brief Sets all three LEDs at once
+ */
+void RGB_setColor(RGB_ColorType eColor);
+
 /**
   * @}
   */
@@ -23,6 +23,12 @@
 #include "driverlib/sysctl.h"
 #include "drivers/buttons.h"
 
+/* Indexed by GPIO_OutputPortType */
+static const uint32 GPIO_OutputPortBases[] = {
+    GPIO_PORTB_BASE_ADDRESS,
+    GPIO_PORTF_BASE_ADDRESS
+};
+
 void GPIO_BuiltinButtonsLedsInit(void)
 {
     /*
@@ -56,47 +62,57 @@ void GPIO_BuiltinButtonsLedsInit(void)
 
 void GPIO_RedLedOn(void)
 {
-    GPIO_PORTF_DATA_REG |= (1<<1);  /* Red LED ON */
+    GPIO_DATA_MASKED_REG(GPIO_PORTF_BASE_ADDRESS, GPIO_RED_LED_PIN_MASK) = GPIO_RED_LED_PIN_MASK;  /* Red LED ON */
 }
 
 void GPIO_BlueLedOn(void)
 {
-    GPIO_PORTF_DATA_REG |= (1<<2);  /* Blue LED ON */
+    GPIO_DATA_MASKED_REG(GPIO_PORTF_BASE_ADDRESS, GPIO_BLUE_LED_PIN_MASK) = GPIO_BLUE_LED_PIN_MASK;  /* Blue LED ON */
 }
 
 void GPIO_GreenLedOn(void)
 {
-    GPIO_PORTF_DATA_REG |= (1<<3);  /* Green LED ON */
+    GPIO_DATA_MASKED_REG(GPIO_PORTF_BASE_ADDRESS, GPIO_GREEN_LED_PIN_MASK) = GPIO_GREEN_LED_PIN_MASK;  /* Green LED ON */
 }
 
 void GPIO_RedLedOff(void)
 {
-    GPIO_PORTF_DATA_REG &= ~(1<<1);  /* Red LED OFF */
+    GPIO_DATA_MASKED_REG(GPIO_PORTF_BASE_ADDRESS, GPIO_RED_LED_PIN_MASK) = 0;  /* Red LED OFF */
 }
 
 void GPIO_BlueLedOff(void)
 {
-    GPIO_PORTF_DATA_REG &= ~(1<<2);  /* Blue LED OFF */
+    GPIO_DATA_MASKED_REG(GPIO_PORTF_BASE_ADDRESS, GPIO_BLUE_LED_PIN_MASK) = 0;  /* Blue LED OFF */
 }
 
 void GPIO_GreenLedOff(void)
 {
-    GPIO_PORTF_DATA_REG &= ~(1<<3);  /* Green LED OFF */
+    GPIO_DATA_MASKED_REG(GPIO_PORTF_BASE_ADDRESS, GPIO_GREEN_LED_PIN_MASK) = 0;  /* Green LED OFF */
 }
 
+/*
+ * A toggle has to read the pin. The bit-band load and store both address the LED
+ * bit alone, and the store is one bus write, so a write to another PORTF pin
+ * (the seat indicator, the RGB LED) that lands in between is never undone.
+ */
 void GPIO_RedLedToggle(void)
 {
-    GPIO_PORTF_DATA_REG ^= (1<<1);  /* Red LED is toggled */
+    GPIO_PORTF_DATA_BIT_REG(GPIO_RED_LED_PIN_NUM) = !GPIO_PORTF_DATA_BIT_REG(GPIO_RED_LED_PIN_NUM);  /* Red LED is toggled */
 }
 
 void GPIO_BlueLedToggle(void)
 {
-    GPIO_PORTF_DATA_REG ^= (1<<2);  /* Blue LED is toggled */
+    GPIO_PORTF_DATA_BIT_REG(GPIO_BLUE_LED_PIN_NUM) = !GPIO_PORTF_DATA_BIT_REG(GPIO_BLUE_LED_PIN_NUM);  /* Blue LED is toggled */
 }
 
 void GPIO_GreenLedToggle(void)
 {
-    GPIO_PORTF_DATA_REG ^= (1<<3);  /* Green LED is toggled */
+    GPIO_PORTF_DATA_BIT_REG(GPIO_GREEN_LED_PIN_NUM) = !GPIO_PORTF_DATA_BIT_REG(GPIO_GREEN_LED_PIN_NUM);  /* Green LED is toggled */
+}
+
+void GPIO_WritePattern(GPIO_OutputPortType ePort, uint8 uPins, uint8 uPattern)
+{
+    GPIO_DATA_MASKED_REG(GPIO_OutputPortBases[ePort], uPins) = uPattern;
 }
 
 uint8 GPIO_SW1GetState(void)
@@ -137,3 +153,83 @@ void GPIO_SW2EdgeTriggeredInterruptInit(void)
     NVIC_PRI7_REG = (NVIC_PRI7_REG & GPIO_PORTF_PRIORITY_MASK) | (GPIO_PORTF_INTERRUPT_PRIORITY<<GPIO_PORTF_PRIORITY_BITS_POS);
     NVIC_EN0_REG         |= 0x40000000;   /* Enable NVIC Interrupt for GPIO PORTF by set bit number 30 in EN0 Register */
 }
+
+void GPIO_EXTSWEdgeTriggeredInterruptInit(void)
+{
+    GPIO_PORTB_IS_REG    &= ~(1<<0);      /* PB0 detect edges */
+    GPIO_PORTB_IBE_REG   &= ~(1<<0);      /* PB0 will detect a certain edge */
+    GPIO_PORTB_IEV_REG   &= ~(1<<0);      /* PB0 will detect a falling edge */
+    GPIO_PORTB_ICR_REG   |= (1<<0);       /* Clear Trigger flag for PB0 (Interrupt Flag) */
+    GPIO_PORTB_IM_REG    |= (1<<0);       /* Enable Interrupt on PB0 pin */
+    /* Set GPIO PORTB priority as 5 by set Bit number 13, 14 and 15 with value 5 */
+    NVIC_PRI0_REG = (NVIC_PRI0_REG & GPIO_PORTB_PRIORITY_MASK) | (GPIO_PORTB_INTERRUPT_PRIORITY<<GPIO_PORTB_PRIORITY_BITS_POS);
+    NVIC_EN0_REG         |= 0x00000002;   /* Enable NVIC Interrupt for GPIO PORTB by set bit number 1 in EN0 Register */
+}
+
+uint32 GPIO_PortFGetInterruptStatus(void)
+{
+    return GPIO_PORTF_MIS_REG;
+}
+
+void GPIO_PortFInterruptDisable(uint32 uPins)
+{
+    uint8 uBit;
+
+    /* One bit-band store per pin: an interrupt changing IM meanwhile cannot be undone */
+    for(uBit = 0; uBit < 8; uBit++)
+    {
+        if(uPins & (1<<uBit))
+        {
+            GPIO_PORTF_IM_BIT_REG(uBit) = 0;   /* Mask the pin */
+        }
+    }
+    GPIO_PORTF_ICR_REG = uPins;           /* Clear their trigger flags */
+}
+
+void GPIO_PortFInterruptEnable(uint32 uPins)
+{
+    uint8 uBit;
+
+    GPIO_PORTF_ICR_REG = uPins;           /* Drop edges seen while masked */
+    for(uBit = 0; uBit < 8; uBit++)
+    {
+        if(uPins & (1<<uBit))
+        {
+            GPIO_PORTF_IM_BIT_REG(uBit) = 1;   /* Unmask the pin */
+        }
+    }
+}
+
+uint32 GPIO_PortBGetInterruptStatus(void)
+{
+    return GPIO_PORTB_MIS_REG;
+}
+
+void GPIO_PortBInterruptDisable(uint32 uPins)
+{
+    uint8 uBit;
+
+    /* One bit-band store per pin: an interrupt changing IM meanwhile cannot be undone */
+    for(uBit = 0; uBit < 8; uBit++)
+    {
+        if(uPins & (1<<uBit))
+        {
+            GPIO_PORTB_IM_BIT_REG(uBit) = 0;   /* Mask the pin */
+        }
+    }
+    GPIO_PORTB_ICR_REG = uPins;           /* Clear their trigger flags */
+}
+
+void GPIO_PortBInterruptEnable(uint32 uPins)
+{
+    uint8 uBit;
+
+    GPIO_PORTB_ICR_REG = uPins;           /* Drop edges seen while masked */
+    for(uBit = 0; uBit < 8; uBit++)
+    {
+        if(uPins & (1<<uBit))
+        {
+            GPIO_PORTB_IM_BIT_REG(uBit) = 1;   /* Unmask the pin */
+        }
+    }
+}
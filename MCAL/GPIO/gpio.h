@@ -19,6 +19,23 @@
 #define GPIO_PORTF_PRIORITY_BITS_POS  21
 #define GPIO_PORTF_INTERRUPT_PRIORITY 5
 
+/* GPIO PORTB is interrupt number 1: priority bits 13, 14 and 15 in PRI0 */
+#define GPIO_PORTB_PRIORITY_MASK      0xFFFF1FFF
+#define GPIO_PORTB_PRIORITY_BITS_POS  13
+#define GPIO_PORTB_INTERRUPT_PRIORITY 5
+
+#define GPIO_RED_LED_PIN_MASK         (1<<1)
+#define GPIO_BLUE_LED_PIN_MASK        (1<<2)
+#define GPIO_GREEN_LED_PIN_MASK       (1<<3)
+
+#define GPIO_RED_LED_PIN_NUM          1
+#define GPIO_BLUE_LED_PIN_NUM         2
+#define GPIO_GREEN_LED_PIN_NUM        3
+
+#define GPIO_SW1_PIN_MASK             (1<<4)
+#define GPIO_SW2_PIN_MASK             (1<<0)
+#define GPIO_EXTSW_PIN_MASK           (1<<0)
+
 #define EXT_BUTTON_GPIO_PERIPH      SYSCTL_PERIPH_GPIOB
 #define EXT_BUTTON_GPIO_BASE        GPIO_PORTB_BASE
 #define EXT_BUTTON              GPIO_PIN_0
@@ -26,6 +43,13 @@
 #define PRESSED                ((uint8)0x00)
 #define RELEASED               ((uint8)0x01)
 
+/* Output ports reachable through GPIO_WritePattern */
+typedef enum
+{
+    GPIO_OUTPUT_PORTB,
+    GPIO_OUTPUT_PORTF
+} GPIO_OutputPortType;
+
 
 void GPIO_BuiltinButtonsLedsInit(void);
 
@@ -41,11 +65,27 @@ void GPIO_RedLedToggle(void);
 void GPIO_BlueLedToggle(void);
 void GPIO_GreenLedToggle(void);
 
+/*
+ * Drives every pin set in uPins to its level in uPattern with one store to the
+ * masked DATA alias; pins outside uPins are untouched, so no lock is needed
+ * against tasks or interrupts writing other pins of the port.
+ */
+void GPIO_WritePattern(GPIO_OutputPortType ePort, uint8 uPins, uint8 uPattern);
+
 uint8 GPIO_SW1GetState(void);
 uint8 GPIO_SW2GetState(void);
 uint8 GPIO_EXTSWGetState(void);
 
 void GPIO_SW1EdgeTriggeredInterruptInit(void);
 void GPIO_SW2EdgeTriggeredInterruptInit(void);
+void GPIO_EXTSWEdgeTriggeredInterruptInit(void);
+
+/* Masked interrupt status and per-pin interrupt control, uPins uses the *_PIN_MASK values */
+uint32 GPIO_PortFGetInterruptStatus(void);
+void GPIO_PortFInterruptDisable(uint32 uPins);
+void GPIO_PortFInterruptEnable(uint32 uPins);
+uint32 GPIO_PortBGetInterruptStatus(void);
+void GPIO_PortBInterruptDisable(uint32 uPins);
+void GPIO_PortBInterruptEnable(uint32 uPins);
 
 #endif /* GPIO_H_ */
@@ -14,17 +14,120 @@
 
 void GPTM_WTimer0Init(void)
 {
-    /* Configure one shot down 32bit timer with tick time = 0.1msec */
+    /* Configure periodic up 64bit timer clocked at the system clock, it never stops and
+     * wraps only after 2^64 ticks (tens of thousands of years at 16 MHz) */
     SYSCTL_RCGCWTIMER_REG |= (1<<0);  /* Enable clock WTimer0 in run mode */
+    while(!(SYSCTL_PRWTIMER_REG & (1<<0)));  /* Wait until WTimer0 clock is activated and it is ready for access */
     WTIMER0_CTL_REG = 0;              /* Disable WTimer0 output */
-    WTIMER0_CFG_REG = 0x04;           /* Select 32-bit configuration option */
-    WTIMER0_TAMR_REG = 0x01;          /* Select one-shot down counter mode of WTimer0A */
-    WTIMER0_TAPR_REG = 1600 -1;       /* Set the prescaler for WTimer0A */
-    WTIMER0_CTL_REG |= (0x01);        /* Enable WTimer0A module */
+    WTIMER0_CFG_REG = GPTM_CFG_32BIT; /* Select 64-bit (concatenated) configuration option */
+    WTIMER0_TAMR_REG = GPTM_TAMR_PERIODIC | GPTM_TAMR_TACDIR_UP; /* Select periodic up counter mode of WTimer0A */
+    WTIMER0_TAILR_REG = 0xFFFFFFFF;   /* Lower half of the 64-bit interval */
+    WTIMER0_TBILR_REG = 0xFFFFFFFF;   /* Upper half of the 64-bit interval */
+    WTIMER0_CTL_REG |= (0x01);        /* Enable WTimer0A module (drives the whole 64-bit counter) */
+}
+
+uint64 GPTM_WTimer0Read64(void)
+{
+    uint32 uHigh;
+    uint32 uLow;
+
+    /* The halves are separate registers: re-read until no carry happened in between */
+    do
+    {
+        uHigh = WTIMER0_TBR_REG;
+        uLow  = WTIMER0_TAR_REG;
+    } while(uHigh != WTIMER0_TBR_REG);
+
+    return (((uint64)uHigh << 32) | uLow) >> GPTM_TIMEBASE_SHIFT;
 }
 
 uint32 GPTM_WTimer0Read(void)
 {
-    return (uint32) (0xFFFFFFFFUL - WTIMER0_TAR_REG);
+    /* Legacy 0.1 ms view of the timebase */
+    return (uint32)(GPTM_WTimer0Read64() / GPTM_TIMEBASE_TICKS_PER_100US);
+}
+
+uint64 GPTM_TicksToUs(uint64 uTicks)
+{
+    /* Whole seconds first: uTicks * 1000000 alone overflows 64 bits after about 13 days at 16 MHz */
+    return ((uTicks / GPTM_TIMEBASE_HZ) * 1000000ULL)
+         + (((uTicks % GPTM_TIMEBASE_HZ) * 1000000ULL) / GPTM_TIMEBASE_HZ);
+}
+
+void GPTM_Timer0AdcTriggerInit(uint32 uPeriodMs)
+{
+    SYSCTL_RCGCTIMER_REG |= (1<<0);               /* Enable clock Timer0 in run mode */
+    while(!(SYSCTL_PRTIMER_REG & (1<<0)));        /* Wait until Timer0 clock is activated and it is ready for access */
+    TIMER0_CTL_REG = 0;                           /* Disable Timer0 while configuring */
+    TIMER0_CFG_REG = GPTM_CFG_32BIT;              /* Select 32-bit configuration option */
+    TIMER0_TAMR_REG = GPTM_TAMR_PERIODIC;         /* Select periodic down counter mode of Timer0A */
+    TIMER0_TAILR_REG = (uPeriodMs * GPTM_TICKS_PER_MS) - 1;  /* Reload value for the sampling period */
+    TIMER0_IMR_REG = 0;                           /* No CPU interrupt, the ADC is the only consumer */
+    TIMER0_CTL_REG = GPTM_CTL_TAOTE_MASK | GPTM_CTL_TAEN_MASK; /* Enable ADC trigger output and Timer0A */
+}
+
+void GPTM_Timer1PeriodicInit(uint32 uPeriodMs)
+{
+    SYSCTL_RCGCTIMER_REG |= (1<<1);               /* Enable clock Timer1 in run mode */
+    while(!(SYSCTL_PRTIMER_REG & (1<<1)));        /* Wait until Timer1 clock is activated and it is ready for access */
+    TIMER1_CTL_REG = 0;                           /* Keep Timer1 disabled until GPTM_Timer1Start */
+    TIMER1_CFG_REG = GPTM_CFG_32BIT;              /* Select 32-bit configuration option */
+    TIMER1_TAMR_REG = GPTM_TAMR_PERIODIC;         /* Select periodic down counter mode of Timer1A */
+    TIMER1_TAILR_REG = (uPeriodMs * GPTM_TICKS_PER_MS) - 1;  /* Reload value for the period */
+    TIMER1_ICR_REG = GPTM_ICR_TATOCINT_MASK;      /* Clear any stale time-out flag */
+    TIMER1_IMR_REG = GPTM_IMR_TATOIM_MASK;        /* Enable the time-out interrupt */
+    /* Set Timer1A priority as 5 by set Bit number 13, 14 and 15 with value 5 */
+    NVIC_PRI5_REG = (NVIC_PRI5_REG & GPTM_TIMER1A_PRIORITY_MASK) | (GPTM_TIMER1A_INTERRUPT_PRIORITY<<GPTM_TIMER1A_PRIORITY_BITS_POS);
+    NVIC_EN0_REG |= GPTM_TIMER1A_NVIC_EN0_MASK;   /* Enable NVIC Interrupt for Timer1A by set bit number 21 in EN0 Register */
 }
 
+void GPTM_Timer1Start(void)
+{
+    TIMER1_TAILR_REG = TIMER1_TAILR_REG;          /* Reload so the first period is a full one */
+    TIMER1_CTL_REG |= GPTM_CTL_TAEN_MASK;
+}
+
+void GPTM_Timer1Stop(void)
+{
+    TIMER1_CTL_REG &= ~GPTM_CTL_TAEN_MASK;
+}
+
+uint8 GPTM_Timer1IsRunning(void)
+{
+    return (TIMER1_CTL_REG & GPTM_CTL_TAEN_MASK) ? TRUE : FALSE;
+}
+
+void GPTM_Timer1ClearInterrupt(void)
+{
+    TIMER1_ICR_REG = GPTM_ICR_TATOCINT_MASK;
+}
+
+void GPTM_WTimer1WakeupInit(void)
+{
+    SYSCTL_RCGCWTIMER_REG |= (1<<1);              /* Enable clock WTimer1 in run mode */
+    while(!(SYSCTL_PRWTIMER_REG & (1<<1)));       /* Wait until WTimer1 clock is activated and it is ready for access */
+    WTIMER1_CTL_REG = 0;                          /* Keep WTimer1 disabled until GPTM_WTimer1WakeupStart */
+    WTIMER1_CFG_REG = GPTM_CFG_WIDE_SPLIT;        /* Select the 32-bit Timer A of the wide timer */
+    WTIMER1_TAMR_REG = GPTM_TAMR_ONE_SHOT;        /* Select one-shot down counter mode of WTimer1A */
+    WTIMER1_ICR_REG = GPTM_ICR_TATOCINT_MASK;     /* Clear any stale time-out flag */
+    WTIMER1_IMR_REG = GPTM_IMR_TATOIM_MASK;       /* The time-out must reach the NVIC to wake the CPU */
+    /* Set WTimer1A priority as 5 by set Bit number 5, 6 and 7 with value 5 */
+    NVIC_PRI24_REG = (NVIC_PRI24_REG & GPTM_WTIMER1A_PRIORITY_MASK) | (GPTM_WTIMER1A_INTERRUPT_PRIORITY<<GPTM_WTIMER1A_PRIORITY_BITS_POS);
+    NVIC_EN3_REG = GPTM_WTIMER1A_NVIC_EN3_MASK;   /* Enable NVIC Interrupt for WTimer1A by set bit number 0 in EN3 Register */
+}
+
+void GPTM_WTimer1WakeupStart(uint32 uCycles)
+{
+    WTIMER1_TAILR_REG = uCycles;                  /* Counts down from here, times out at 0 */
+    WTIMER1_CTL_REG |= GPTM_CTL_TAEN_MASK;
+}
+
+uint8 GPTM_WTimer1WakeupStop(void)
+{
+    uint8 bExpired = (WTIMER1_RIS_REG & GPTM_RIS_TATORIS_MASK) ? TRUE : FALSE;
+
+    WTIMER1_CTL_REG &= ~GPTM_CTL_TAEN_MASK;
+    WTIMER1_ICR_REG = GPTM_ICR_TATOCINT_MASK;     /* Drop the time-out at the source first, */
+    NVIC_UNPEND3_REG = GPTM_WTIMER1A_NVIC_EN3_MASK; /* then in the NVIC, so the handler never runs */
+    return bExpired;
+}
@@ -15,8 +15,64 @@
 
 #include "std_types.h"
 
+#define GPTM_SYSTEM_CLOCK_HZ         16000000UL   /* Timers are clocked from the 16 MHz system clock */
+#define GPTM_TICKS_PER_MS            (GPTM_SYSTEM_CLOCK_HZ / 1000UL)
+
+#define GPTM_TAMR_ONE_SHOT           0x01
+#define GPTM_TAMR_PERIODIC           0x02
+#define GPTM_TAMR_TACDIR_UP          0x10
+#define GPTM_CFG_32BIT               0x00         /* 32-bit for 16/32-bit timers, 64-bit for wide timers */
+#define GPTM_CFG_WIDE_SPLIT          0x04         /* Wide timers: independent 32-bit Timer A and Timer B */
+#define GPTM_CTL_TAEN_MASK           0x00000001
+#define GPTM_CTL_TAOTE_MASK          0x00000020   /* Timer A output triggers the ADC */
+#define GPTM_IMR_TATOIM_MASK         0x00000001   /* Timer A time-out interrupt */
+#define GPTM_ICR_TATOCINT_MASK       0x00000001
+#define GPTM_RIS_TATORIS_MASK        0x00000001
+
+/* Timer1A is interrupt number 21: priority bits 13, 14 and 15 in PRI5, enable bit 21 in EN0 */
+#define GPTM_TIMER1A_PRIORITY_MASK      0xFFFF1FFF
+#define GPTM_TIMER1A_PRIORITY_BITS_POS  13
+#define GPTM_TIMER1A_INTERRUPT_PRIORITY 5
+#define GPTM_TIMER1A_NVIC_EN0_MASK      0x00200000
+
+/* WTimer1A is interrupt number 96: priority bits 5, 6 and 7 in PRI24, enable bit 0 in EN3 */
+#define GPTM_WTIMER1A_PRIORITY_MASK      0xFFFFFF1F
+#define GPTM_WTIMER1A_PRIORITY_BITS_POS  5
+#define GPTM_WTIMER1A_INTERRUPT_PRIORITY 5
+#define GPTM_WTIMER1A_NVIC_EN3_MASK      0x00000001
+
+/* 64-bit timebase resolution: 0 keeps the CPU clock resolution, every step halves it */
+#define GPTM_TIMEBASE_SHIFT          0
+#define GPTM_TIMEBASE_HZ             (GPTM_SYSTEM_CLOCK_HZ >> GPTM_TIMEBASE_SHIFT)
+#define GPTM_TIMEBASE_TICKS_PER_100US (GPTM_TIMEBASE_HZ / 10000UL)
+
+/* WTimer0: free-running monotonic 64-bit timebase at GPTM_TIMEBASE_HZ */
 void GPTM_WTimer0Init(void);
+uint64 GPTM_WTimer0Read64(void);
+uint64 GPTM_TicksToUs(uint64 uTicks);
+
+/* Timebase in 0.1 ms units truncated to 32 bits (wraps after ~4.9 days) */
 uint32 GPTM_WTimer0Read(void);
 
+/* Timer0A: 32-bit periodic timer whose time-out triggers an ADC sample sequence */
+void GPTM_Timer0AdcTriggerInit(uint32 uPeriodMs);
+
+/* Timer1A: 32-bit periodic timer with time-out interrupt (TIMER1A_Handler), stopped after init */
+void GPTM_Timer1PeriodicInit(uint32 uPeriodMs);
+void GPTM_Timer1Start(void);
+void GPTM_Timer1Stop(void);
+uint8 GPTM_Timer1IsRunning(void);
+void GPTM_Timer1ClearInterrupt(void);
+
+/*
+ * WTimer1A: 32-bit one-shot wakeup timer for tickless idle, counting system clock cycles
+ * (up to ~268 s). Its time-out only has to pend in the NVIC to end a WFI executed with
+ * interrupts masked; GPTM_WTimer1WakeupStop clears it again before interrupts are
+ * unmasked, so no handler ever runs.
+ */
+void GPTM_WTimer1WakeupInit(void);
+void GPTM_WTimer1WakeupStart(uint32 uCycles);
+uint8 GPTM_WTimer1WakeupStop(void);     /* TRUE if the timer had expired */
+
 
 #endif /* GPTM_H_ */
@@ -0,0 +1,107 @@
+ /******************************************************************************
+ *
+ * Module: PWM
+ *
+ * File Name: pwm.c
+ *
+ * Description: Source file for the TM4C123GH6PM hardware PWM outputs (PWM1 generator 3 and Timer3A PWM mode)
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+#include "pwm.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                         Private Functions Definitions                       *
+ *******************************************************************************/
+
+/*
+ * Both outputs are asserted at reload and deasserted on the match while counting
+ * down from PWM_PERIOD_TICKS - 1, so the match value for a duty is the part of the
+ * period the output spends low.
+ */
+static uint32 PWM_DutyToMatch(uint8 uDutyPercent)
+{
+    return ((PWM_PERIOD_TICKS - 1) * (uint32)(PWM_DUTY_MAX - uDutyPercent)) / PWM_DUTY_MAX;
+}
+
+static void PWM_InitPF3(void)
+{
+    SYSCTL_RCGCPWM_REG |= 0x02;                 /* Enable clock for PWM module 1 */
+    while(!(SYSCTL_PRPWM_REG & 0x02));          /* Wait until the PWM1 clock is activated and it is ready for access */
+
+    GPIO_PORTF_AFSEL_REG |= (1<<3);             /* Enable alternative function on PF3 */
+    GPIO_PORTF_PCTL_REG   = (GPIO_PORTF_PCTL_REG & PWM_PF3_PCTL_MASK) | PWM_PF3_PCTL_M1PWM7;
+    GPIO_PORTF_DEN_REG   |= (1<<3);             /* Enable Digital I/O on PF3 */
+
+    PWM1_3_CTL_REG  = PWM_GEN_CTL_GENBUPD_LOCAL;    /* Generator disabled, count-down mode, synchronized GENB updates */
+    PWM1_3_LOAD_REG = PWM_PERIOD_TICKS - 1;
+    PWM1_3_CMPB_REG = PWM_DutyToMatch(0);
+    PWM1_3_GENB_REG = PWM_GEN_ACTLOAD_LOW;          /* 0% duty */
+    PWM1_3_CTL_REG |= PWM_GEN_CTL_ENABLE_MASK;
+    PWM1_ENABLE_REG |= PWM_ENABLE_PWM7EN_MASK;      /* Pass M1PWM7 to the pin */
+}
+
+static void PWM_InitPB2(void)
+{
+    SYSCTL_RCGCTIMER_REG |= (1<<3);             /* Enable clock Timer3 in run mode */
+    while(!(SYSCTL_PRTIMER_REG & (1<<3)));      /* Wait until Timer3 clock is activated and it is ready for access */
+
+    GPIO_PORTB_AFSEL_REG |= (1<<2);             /* Enable alternative function on PB2 */
+    GPIO_PORTB_PCTL_REG   = (GPIO_PORTB_PCTL_REG & PWM_PB2_PCTL_MASK) | PWM_PB2_PCTL_T3CCP0;
+    GPIO_PORTB_DEN_REG   |= (1<<2);             /* Enable Digital I/O on PB2 */
+
+    TIMER3_CTL_REG      = 0;                        /* Disable Timer3A during configuration */
+    TIMER3_CFG_REG      = PWM_TIMER_CFG_16BIT;
+    TIMER3_TAMR_REG     = PWM_TIMER_TAMR_PWM;
+    TIMER3_TAILR_REG    = PWM_PERIOD_TICKS - 1;
+    TIMER3_TAMATCHR_REG = PWM_DutyToMatch(0);       /* Match at reload keeps the output low */
+    TIMER3_CTL_REG      = PWM_TIMER_CTL_TAEN_MASK;
+}
+
+/*******************************************************************************
+ *                         Public Functions Definitions                        *
+ *******************************************************************************/
+
+void PWM_Init(void)
+{
+    PWM_InitPF3();
+    PWM_InitPB2();
+}
+
+void PWM_SetDuty(PWM_ChannelType eChannel, uint8 uDutyPercent)
+{
+    if(uDutyPercent > PWM_DUTY_MAX)
+    {
+        uDutyPercent = PWM_DUTY_MAX;
+    }
+
+    switch(eChannel)
+    {
+    case PWM_CHANNEL_PF3:
+        /* The comparator cannot express 0% or 100%, so these are held by the reload action alone */
+        if(uDutyPercent == 0)
+        {
+            PWM1_3_GENB_REG = PWM_GEN_ACTLOAD_LOW;
+        }
+        else if(uDutyPercent == PWM_DUTY_MAX)
+        {
+            PWM1_3_GENB_REG = PWM_GEN_ACTLOAD_HIGH;
+        }
+        else
+        {
+            PWM1_3_CMPB_REG = PWM_DutyToMatch(uDutyPercent);
+            PWM1_3_GENB_REG = PWM_GEN_ACTLOAD_HIGH | PWM_GEN_ACTCMPBD_LOW;
+        }
+        break;
+
+    case PWM_CHANNEL_PB2:
+        TIMER3_TAMATCHR_REG = PWM_DutyToMatch(uDutyPercent);
+        break;
+
+    default:
+        break;
+    }
+}
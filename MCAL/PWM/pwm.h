@@ -0,0 +1,72 @@
+ /******************************************************************************
+ *
+ * Module: PWM
+ *
+ * File Name: pwm.h
+ *
+ * Description: Header file for the TM4C123GH6PM hardware PWM outputs (PWM1 generator 3 and Timer3A PWM mode)
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+#ifndef PWM_H_
+#define PWM_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+#define PWM_CLOCK_HZ                 16000000U   /* PWM and GPTM clocked straight from the 16 MHz system clock */
+#define PWM_FREQUENCY_HZ             1000U
+#define PWM_PERIOD_TICKS             (PWM_CLOCK_HZ / PWM_FREQUENCY_HZ)   /* Must fit the 16-bit counters */
+#define PWM_DUTY_MAX                 100U
+
+#if (PWM_PERIOD_TICKS > 0xFFFFU)
+#error "PWM_PERIOD_TICKS does not fit the 16-bit PWM and Timer3A counters"
+#endif
+
+/* PWM generator (count-down mode) */
+#define PWM_GEN_CTL_ENABLE_MASK      0x00000001
+#define PWM_GEN_CTL_GENBUPD_LOCAL    0x00000200   /* GENB changes take effect when the counter reaches zero */
+#define PWM_GEN_ACTLOAD_HIGH         0x0000000C   /* Drive the output high when the counter is reloaded */
+#define PWM_GEN_ACTLOAD_LOW          0x00000008   /* Drive the output low when the counter is reloaded */
+#define PWM_GEN_ACTCMPBD_LOW         0x00000800   /* Drive the output low on a comparator B match while counting down */
+#define PWM_ENABLE_PWM7EN_MASK       0x00000080
+#define PWM_PF3_PCTL_MASK            0xFFFF0FFF
+#define PWM_PF3_PCTL_M1PWM7          0x00005000
+
+/* Timer3A PWM mode */
+#define PWM_TIMER_CFG_16BIT          0x00000004
+#define PWM_TIMER_TAMR_PWM           0x0000040A   /* Periodic, alternate mode (PWM), match update on time-out (TAMRSU) */
+#define PWM_TIMER_CTL_TAEN_MASK      0x00000001
+#define PWM_PB2_PCTL_MASK            0xFFFFF0FF
+#define PWM_PB2_PCTL_T3CCP0          0x00000700
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+typedef enum
+{
+    PWM_CHANNEL_PF3,     /* M1PWM7, PWM module 1 generator 3 output B */
+    PWM_CHANNEL_PB2,     /* T3CCP0, Timer3A in PWM mode */
+    PWM_CHANNEL_COUNT
+} PWM_ChannelType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/* Configure both outputs at PWM_FREQUENCY_HZ with 0% duty, after GPIO_BuiltinButtonsLedsInit and RGB_init */
+extern void PWM_Init(void);
+
+/*
+ * Set the duty cycle of a channel in percent (values above PWM_DUTY_MAX are clamped).
+ * The new value is latched at the end of the running period, the output is then held
+ * by the hardware with no CPU involvement.
+ */
+extern void PWM_SetDuty(PWM_ChannelType eChannel, uint8 uDutyPercent);
+
+#endif /* PWM_H_ */
@@ -12,6 +12,56 @@
 
 #include "uart0.h"
 #include "tm4c123gh6pm_registers.h"
+#include "udma.h"
+#include "SERVICES/TRACE/trace.h"
+#include "SERVICES/COMMON/memory_barrier.h"
+
+/*******************************************************************************
+ *                              Private Variables                              *
+ *******************************************************************************/
+
+/* Transmit ring buffer: written by the task side at the head, drained by the ISR from the tail */
+static uint8 UART0_TxBuffer[UART0_TX_BUFFER_SIZE];
+static volatile uint32 UART0_TxHead = 0;
+static volatile uint32 UART0_TxTail = 0;
+static volatile uint32 UART0_TxDroppedBytes = 0;
+
+/* Receive ring buffer: filled by the ISR at the head, read by one task from the tail */
+static uint8 UART0_RxBuffer[UART0_RX_BUFFER_SIZE];
+static volatile uint32 UART0_RxHead = 0;
+static volatile uint32 UART0_RxTail = 0;
+static volatile uint32 UART0_RxDroppedBytes = 0;
+static volatile UART0_RxCallbackType UART0_RxCallback = NULL_PTR;
+
+/* Bulk transmit through the uDMA: a PENDING frame starts once the ring buffer has drained */
+typedef enum
+{
+    UART0_DMA_IDLE,
+    UART0_DMA_PENDING,
+    UART0_DMA_ACTIVE
+} UART0_DmaStateType;
+
+static volatile UART0_DmaStateType UART0_DmaState = UART0_DMA_IDLE;
+static const uint8 *UART0_DmaData = NULL_PTR;
+static uint32 UART0_DmaLength = 0;
+static UART0_TxCompleteCallbackType UART0_DmaCallback = NULL_PTR;
+
+/* Supported rates, the build fails if one of them misses the divisor error budget */
+#define UART0_CHECK_BAUD(baud, hse) \
+    typedef char UART0_BaudCheck_##baud[(UART0_BAUD_IN_RANGE(baud, hse) && \
+                                         (UART0_BAUD_ERROR_PERMILLE(baud, hse) <= UART0_BAUD_MAX_ERROR_PERMILLE)) ? 1 : -1];
+
+UART0_CHECK_BAUD(9600, 0)
+UART0_CHECK_BAUD(19200, 0)
+UART0_CHECK_BAUD(38400, 0)
+UART0_CHECK_BAUD(57600, 0)
+UART0_CHECK_BAUD(115200, 0)
+UART0_CHECK_BAUD(230400, 0)
+UART0_CHECK_BAUD(460800, 0)
+UART0_CHECK_BAUD(921600, 0)
+UART0_CHECK_BAUD(1000000, 0)
+UART0_CHECK_BAUD(1500000, 1)
+UART0_CHECK_BAUD(2000000, 1)
 
 /*******************************************************************************
  *                         Private Functions Definitions                       *
@@ -31,12 +81,124 @@ static void GPIO_SetupUART0Pins(void)
     GPIO_PORTA_DEN_REG   |= 0x03;         /* Enable Digital I/O on PA0 & PA1 */
 }
 
+/* Move bytes from the ring buffer into the hardware FIFO until one of them is full/empty */
+static void UART0_FillTxFifo(void)
+{
+    while((UART0_TxTail != UART0_TxHead) && !(UART0_FR_REG & UART_FR_TXFF_MASK))
+    {
+        UART0_DR_REG = UART0_TxBuffer[UART0_TxTail];
+        UART0_TxTail = (UART0_TxTail + 1) & (UART0_TX_BUFFER_SIZE - 1);
+    }
+}
+
+static boolean UART0_EnqueueByte(uint8 data)
+{
+    uint32 uNextHead = (UART0_TxHead + 1) & (UART0_TX_BUFFER_SIZE - 1);
+
+    if(uNextHead == UART0_TxTail)
+    {
+        UART0_TxDroppedBytes++; /* Buffer full: drop the newest byte */
+        return FALSE;
+    }
+
+    UART0_TxBuffer[UART0_TxHead] = data;
+    UART0_TxHead = uNextHead;
+    return TRUE;
+}
+
+/* Move bytes from the hardware FIFO into the receive ring until the FIFO is empty */
+static void UART0_DrainRxFifo(void)
+{
+    boolean bReceived = FALSE;
+
+    while(!(UART0_FR_REG & UART_FR_RXFE_MASK))
+    {
+        uint8 uData = (uint8)UART0_DR_REG;  /* Bits 11:8 hold the error flags, the byte is kept anyway */
+        uint32 uNextHead = (UART0_RxHead + 1) & (UART0_RX_BUFFER_SIZE - 1);
+
+        if(uNextHead == UART0_RxTail)
+        {
+            UART0_RxDroppedBytes++;         /* Ring full: drop the newest byte */
+        }
+        else
+        {
+            UART0_RxBuffer[UART0_RxHead] = uData;
+            UART0_RxHead = uNextHead;
+        }
+        bReceived = TRUE;
+    }
+
+    if(bReceived && (UART0_RxCallback != NULL_PTR))
+    {
+        UART0_RxCallback();
+    }
+}
+
+/* Task side critical section against UART0_Handler (single stores to the NVIC set/clear registers).
+ * Returns the previous enable state so that the sections nest: a task preempted inside one must not
+ * find the interrupt re-enabled by another task leaving its own section. */
+static uint32 UART0_LockIsr(void)
+{
+    uint32 uWasEnabled = NVIC_EN0_REG & UART0_NVIC_EN0_MASK;
+
+    NVIC_DIS0_REG = UART0_NVIC_EN0_MASK;
+    MEMORY_BARRIER_SYNC();                  /* The interrupt must not be taken past this point */
+    return uWasEnabled;
+}
+
+static void UART0_UnlockIsr(uint32 uWasEnabled)
+{
+    if(uWasEnabled)
+    {
+        NVIC_EN0_REG = UART0_NVIC_EN0_MASK;
+    }
+}
+
+static void UART0_StartDma(void)
+{
+    UART0_DmaState = UART0_DMA_ACTIVE;
+    UART0_IM_REG &= ~UART_IM_TXIM_MASK;     /* The FIFO belongs to the uDMA until the transfer is done */
+    UDMA_StartMemToPeriph(UDMA_CHANNEL_UART0TX, UART0_DmaData, &UART0_DR_REG, UART0_DmaLength);
+}
+
+/* Kick the transmitter: the TX interrupt only fires when the FIFO level crosses the
+ * trigger level, so the first bytes must be written to the FIFO from the task side.
+ * Must be called with the UART0 interrupt locked. */
+static void UART0_StartTx(void)
+{
+    if(UART0_DmaState != UART0_DMA_ACTIVE)
+    {
+        UART0_FillTxFifo();
+        UART0_IM_REG |= UART_IM_TXIM_MASK;  /* Re-enable the TX interrupt */
+    }
+}
+
 /*******************************************************************************
  *                         Public Functions Definitions                        *
  *******************************************************************************/
 
-void UART0_Init(void) /* UART0 configuration: 1 start, 8 bits data, No Parity, 1 stop bit and 9600BPS */
+boolean UART0_Init(const UART0_ConfigType *pConfig) /* UART0 configuration: 1 start, 8 bits data, No Parity, 1 stop bit */
 {
+    uint32 uDivisor64;
+
+    if((pConfig == NULL_PTR) || (pConfig->uBaudRate == 0))
+    {
+        return FALSE;
+    }
+
+    /* Divisor in 1/64 steps: the integer part must fit IBRD (1..65535) */
+    uDivisor64 = UART0_BAUD_DIVISOR64(pConfig->uBaudRate, pConfig->bHighSpeed);
+    if(!UART0_BAUD_IN_RANGE(pConfig->uBaudRate, pConfig->bHighSpeed))
+    {
+        return FALSE;
+    }
+
+    /* Same check as the compile-time one on the supported rates */
+    if(UART0_BAUD_ERROR_PERMILLE(pConfig->uBaudRate, pConfig->bHighSpeed) > UART0_BAUD_MAX_ERROR_PERMILLE)
+    {
+        return FALSE;
+    }
+
     /* Setup UART0 pins PA0 --> U0RX & PA1 --> U0TX */
     GPIO_SetupUART0Pins();
     
@@ -47,63 +209,85 @@ void UART0_Init(void) /* UART0 configuration: 1 start, 8 bits data, No Parity, 1
 
     UART0_CC_REG  = 0;                    /* Use System Clock*/
     
-    /* To Configure UART0 with Baud Rate 9600 */
-    UART0_IBRD_REG = 104;
-    UART0_FBRD_REG = 11;
+    /* Baud rate divisor, e.g. 9600 baud: 104 + 11/64 */
+    UART0_IBRD_REG = uDivisor64 >> 6;
+    UART0_FBRD_REG = uDivisor64 & 0x3F;
     
-    /* UART Line Control Register Settings
+    /* UART Line Control Register Settings (written after the divisors, it latches them)
      * BRK = 0 Normal Use
      * PEN = 0 Disable Parity
      * EPS = 0 No affect as the parity is disabled
      * STP2 = 0 1-stop bit at end of the frame
-     * FEN = 0 FIFOs are disabled
+     * FEN = FIFOs enabled as configured
      * WLEN = 0x3 8-bits data frame
      * SPS = 0 no stick parity
      */
-    UART0_LCRH_REG = (UART_DATA_8BITS << UART_LCRH_WLEN_BITS_POS);
+    UART0_LCRH_REG = (UART_DATA_8BITS << UART_LCRH_WLEN_BITS_POS) | (pConfig->bFifoEnable ? UART_LCRH_FEN_MASK : 0);
+
+    /* Let the uDMA serve TX requests (UDMA_Init must have been called to use UART0_SendBufferAsync) */
+    UART0_DMACTL_REG = UART_DMACTL_TXDMAE_MASK;
+
+    /* FIFO interrupt trigger levels, the TX interrupt refills the FIFO from the ring buffer */
+    UART0_IFLS_REG = (UART0_IFLS_REG & ~(UART_IFLS_TXIFLSEL_MASK | UART_IFLS_RXIFLSEL_MASK))
+                   | (uint32)pConfig->eTxFifoLevel
+                   | ((uint32)pConfig->eRxFifoLevel << UART_IFLS_RXIFLSEL_POS);
+
+    /* TX interrupt stays masked until there is something to send, the receive interrupts are always on:
+     * RX when the RX FIFO reaches its trigger level, RT when bytes sit below it for 32 bit periods */
+    UART0_IM_REG  = UART_IM_RXIM_MASK | UART_IM_RTIM_MASK;
+    UART0_ICR_REG = UART_ICR_TXIC_MASK | UART_ICR_RXIC_MASK | UART_ICR_RTIC_MASK;
+
+    /* Set UART0 priority as 5 (must not be above configMAX_SYSCALL_INTERRUPT_PRIORITY) and enable it in the NVIC */
+    NVIC_PRI1_REG = (NVIC_PRI1_REG & UART0_PRIORITY_MASK) | (UART0_INTERRUPT_PRIORITY<<UART0_PRIORITY_BITS_POS);
+    NVIC_EN0_REG |= UART0_NVIC_EN0_MASK;
     
     /* UART Control Register Settings
      * RXE = 1 Enable UART Receive
      * TXE = 1 Enable UART Transmit
-     * HSE = 0 The UART is clocked using the system clock divided by 16
+     * HSE = The baud clock is the system clock divided by 8 if set, by 16 otherwise
      * UARTEN = 1 Enable UART
      */
-    UART0_CTL_REG = UART_CTL_UARTEN_MASK | UART_CTL_TXE_MASK | UART_CTL_RXE_MASK;
+    UART0_CTL_REG = UART_CTL_UARTEN_MASK | UART_CTL_TXE_MASK | UART_CTL_RXE_MASK
+                  | (pConfig->bHighSpeed ? UART_CTL_HSE_MASK : 0);
+
+    return TRUE;
 }
        
 void UART0_SendByte(uint8 data)
 {
-    while(!(UART0_FR_REG & UART_FR_TXFE_MASK)); /* Wait until the transmit FIFO is empty */
-    UART0_DR_REG = data; /* Send the byte */
+    UART0_SendBufferNonBlocking(&data, 1);
 }
 
 uint8 UART0_ReceiveByte(void)
 {
-    while(UART0_FR_REG & UART_FR_RXFE_MASK); /* Wait until the receive FIFO is not empty */
-    return UART0_DR_REG; /* Read the byte */
+    uint8 uData;
+
+    while(UART0_ReceiveBufferNonBlocking(&uData, 1) == 0); /* Wait until the ISR has queued a byte */
+    return uData;
 }
 
 void UART0_SendString(const uint8 *pData)
 {
     uint32 uCounter =0;
-	/* Transmit the whole string */
+    /* Find the string length then queue it in one go */
     while(pData[uCounter] != '\0')
     {
-        UART0_SendByte(pData[uCounter]); /* Send the byte */
-        uCounter++; /* increment the counter to the next byte */
+        uCounter++;
     }
+    UART0_SendBufferNonBlocking(pData, uCounter);
 }
 
 void UART0_SendInteger(sint64 sNumber)
 {
 
-    uint8 uDigits[20];
+    uint8 uDigits[21];
     sint8 uCounter = 0;
+    boolean uNegative = FALSE;
 
-    /* Send the negative sign in case of negative numbers */
+    /* Remember the negative sign in case of negative numbers */
     if (sNumber < 0)
     {
-        UART0_SendByte('-');
+        uNegative = TRUE;
         sNumber *= -1;
     }
 
@@ -115,9 +299,166 @@ void UART0_SendInteger(sint64 sNumber)
     }
     while (sNumber != 0);
 
-    /* Send the array of characters in a reverse order as the digits were converted from right to left */
-    for( uCounter--; uCounter>= 0; uCounter--)
+    if (uNegative)
+    {
+        uDigits[uCounter++] = '-';
+    }
+
+    /* Reverse the array of characters as the digits were converted from right to left */
+    {
+        sint8 uStart = 0;
+        sint8 uEnd = uCounter - 1;
+        while (uStart < uEnd)
+        {
+            uint8 uTemp = uDigits[uStart];
+            uDigits[uStart++] = uDigits[uEnd];
+            uDigits[uEnd--] = uTemp;
+        }
+    }
+
+    UART0_SendBufferNonBlocking(uDigits, (uint32)uCounter);
+}
+
+uint32 UART0_SendBufferNonBlocking(const uint8 *pData, uint32 uLength)
+{
+    uint32 uCounter;
+    uint32 uIsrState;
+
+    /* Keep the ISR away from the ring indices while the buffer is being filled */
+    uIsrState = UART0_LockIsr();
+
+    for(uCounter = 0; uCounter < uLength; uCounter++)
+    {
+        if(!UART0_EnqueueByte(pData[uCounter]))
+        {
+            UART0_TxDroppedBytes += (uLength - uCounter - 1); /* Count the rest of the dropped bytes */
+            break;
+        }
+    }
+
+    UART0_StartTx();
+    UART0_UnlockIsr(uIsrState);
+    return uCounter;
+}
+
+boolean UART0_SendBufferAsync(const uint8 *pData, uint32 uLength, UART0_TxCompleteCallbackType pfCallback)
+{
+    boolean bAccepted = FALSE;
+    uint32 uIsrState;
+
+    if((pData == NULL_PTR) || (uLength == 0) || (uLength > UDMA_MAX_TRANSFER_SIZE))
+    {
+        return FALSE;
+    }
+
+    uIsrState = UART0_LockIsr();
+    if(UART0_DmaState == UART0_DMA_IDLE)
+    {
+        UART0_DmaData     = pData;
+        UART0_DmaLength   = uLength;
+        UART0_DmaCallback = pfCallback;
+
+        if(UART0_TxTail == UART0_TxHead)
+        {
+            UART0_StartDma();
+        }
+        else
+        {
+            /* Keep the byte order: the ISR starts the frame once the queued bytes are out */
+            UART0_DmaState = UART0_DMA_PENDING;
+        }
+        bAccepted = TRUE;
+    }
+    UART0_UnlockIsr(uIsrState);
+
+    return bAccepted;
+}
+
+boolean UART0_IsTxDmaBusy(void)
+{
+    return (UART0_DmaState != UART0_DMA_IDLE) ? TRUE : FALSE;
+}
+
+uint32 UART0_GetTxFreeSpace(void)
+{
+    return (UART0_TxTail - UART0_TxHead - 1) & (UART0_TX_BUFFER_SIZE - 1);
+}
+
+uint32 UART0_GetTxDroppedBytes(void)
+{
+    return UART0_TxDroppedBytes;
+}
+
+uint32 UART0_ReceiveBufferNonBlocking(uint8 *pData, uint32 uMaxLength)
+{
+    uint32 uCounter = 0;
+
+    /* Single reader: only the ISR moves the head, no lock needed */
+    while((uCounter < uMaxLength) && (UART0_RxTail != UART0_RxHead))
+    {
+        pData[uCounter++] = UART0_RxBuffer[UART0_RxTail];
+        UART0_RxTail = (UART0_RxTail + 1) & (UART0_RX_BUFFER_SIZE - 1);
+    }
+    return uCounter;
+}
+
+uint32 UART0_GetRxDroppedBytes(void)
+{
+    return UART0_RxDroppedBytes;
+}
+
+void UART0_SetRxCallback(UART0_RxCallbackType pfCallback)
+{
+    UART0_RxCallback = pfCallback;
+}
+
+/* Interrupt body, kept apart from UART0_Handler so the early return still passes the trace exit hook */
+static void UART0_ServiceInterrupt(void)
+{
+    /* Clear the TX, RX and receive time-out flags, both FIFOs are serviced whichever one raised it */
+    UART0_ICR_REG = UART_ICR_TXIC_MASK | UART_ICR_RXIC_MASK | UART_ICR_RTIC_MASK;
+
+    /* Received bytes first, they are lost once the RX FIFO overruns */
+    UART0_DrainRxFifo();
+
+    /* uDMA completion is reported on the peripheral interrupt */
+    if((UART0_DmaState == UART0_DMA_ACTIVE) && UDMA_ChannelClearDone(UDMA_CHANNEL_UART0TX))
+    {
+        UART0_TxCompleteCallbackType pfCallback = UART0_DmaCallback;
+        UART0_DmaState = UART0_DMA_IDLE;
+        if(pfCallback != NULL_PTR)
+        {
+            pfCallback();
+        }
+    }
+
+    if(UART0_DmaState == UART0_DMA_ACTIVE)
+    {
+        return;
+    }
+
+    UART0_FillTxFifo();
+
+    if(UART0_TxTail == UART0_TxHead)
+    {
+        if(UART0_DmaState == UART0_DMA_PENDING)
+        {
+            UART0_StartDma();
+        }
+        else
+        {
+            UART0_IM_REG &= ~UART_IM_TXIM_MASK; /* Nothing left to send */
+        }
+    }
+    else
     {
-        UART0_SendByte(uDigits[uCounter]);
+        UART0_IM_REG |= UART_IM_TXIM_MASK;  /* Resume ring draining after a uDMA frame */
     }
 }
+
+void UART0_Handler(void)
+{
+    TRACE_ISR_ENTER(TRACE_ISR_UART0);
+    UART0_ServiceInterrupt();
+    TRACE_ISR_EXIT(TRACE_ISR_UART0);
+}
@@ -24,23 +24,157 @@
 #define UART_DATA_8BITS          0x3
 #define UART_LCRH_WLEN_BITS_POS  5
 #define UART_CTL_UARTEN_MASK     0x00000001
+#define UART_CTL_HSE_MASK        0x00000020
 #define UART_CTL_TXE_MASK        0x00000100
 #define UART_CTL_RXE_MASK        0x00000200
 #define UART_FR_TXFE_MASK        0x00000080
 #define UART_FR_RXFE_MASK        0x00000010
+#define UART_FR_TXFF_MASK        0x00000020
+#define UART_LCRH_FEN_MASK       0x00000010
+#define UART_IM_RXIM_MASK        0x00000010
+#define UART_IM_TXIM_MASK        0x00000020
+#define UART_IM_RTIM_MASK        0x00000040
+#define UART_ICR_RXIC_MASK       0x00000010
+#define UART_ICR_TXIC_MASK       0x00000020
+#define UART_ICR_RTIC_MASK       0x00000040
+#define UART_IFLS_TX1_8          0x00000000
+#define UART_IFLS_TXIFLSEL_MASK  0x00000007
+#define UART_IFLS_RXIFLSEL_MASK  0x00000038
+#define UART_IFLS_RXIFLSEL_POS   3
+#define UART_DMACTL_TXDMAE_MASK  0x00000002
+
+/* UART0 is interrupt number 5: priority bits 13, 14 and 15 in PRI1, enable bit 5 in EN0 */
+#define UART0_PRIORITY_MASK      0xFFFF1FFF
+#define UART0_PRIORITY_BITS_POS  13
+#define UART0_INTERRUPT_PRIORITY 5
+#define UART0_NVIC_EN0_MASK      0x00000020
+
+/* Size of the software transmit ring buffer, must be a power of 2 */
+#define UART0_TX_BUFFER_SIZE     256U
+
+/* Size of the software receive ring buffer, must be a power of 2 */
+#define UART0_RX_BUFFER_SIZE     64U
+
+/* UART0 is clocked from the 16 MHz system clock (CC = 0) */
+#define UART0_CLOCK_HZ           16000000UL
+
+/* Largest accepted difference between the requested and the generated baud rate, in 1/1000 */
+#define UART0_BAUD_MAX_ERROR_PERMILLE   20UL
+
+/*
+ * Baud rate divisor in 1/64 steps, rounded to nearest: IBRD = DIVISOR64 >> 6, FBRD = DIVISOR64 & 0x3F.
+ * The baud clock is the UART clock divided by 16, or by 8 with HSE set (hse = 1).
+ * Plain integer arithmetic, so the macros also work in #if directives.
+ */
+#define UART0_BAUD_DIVISOR64(baud, hse) \
+    ((((UART0_CLOCK_HZ * ((hse) ? 16UL : 8UL)) / (baud)) + 1UL) / 2UL)
+
+/* IBRD must be 1..65535 */
+#define UART0_BAUD_IN_RANGE(baud, hse) \
+    ((UART0_BAUD_DIVISOR64(baud, hse) >= 64UL) && (UART0_BAUD_DIVISOR64(baud, hse) <= 0x3FFFFFUL))
+
+/* DIVISOR64 x baud equals the baud clock x 64 for an exact rate. The error is taken from that
+ * product rather than from the generated rate, which would be truncated to whole baud and look
+ * several percent off at the lowest rates. Only valid with UART0_BAUD_IN_RANGE, both stay near
+ * 128 000 000 at most and fit 32 bits. */
+#define UART0_BAUD_CLOCK64(hse) \
+    (UART0_CLOCK_HZ * ((hse) ? 8UL : 4UL))
+
+#define UART0_BAUD_PRODUCT(baud, hse) \
+    (UART0_BAUD_DIVISOR64(baud, hse) * (baud))
+
+#define UART0_BAUD_ERROR_PERMILLE(baud, hse) \
+    (((UART0_BAUD_PRODUCT(baud, hse) > UART0_BAUD_CLOCK64(hse)) \
+          ? (UART0_BAUD_PRODUCT(baud, hse) - UART0_BAUD_CLOCK64(hse)) \
+          : (UART0_BAUD_CLOCK64(hse) - UART0_BAUD_PRODUCT(baud, hse))) / (UART0_BAUD_PRODUCT(baud, hse) / 1000UL))
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* Called from UART0_Handler (interrupt context) once a UART0_SendBufferAsync frame is out */
+typedef void (*UART0_TxCompleteCallbackType)(void);
+
+/* Called from UART0_Handler (interrupt context) after received bytes were queued in the receive ring */
+typedef void (*UART0_RxCallbackType)(void);
+
+/* FIFO interrupt trigger levels, in the UARTIFLS encoding */
+typedef enum
+{
+    UART0_FIFO_LEVEL_1_8,
+    UART0_FIFO_LEVEL_1_4,
+    UART0_FIFO_LEVEL_1_2,
+    UART0_FIFO_LEVEL_3_4,
+    UART0_FIFO_LEVEL_7_8
+} UART0_FifoLevelType;
+
+/* Line settings for UART0_Init, the frame format is always 8N1 */
+typedef struct
+{
+    uint32 uBaudRate;
+    boolean bHighSpeed;                 /* HSE: baud clock = UART clock / 8, needed above UART0_CLOCK_HZ / 16 */
+    boolean bFifoEnable;                /* 16-byte hardware FIFOs, otherwise one holding register each way */
+    UART0_FifoLevelType eTxFifoLevel;   /* TX interrupt when the TX FIFO drains to this level */
+    UART0_FifoLevelType eRxFifoLevel;   /* RX interrupt when the RX FIFO fills to this level */
+} UART0_ConfigType;
 
 /*******************************************************************************
  *                            Functions Prototypes                             *
  *******************************************************************************/
 
-extern void UART0_Init(void);
+/*
+ * Configure UART0 for 8N1 with the given line settings. The divisors are computed from UART0_CLOCK_HZ.
+ * Returns FALSE, leaving UART0 disabled, if the baud rate is out of range for the clock divider or the
+ * generated rate is off by more than UART0_BAUD_MAX_ERROR_PERMILLE.
+ */
+extern boolean UART0_Init(const UART0_ConfigType *pConfig);
 
 extern void UART0_SendByte(uint8 data);
 
+/* Wait until a byte is in the receive ring and return it (spins, prefer UART0_ReceiveBufferNonBlocking) */
 extern uint8 UART0_ReceiveByte(void);
 
 extern void UART0_SendString(const uint8 *pData);
 
 extern void UART0_SendInteger(sint64 sNumber);
 
+/*
+ * Queue up to uLength bytes for transmission and return immediately.
+ * Bytes that do not fit in the transmit ring buffer are dropped (and counted),
+ * the return value is the number of bytes actually queued.
+ * Callers from different tasks must serialize their calls.
+ */
+extern uint32 UART0_SendBufferNonBlocking(const uint8 *pData, uint32 uLength);
+
+/* Number of bytes that can currently be queued without being dropped */
+extern uint32 UART0_GetTxFreeSpace(void);
+
+/* Number of bytes dropped so far because the transmit ring buffer was full */
+extern uint32 UART0_GetTxDroppedBytes(void);
+
+/*
+ * Hand a whole preformatted frame (up to UDMA_MAX_TRANSFER_SIZE bytes) to the uDMA.
+ * The buffer must stay untouched until pfCallback is called.
+ * Returns FALSE if a previous frame is still in flight.
+ */
+extern boolean UART0_SendBufferAsync(const uint8 *pData, uint32 uLength, UART0_TxCompleteCallbackType pfCallback);
+
+extern boolean UART0_IsTxDmaBusy(void);
+
+/*
+ * Copy up to uMaxLength received bytes out of the receive ring and return immediately.
+ * The return value is the number of bytes copied, 0 if nothing was received.
+ * Only one task may read.
+ */
+extern uint32 UART0_ReceiveBufferNonBlocking(uint8 *pData, uint32 uMaxLength);
+
+/* Number of bytes dropped so far because the receive ring buffer was full */
+extern uint32 UART0_GetRxDroppedBytes(void);
+
+/* Register the function the receive interrupt calls once bytes are queued, NULL_PTR for none */
+extern void UART0_SetRxCallback(UART0_RxCallbackType pfCallback);
+
+/* UART0 interrupt service routine, must be placed in the vector table */
+extern void UART0_Handler(void);
+
 #endif
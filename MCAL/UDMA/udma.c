@@ -0,0 +1,100 @@
+ /******************************************************************************
+ *
+ * Module: UDMA
+ *
+ * File Name: udma.c
+ *
+ * Description: Source file for the TM4C123GH6PM micro DMA driver (basic memory to peripheral transfers)
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+#include "udma.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                              Private Variables                              *
+ *******************************************************************************/
+
+/* Primary channel control table, the hardware requires a 1024-byte aligned base address */
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(UDMA_ControlTable, 1024)
+static UDMA_ControlTableEntryType UDMA_ControlTable[UDMA_NUM_CHANNELS];
+#else
+static UDMA_ControlTableEntryType UDMA_ControlTable[UDMA_NUM_CHANNELS] __attribute__ ((aligned(1024)));
+#endif
+
+/*******************************************************************************
+ *                         Public Functions Definitions                        *
+ *******************************************************************************/
+
+void UDMA_Init(void)
+{
+    SYSCTL_RCGCDMA_REG |= 0x01;            /* Enable clock for the uDMA module */
+    while(!(SYSCTL_PRDMA_REG & 0x01));     /* Wait until the uDMA clock is activated and it is ready for access */
+
+    UDMA_CFG_REG     = UDMA_CFG_MASTEN_MASK;       /* Enable the uDMA controller */
+#if !defined(SIMULATION)
+    UDMA_CTLBASE_REG = (uint32)UDMA_ControlTable;  /* Point the controller to the channel control table */
+#endif
+}
+
+uint32 UDMA_BuildMemToPeriphControl(uint32 uLength)
+{
+    /* Source walks through memory byte by byte, destination is a fixed FIFO register,
+     * re-arbitrate every 4 items so the transfer fits in the FIFO trigger level */
+    return UDMA_CHCTL_DSTINC_NONE | UDMA_CHCTL_DSTSIZE_8 |
+           UDMA_CHCTL_SRCINC_8 | UDMA_CHCTL_SRCSIZE_8 |
+           UDMA_CHCTL_ARBSIZE_4 |
+           ((uLength - 1) << UDMA_CHCTL_XFERSIZE_POS) |
+           UDMA_CHCTL_XFERMODE_BASIC;
+}
+
+boolean UDMA_StartMemToPeriph(uint8 uChannel, const uint8 *pSrc, volatile uint32 *pDst, uint32 uLength)
+{
+    uint32 uChannelMask = (1UL << uChannel);
+    UDMA_ControlTableEntryType *pEntry = &UDMA_ControlTable[uChannel];
+
+    if((uLength == 0) || (uLength > UDMA_MAX_TRANSFER_SIZE) || UDMA_ChannelIsBusy(uChannel))
+    {
+        return FALSE;
+    }
+
+    UDMA_USEBURSTCLR_R  = uChannelMask;    /* Accept both single and burst requests */
+    UDMA_ALTCLR_REG     = uChannelMask;    /* Use the primary control structure */
+    UDMA_PRIOCLR_REG    = uChannelMask;    /* Default priority */
+    UDMA_REQMASKCLR_REG = uChannelMask;    /* Let the peripheral trigger the channel */
+
+    /* The hardware takes the address of the last item, not the first one */
+    pEntry->pvSrcEndAddr = pSrc + uLength - 1;
+    pEntry->pvDstEndAddr = pDst;
+    pEntry->uControl     = UDMA_BuildMemToPeriphControl(uLength);
+
+    UDMA_ENASET_REG = uChannelMask;        /* Enable the channel, the hardware clears it when done */
+    return TRUE;
+}
+
+boolean UDMA_ChannelClearDone(uint8 uChannel)
+{
+    uint32 uChannelMask = (1UL << uChannel);
+
+    if(UDMA_CHIS_REG & uChannelMask)
+    {
+        UDMA_CHIS_REG = uChannelMask;      /* Write 1 to clear */
+        return TRUE;
+    }
+    return FALSE;
+}
+
+boolean UDMA_ChannelIsBusy(uint8 uChannel)
+{
+    return (UDMA_ENASET_REG & (1UL << uChannel)) ? TRUE : FALSE;
+}
+
+#if defined(SIMULATION)
+const UDMA_ControlTableEntryType *UDMA_GetControlTable(void)
+{
+    return UDMA_ControlTable;
+}
+#endif
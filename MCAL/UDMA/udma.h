@@ -0,0 +1,76 @@
+ /******************************************************************************
+ *
+ * Module: UDMA
+ *
+ * File Name: udma.h
+ *
+ * Description: Header file for the TM4C123GH6PM micro DMA driver (basic memory to peripheral transfers)
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+#ifndef UDMA_H_
+#define UDMA_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+#define UDMA_CHANNEL_UART0TX         9U      /* UART0 TX request, channel encoding 0 */
+#define UDMA_NUM_CHANNELS            32U
+#define UDMA_MAX_TRANSFER_SIZE       1024U   /* XFERSIZE is a 10-bit field holding (items - 1) */
+
+#define UDMA_CFG_MASTEN_MASK         0x00000001
+
+/* Channel control word fields */
+#define UDMA_CHCTL_DSTINC_NONE       0xC0000000
+#define UDMA_CHCTL_DSTSIZE_8         0x00000000
+#define UDMA_CHCTL_SRCINC_8          0x00000000
+#define UDMA_CHCTL_SRCSIZE_8         0x00000000
+#define UDMA_CHCTL_ARBSIZE_4         0x00008000
+#define UDMA_CHCTL_XFERSIZE_POS      4
+#define UDMA_CHCTL_XFERSIZE_MASK     0x00003FF0
+#define UDMA_CHCTL_XFERMODE_BASIC    0x00000001
+#define UDMA_CHCTL_XFERMODE_MASK     0x00000007
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+/* One entry of the channel control table, layout fixed by the hardware */
+typedef struct
+{
+    volatile const void *pvSrcEndAddr;
+    volatile void *pvDstEndAddr;
+    volatile uint32 uControl;
+    uint32 uSpare;
+} UDMA_ControlTableEntryType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+extern void UDMA_Init(void);
+
+/* Control word for a byte-wide memory to peripheral-FIFO transfer of uLength items */
+extern uint32 UDMA_BuildMemToPeriphControl(uint32 uLength);
+
+/*
+ * Start a basic transfer of uLength bytes from pSrc to the peripheral data register pDst.
+ * Returns FALSE if the length is out of range or the channel is still busy.
+ */
+extern boolean UDMA_StartMemToPeriph(uint8 uChannel, const uint8 *pSrc, volatile uint32 *pDst, uint32 uLength);
+
+/* Returns TRUE (and clears the flag) if the channel raised its completion interrupt */
+extern boolean UDMA_ChannelClearDone(uint8 uChannel);
+
+extern boolean UDMA_ChannelIsBusy(uint8 uChannel);
+
+#if defined(SIMULATION)
+/* A 64-bit host address does not fit CTLBASE, the simulated controller finds the table here */
+extern const UDMA_ControlTableEntryType *UDMA_GetControlTable(void);
+#endif
+
+#endif /* UDMA_H_ */
@@ -0,0 +1,50 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Common
+ *  File        : irq_lock.h
+ *  Description : Short interrupt lockout usable from tasks, ISRs and kernel hooks
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_COMMON_IRQ_LOCK_H_
+#define SERVICES_COMMON_IRQ_LOCK_H_
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Masks all maskable interrupts (PRIMASK) and returns the previous state
+ *
+ * Unlike taskENTER_CRITICAL() it nests, works at any interrupt priority and
+ * inside the kernel trace hooks. Keep the locked section to a few instructions.
+ * The host simulation runs interrupt handlers in a task, so there is nothing to mask.
+ */
+#if defined(SIMULATION)
+#define IRQ_LOCK_SAVE()             (0U)
+#define IRQ_LOCK_RESTORE(state)     ((void)(state))
+#elif defined(__TI_COMPILER_VERSION__)
+#define IRQ_LOCK_SAVE()             ((uint32_t)_disable_interrupts())
+#define IRQ_LOCK_RESTORE(state)     ((void)_restore_interrupts(state))
+#elif defined(__GNUC__)
+static inline uint32_t IRQ_lockSave(void)
+{
+    uint32_t ui32Primask;
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (ui32Primask) : : "memory");
+    return ui32Primask;
+}
+static inline void IRQ_lockRestore(uint32_t ui32Primask)
+{
+    __asm volatile ("msr primask, %0" : : "r" (ui32Primask) : "memory");
+}
+#define IRQ_LOCK_SAVE()             IRQ_lockSave()
+#define IRQ_LOCK_RESTORE(state)     IRQ_lockRestore(state)
+#else
+#error "IRQ_LOCK_SAVE() is not defined for this compiler"
+#endif
+
+#endif /* SERVICES_COMMON_IRQ_LOCK_H_ */
@@ -0,0 +1,46 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Common
+ *  File        : memory_barrier.h
+ *  Description : Compiler/CPU memory barrier used by the lock-free modules
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_COMMON_MEMORY_BARRIER_H_
+#define SERVICES_COMMON_MEMORY_BARRIER_H_
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Orders the surrounding loads/stores for the compiler and the CPU
+ *
+ * On the single-core Cortex-M4 only the compiler ordering matters, the DMB keeps
+ * the same code correct on host builds running producer and consumer on
+ * different cores.
+ */
+#if defined(__GNUC__)
+#define MEMORY_BARRIER()    __sync_synchronize()
+#elif defined(__TI_COMPILER_VERSION__)
+#define MEMORY_BARRIER()    __asm(" dmb")
+#else
+#error "MEMORY_BARRIER() is not defined for this compiler"
+#endif
+
+/**
+ * @brief Completes the preceding stores and refetches the following instructions
+ *
+ * DSB then ISB, as the ARM guidance asks after masking an interrupt in the NVIC:
+ * without them the interrupt can still be taken a few instructions after the
+ * store to the disable register. The host simulation runs handlers in a task, so
+ * only the compiler ordering is needed there.
+ */
+#if defined(SIMULATION)
+#define MEMORY_BARRIER_SYNC()    MEMORY_BARRIER()
+#elif defined(__GNUC__)
+#define MEMORY_BARRIER_SYNC()    __asm volatile ("dsb\n isb" : : : "memory")
+#elif defined(__TI_COMPILER_VERSION__)
+#define MEMORY_BARRIER_SYNC()    do { __asm(" dsb"); __asm(" isb"); } while(0)
+#endif
+
+#endif /* SERVICES_COMMON_MEMORY_BARRIER_H_ */
@@ -0,0 +1,154 @@
+/*------------------------------------------------------------------------------
+ *  Module      : CPU Load
+ *  File        : cpu_load.c
+ *  Description : Sliding-window CPU load estimator based on idle task time
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/CPU_LOAD/cpu_load.h"
+
+/*------------------------------------------------------------------------------
+ *  LOCAL DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief One closed bucket
+ */
+typedef struct {
+    uint64_t ui64Elapsed;            /**< Timebase ticks covered by the bucket */
+    uint64_t ui64Busy;               /**< Non-idle ticks in the bucket */
+} CPU_LoadBucketType;
+
+/*------------------------------------------------------------------------------
+ *  LOCAL DATA
+ *----------------------------------------------------------------------------*/
+static const uint32_t aui32CpuLoadWindowBuckets[CPU_LOAD_WINDOW_COUNT] = { 1, 10, 60 };
+
+/** Writer side state, only touched by CPU_LOAD_update() */
+static CPU_LoadBucketType asCpuLoadHistory[CPU_LOAD_HISTORY_SIZE];
+static uint32_t ui32CpuLoadNextBucket = 0;
+static uint32_t ui32CpuLoadFilledBuckets = 0;
+static uint64_t ui64CpuLoadLastNow = 0;
+static uint64_t ui64CpuLoadLastIdle = 0;
+static uint8_t ui8CpuLoadStarted = 0;
+static uint32_t ui32CpuLoadEwmaState = 0;
+
+/** Published figures, single aligned 32-bit words */
+static volatile uint32_t aui32CpuLoadWindows[CPU_LOAD_WINDOW_COUNT];
+static volatile uint32_t ui32CpuLoadPeak = 0;
+static volatile uint32_t ui32CpuLoadEwma = 0;
+
+/*------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Busy/elapsed ratio in hundredths of a percent, 64-bit safe
+ */
+static uint32_t CPU_LOAD_ratio(uint64_t ui64Busy, uint64_t ui64Elapsed)
+{
+    if(ui64Elapsed == 0)
+    {
+        return 0;
+    }
+    if(ui64Busy > ui64Elapsed)
+    {
+        ui64Busy = ui64Elapsed;
+    }
+    return (uint32_t)((ui64Busy * CPU_LOAD_FULL_SCALE) / ui64Elapsed);
+}
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+void CPU_LOAD_update(uint64_t ui64Now, uint64_t ui64IdleTime)
+{
+    CPU_LoadBucketType *psBucket;
+    uint64_t ui64IdleDelta;
+    uint32_t ui32Window;
+    uint32_t ui32Instant;
+
+    if(!ui8CpuLoadStarted)
+    {
+        ui64CpuLoadLastNow = ui64Now;
+        ui64CpuLoadLastIdle = ui64IdleTime;
+        ui8CpuLoadStarted = 1;
+        return;
+    }
+
+    /* Close the bucket */
+    psBucket = &asCpuLoadHistory[ui32CpuLoadNextBucket];
+    psBucket->ui64Elapsed = ui64Now - ui64CpuLoadLastNow;
+    ui64IdleDelta = ui64IdleTime - ui64CpuLoadLastIdle;
+    psBucket->ui64Busy = (ui64IdleDelta < psBucket->ui64Elapsed) ? (psBucket->ui64Elapsed - ui64IdleDelta) : 0;
+
+    ui64CpuLoadLastNow = ui64Now;
+    ui64CpuLoadLastIdle = ui64IdleTime;
+    ui32CpuLoadNextBucket = (ui32CpuLoadNextBucket + 1) % CPU_LOAD_HISTORY_SIZE;
+    if(ui32CpuLoadFilledBuckets < CPU_LOAD_HISTORY_SIZE)
+    {
+        ui32CpuLoadFilledBuckets++;
+    }
+
+    /* Time weighted load of each window, shorter while the history fills up */
+    for(ui32Window = 0; ui32Window < CPU_LOAD_WINDOW_COUNT; ui32Window++)
+    {
+        uint32_t ui32Buckets = aui32CpuLoadWindowBuckets[ui32Window];
+        uint32_t ui32Index = ui32CpuLoadNextBucket;
+        uint64_t ui64Busy = 0;
+        uint64_t ui64Elapsed = 0;
+
+        if(ui32Buckets > ui32CpuLoadFilledBuckets)
+        {
+            ui32Buckets = ui32CpuLoadFilledBuckets;
+        }
+        while(ui32Buckets--)
+        {
+            ui32Index = (ui32Index + CPU_LOAD_HISTORY_SIZE - 1) % CPU_LOAD_HISTORY_SIZE;
+            ui64Busy += asCpuLoadHistory[ui32Index].ui64Busy;
+            ui64Elapsed += asCpuLoadHistory[ui32Index].ui64Elapsed;
+        }
+        aui32CpuLoadWindows[ui32Window] = CPU_LOAD_ratio(ui64Busy, ui64Elapsed);
+    }
+
+    /* Peak and EWMA follow the single-bucket (instantaneous) load */
+    ui32Instant = aui32CpuLoadWindows[CPU_LOAD_WINDOW_1S];
+    if(ui32Instant > ui32CpuLoadPeak)
+    {
+        ui32CpuLoadPeak = ui32Instant;
+    }
+    if(ui32CpuLoadFilledBuckets == 1)
+    {
+        ui32CpuLoadEwmaState = ui32Instant << CPU_LOAD_EWMA_SHIFT;
+    }
+    else
+    {
+        /* State is kept scaled by 2^shift so small steps are not lost */
+        ui32CpuLoadEwmaState += ui32Instant - (ui32CpuLoadEwmaState >> CPU_LOAD_EWMA_SHIFT);
+    }
+    ui32CpuLoadEwma = ui32CpuLoadEwmaState >> CPU_LOAD_EWMA_SHIFT;
+}
+
+uint32_t CPU_LOAD_getLoad(CPU_LoadWindowType eWindow)
+{
+    return (eWindow < CPU_LOAD_WINDOW_COUNT) ? aui32CpuLoadWindows[eWindow] : 0;
+}
+
+uint32_t CPU_LOAD_getPeak(void)
+{
+    return ui32CpuLoadPeak;
+}
+
+uint32_t CPU_LOAD_getEwma(void)
+{
+    return ui32CpuLoadEwma;
+}
+
+void CPU_LOAD_resetPeak(void)
+{
+    ui32CpuLoadPeak = 0;
+}
@@ -0,0 +1,89 @@
+/*------------------------------------------------------------------------------
+ *  Module      : CPU Load
+ *  File        : cpu_load.h
+ *  Description : Sliding-window CPU load estimator based on idle task time
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_CPU_LOAD_CPU_LOAD_H_
+#define SERVICES_CPU_LOAD_CPU_LOAD_H_
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup CPU_Load_Configuration CPU load settings
+ * @{
+ */
+#define CPU_LOAD_BUCKET_PERIOD_MS  1000  /**< CPU_LOAD_update() call period, one history bucket each */
+#define CPU_LOAD_HISTORY_SIZE      60    /**< Buckets kept, must cover the longest window */
+#define CPU_LOAD_EWMA_SHIFT        3     /**< EWMA weight of a new bucket is 1/2^shift */
+#define CPU_LOAD_FULL_SCALE        10000 /**< Loads are reported in hundredths of a percent */
+/** @} */
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Averaging windows, lengths in buckets are 1, 10 and 60
+ */
+typedef enum {
+    CPU_LOAD_WINDOW_1S,
+    CPU_LOAD_WINDOW_10S,
+    CPU_LOAD_WINDOW_60S,
+    CPU_LOAD_WINDOW_COUNT
+} CPU_LoadWindowType;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup CPU_Load_Functions CPU Load Functions
+ * @{
+ */
+
+/**
+ * @brief Closes the current bucket and refreshes every published figure
+ *
+ * Called by a single task every CPU_LOAD_BUCKET_PERIOD_MS. The first call only
+ * sets the reference point.
+ *
+ * @param ui64Now       Timebase now (any monotonic 64-bit clock)
+ * @param ui64IdleTime  Idle time accounted so far on the same clock
+ */
+void CPU_LOAD_update(uint64_t ui64Now, uint64_t ui64IdleTime);
+
+/**
+ * @brief Load over a window (time weighted), in hundredths of a percent
+ *
+ * Like every getter below it reads one published 32-bit word, so any task or
+ * ISR may call it without a lock.
+ */
+uint32_t CPU_LOAD_getLoad(CPU_LoadWindowType eWindow);
+
+/**
+ * @brief Highest single-bucket load since boot or CPU_LOAD_resetPeak()
+ */
+uint32_t CPU_LOAD_getPeak(void);
+
+/**
+ * @brief Exponentially weighted load, in hundredths of a percent
+ */
+uint32_t CPU_LOAD_getEwma(void);
+
+/**
+ * @brief Restarts peak tracking
+ */
+void CPU_LOAD_resetPeak(void);
+
+/** @} */
+
+#endif /* SERVICES_CPU_LOAD_CPU_LOAD_H_ */
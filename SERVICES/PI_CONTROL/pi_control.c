@@ -0,0 +1,99 @@
+/*------------------------------------------------------------------------------
+ *  Module      : PI Controller
+ *  File        : pi_control.c
+ *  Description : Fixed-point PI temperature controller with anti-windup
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/PI_CONTROL/pi_control.h"
+
+/*------------------------------------------------------------------------------
+ *  LOCAL DEFINITIONS
+ *----------------------------------------------------------------------------*/
+#define PI_OUTPUT_MAX_Q16      ((int32_t)PI_OUTPUT_MAX << PI_GAIN_FRAC_BITS)
+
+/*------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Gain (Q16.16) times error (Q8), result in Q16.16 saturated to int32
+ */
+static int32_t PI_scale(int32_t i32GainQ16, int32_t i32ErrorQ8)
+{
+    int64_t i64Product = ((int64_t)i32GainQ16 * i32ErrorQ8) >> PI_TEMP_FRAC_BITS;
+
+    if(i64Product > INT32_MAX)
+    {
+        return INT32_MAX;
+    }
+    if(i64Product < INT32_MIN)
+    {
+        return INT32_MIN;
+    }
+    return (int32_t)i64Product;
+}
+
+/**
+ * @brief Clamps a Q16.16 percentage to 0..PI_OUTPUT_MAX
+ */
+static int32_t PI_clamp(int64_t i64ValueQ16)
+{
+    if(i64ValueQ16 < 0)
+    {
+        return 0;
+    }
+    if(i64ValueQ16 > PI_OUTPUT_MAX_Q16)
+    {
+        return PI_OUTPUT_MAX_Q16;
+    }
+    return (int32_t)i64ValueQ16;
+}
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Binds a loop to its gains and clears it
+ */
+void PI_init(PI_StateType *psState, const PI_GainsType *psGains)
+{
+    psState->psGains = psGains;
+    PI_reset(psState);
+}
+
+/**
+ * @brief Clears the integral term
+ */
+void PI_reset(PI_StateType *psState)
+{
+    psState->i32IntegralQ16 = 0;
+}
+
+/**
+ * @brief One controller step
+ */
+uint8_t PI_update(PI_StateType *psState, int32_t i32SetpointQ8, int32_t i32MeasuredQ8)
+{
+    int32_t i32ErrorQ8 = i32SetpointQ8 - i32MeasuredQ8;
+    int32_t i32ProportionalQ16 = PI_scale(psState->psGains->i32KpQ16, i32ErrorQ8);
+    int64_t i64OutputQ16 = (int64_t)i32ProportionalQ16 + psState->i32IntegralQ16;
+    int32_t i32OutputQ16;
+
+    /* Conditional integration: do not push further into a saturated output */
+    if(!((i64OutputQ16 >= PI_OUTPUT_MAX_Q16) && (i32ErrorQ8 > 0)) &&
+       !((i64OutputQ16 <= 0) && (i32ErrorQ8 < 0)))
+    {
+        psState->i32IntegralQ16 = PI_clamp((int64_t)psState->i32IntegralQ16 +
+                                           PI_scale(psState->psGains->i32KiQ16, i32ErrorQ8));
+        i64OutputQ16 = (int64_t)i32ProportionalQ16 + psState->i32IntegralQ16;
+    }
+
+    /* Round to whole percent, the PWM resolution */
+    i32OutputQ16 = PI_clamp(i64OutputQ16);
+    return (uint8_t)((i32OutputQ16 + (1L << (PI_GAIN_FRAC_BITS - 1))) >> PI_GAIN_FRAC_BITS);
+}
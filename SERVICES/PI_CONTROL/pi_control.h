@@ -0,0 +1,98 @@
+/*------------------------------------------------------------------------------
+ *  Module      : PI Controller
+ *  File        : pi_control.h
+ *  Description : Fixed-point PI temperature controller with anti-windup
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_PI_CONTROL_PI_CONTROL_H_
+#define SERVICES_PI_CONTROL_PI_CONTROL_H_
+
+/*
+ * Temperatures are degrees C in Q8 (1/256 C), gains and the integral term are
+ * Q16.16. The update runs on integers only, with one 64-bit product per term,
+ * so there is no soft-float on the control path and the module builds
+ * unchanged on the host.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup PI_Configuration PI controller settings
+ * @{
+ */
+#define PI_GAIN_FRAC_BITS      16    /**< Gains and integral term are Q16.16 */
+#define PI_TEMP_FRAC_BITS      8     /**< Temperatures are Q8 degrees C */
+#define PI_OUTPUT_MAX          100   /**< Full heater command, in percent */
+/** @} */
+
+/**
+ * @brief Q16.16 constant from a literal, folded by the compiler
+ */
+#define PI_GAIN_Q16(gain)      ((int32_t)((gain) * (1L << PI_GAIN_FRAC_BITS) + 0.5))
+
+/**
+ * @brief Q8 temperature from whole degrees C
+ */
+#define PI_TEMP_Q8(tempC)      ((int32_t)(tempC) << PI_TEMP_FRAC_BITS)
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Controller gains, one set per seat
+ */
+typedef struct {
+    int32_t i32KpQ16;     /**< Percent of command per degree C of error */
+    int32_t i32KiQ16;     /**< Percent added to the integral per degree C of error and per update */
+} PI_GainsType;
+
+/**
+ * @brief Controller state of one loop
+ */
+typedef struct {
+    const PI_GainsType *psGains;
+    int32_t i32IntegralQ16;       /**< Integral term in percent, kept within 0..PI_OUTPUT_MAX */
+} PI_StateType;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup PI_Functions PI Controller Functions
+ * @{
+ */
+
+/**
+ * @brief Binds a loop to its gains and clears it
+ */
+void PI_init(PI_StateType *psState, const PI_GainsType *psGains);
+
+/**
+ * @brief Clears the integral term, e.g. when the heater is turned off
+ */
+void PI_reset(PI_StateType *psState);
+
+/**
+ * @brief One controller step, call once per control period
+ * @param i32SetpointQ8 Desired temperature (Q8 degrees C)
+ * @param i32MeasuredQ8 Filtered measured temperature (Q8 degrees C)
+ * @return Heater command, 0..PI_OUTPUT_MAX percent
+ *
+ * Anti-windup: the integral stops growing while the output is saturated in the
+ * direction of the error, and is itself clamped to the output range.
+ */
+uint8_t PI_update(PI_StateType *psState, int32_t i32SetpointQ8, int32_t i32MeasuredQ8);
+
+/** @} */
+
+#endif /* SERVICES_PI_CONTROL_PI_CONTROL_H_ */
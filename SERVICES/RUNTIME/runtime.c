@@ -0,0 +1,200 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Runtime Accounting
+ *  File        : runtime.c
+ *  Description : Per-task execution/response time statistics fed by the
+ *                FreeRTOS trace hooks (see runtime_trace.h)
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/RUNTIME/runtime.h"
+#include "SERVICES/RUNTIME/runtime_trace.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if (RUNTIME_TRACE_IDLE_TAG != RUNTIME_IDLE_TAG) || (RUNTIME_TRACE_OTHER_TAG != RUNTIME_OTHER_TAG)
+#error "The tags of the kernel tasks in runtime_trace.h must match runtime.h"
+#endif
+
+/*------------------------------------------------------------------------------
+ *  LOCAL DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Bookkeeping of the job in progress, only touched by the hooks
+ */
+typedef struct {
+    uint64_t ui64SwitchInTime;       /**< Time the task last got the CPU */
+    uint64_t ui64ReleaseTime;        /**< Time the current job was released */
+    uint64_t ui64JobExecTime;        /**< Execution time of the current job so far */
+    uint8_t ui8JobActive;            /**< A job has been released and not completed */
+} RUNTIME_JobType;
+
+/*------------------------------------------------------------------------------
+ *  LOCAL DATA
+ *----------------------------------------------------------------------------*/
+static RUNTIME_TaskStatsType asRuntimeStats[RUNTIME_MAX_TASKS];
+static RUNTIME_JobType asRuntimeJobs[RUNTIME_MAX_TASKS];
+
+/*------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Maps a tag to a table slot, unknown tags share the other slot so they never count as idle
+ */
+static uint32_t RUNTIME_slot(uint32_t ui32Tag)
+{
+    return (ui32Tag < RUNTIME_MAX_TASKS) ? ui32Tag : RUNTIME_OTHER_TAG;
+}
+
+/**
+ * @brief Folds a completed job into the min/max/sum statistics
+ */
+static void RUNTIME_completeJob(RUNTIME_TaskStatsType *psStats, RUNTIME_JobType *psJob, uint64_t ui64Now)
+{
+    uint64_t ui64Response = ui64Now - psJob->ui64ReleaseTime;
+
+    if((psStats->ui32Jobs == 0) || (psJob->ui64JobExecTime < psStats->ui64ExecTimeMin))
+    {
+        psStats->ui64ExecTimeMin = psJob->ui64JobExecTime;
+    }
+    if(psJob->ui64JobExecTime > psStats->ui64ExecTimeMax)
+    {
+        psStats->ui64ExecTimeMax = psJob->ui64JobExecTime;
+    }
+    if((psStats->ui32Jobs == 0) || (ui64Response < psStats->ui64ResponseTimeMin))
+    {
+        psStats->ui64ResponseTimeMin = ui64Response;
+    }
+    if(ui64Response > psStats->ui64ResponseTimeMax)
+    {
+        psStats->ui64ResponseTimeMax = ui64Response;
+    }
+    psStats->ui64ExecTimeSum += psJob->ui64JobExecTime;
+    psStats->ui64ResponseTimeSum += ui64Response;
+    psStats->ui32Jobs++;
+
+    psJob->ui8JobActive = 0;
+}
+
+/*------------------------------------------------------------------------------
+ *  HOOKS (called by the kernel with the scheduler locked)
+ *----------------------------------------------------------------------------*/
+
+void RUNTIME_taskReleased(uint32_t ui32Tag)
+{
+    RUNTIME_JobType *psJob = &asRuntimeJobs[RUNTIME_slot(ui32Tag)];
+
+    /* Re-adding an already released task (priority change, resume) is not a new job */
+    if(!psJob->ui8JobActive)
+    {
+        psJob->ui64ReleaseTime = RUNTIME_GET_TIME();
+        psJob->ui64JobExecTime = 0;
+        psJob->ui8JobActive = 1;
+    }
+}
+
+void RUNTIME_taskSwitchedIn(uint32_t ui32Tag)
+{
+    RUNTIME_JobType *psJob = &asRuntimeJobs[RUNTIME_slot(ui32Tag)];
+    uint64_t ui64Now = RUNTIME_GET_TIME();
+
+    if(!psJob->ui8JobActive)
+    {
+        /* Release was not traced (first run after creation) */
+        psJob->ui64ReleaseTime = ui64Now;
+        psJob->ui64JobExecTime = 0;
+        psJob->ui8JobActive = 1;
+    }
+    psJob->ui64SwitchInTime = ui64Now;
+}
+
+void RUNTIME_taskSwitchedOut(uint32_t ui32Tag, uint32_t ui32StillReady)
+{
+    uint32_t ui32Slot = RUNTIME_slot(ui32Tag);
+    RUNTIME_TaskStatsType *psStats = &asRuntimeStats[ui32Slot];
+    RUNTIME_JobType *psJob = &asRuntimeJobs[ui32Slot];
+    uint64_t ui64Now = RUNTIME_GET_TIME();
+    uint64_t ui64Delta = ui64Now - psJob->ui64SwitchInTime;
+
+    psStats->ui64TotalTime += ui64Delta;
+    psJob->ui64JobExecTime += ui64Delta;
+
+    if(ui32StillReady)
+    {
+        psStats->ui32Preemptions++;
+    }
+    else if((ui32Slot != RUNTIME_IDLE_TAG) && (ui32Slot != RUNTIME_OTHER_TAG))
+    {
+        /* The idle task has no jobs, and the jobs of several untagged tasks would mix */
+        RUNTIME_completeJob(psStats, psJob, ui64Now);
+    }
+}
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+int32_t RUNTIME_getTaskStats(uint32_t ui32Tag, RUNTIME_TaskStatsType *psStats)
+{
+    if(ui32Tag >= RUNTIME_MAX_TASKS)
+    {
+        return -1;
+    }
+
+    /* The hooks update 64-bit fields at every switch, copy them in one go */
+    taskENTER_CRITICAL();
+    *psStats = asRuntimeStats[ui32Tag];
+    taskEXIT_CRITICAL();
+    return 0;
+}
+
+uint64_t RUNTIME_getTotalTime(uint32_t ui32Tag)
+{
+    uint64_t ui64Total;
+
+    if(ui32Tag >= RUNTIME_MAX_TASKS)
+    {
+        return 0;
+    }
+
+    taskENTER_CRITICAL();
+    ui64Total = asRuntimeStats[ui32Tag].ui64TotalTime;
+    taskEXIT_CRITICAL();
+    return ui64Total;
+}
+
+uint64_t RUNTIME_getAverageExecTime(const RUNTIME_TaskStatsType *psStats)
+{
+    return (psStats->ui32Jobs != 0) ? (psStats->ui64ExecTimeSum / psStats->ui32Jobs) : 0;
+}
+
+uint64_t RUNTIME_getAverageResponseTime(const RUNTIME_TaskStatsType *psStats)
+{
+    return (psStats->ui32Jobs != 0) ? (psStats->ui64ResponseTimeSum / psStats->ui32Jobs) : 0;
+}
+
+void RUNTIME_reset(void)
+{
+    uint32_t ui32Slot;
+
+    taskENTER_CRITICAL();
+    for(ui32Slot = 0; ui32Slot < RUNTIME_MAX_TASKS; ui32Slot++)
+    {
+        RUNTIME_TaskStatsType *psStats = &asRuntimeStats[ui32Slot];
+
+        psStats->ui64TotalTime = 0;
+        psStats->ui64ExecTimeMin = 0;
+        psStats->ui64ExecTimeMax = 0;
+        psStats->ui64ExecTimeSum = 0;
+        psStats->ui64ResponseTimeMin = 0;
+        psStats->ui64ResponseTimeMax = 0;
+        psStats->ui64ResponseTimeSum = 0;
+        psStats->ui32Jobs = 0;
+        psStats->ui32Preemptions = 0;
+    }
+    taskEXIT_CRITICAL();
+}
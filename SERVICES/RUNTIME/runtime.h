@@ -0,0 +1,102 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Runtime Accounting
+ *  File        : runtime.h
+ *  Description : Per-task execution/response time statistics fed by the
+ *                FreeRTOS trace hooks (see runtime_trace.h)
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_RUNTIME_RUNTIME_H_
+#define SERVICES_RUNTIME_RUNTIME_H_
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Runtime_Configuration Runtime accounting settings
+ * @{
+ */
+#define RUNTIME_MAX_TASKS      10    /**< Table size, indexed by the application task tag */
+#define RUNTIME_IDLE_TAG       0     /**< Untagged tasks at the idle priority (the idle task) */
+#define RUNTIME_OTHER_TAG      (RUNTIME_MAX_TASKS - 1)  /**< Other untagged tasks (the timer task) and unknown tags */
+/** @} */
+
+/**
+ * @brief Timebase used by the hooks, in GPTM_TIMEBASE_HZ ticks
+ *
+ * Host builds can define RUNTIME_GET_TIME() to their own clock.
+ */
+#ifndef RUNTIME_GET_TIME
+#include "GPTM.h"
+#define RUNTIME_GET_TIME()     ((uint64_t)GPTM_WTimer0Read64())
+#endif
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Statistics of one task, all times in timebase ticks
+ *
+ * A job starts when the task becomes ready (or first runs) and completes when
+ * the task is switched out while no longer ready (blocked, delayed, suspended).
+ * Being switched out while still ready counts as a preemption.
+ */
+typedef struct {
+    uint64_t ui64TotalTime;          /**< Execution time since boot */
+    uint64_t ui64ExecTimeMin;        /**< Shortest job execution time */
+    uint64_t ui64ExecTimeMax;        /**< Longest job execution time */
+    uint64_t ui64ExecTimeSum;        /**< Sum of job execution times */
+    uint64_t ui64ResponseTimeMin;    /**< Shortest release to completion time */
+    uint64_t ui64ResponseTimeMax;    /**< Longest release to completion time */
+    uint64_t ui64ResponseTimeSum;    /**< Sum of release to completion times */
+    uint32_t ui32Jobs;               /**< Completed jobs */
+    uint32_t ui32Preemptions;        /**< Switch-outs while still ready */
+} RUNTIME_TaskStatsType;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Runtime_Functions Runtime Accounting Functions
+ * @{
+ */
+
+/**
+ * @brief Consistent copy of a task's statistics
+ * @param ui32Tag  Application task tag (0 .. RUNTIME_MAX_TASKS-1)
+ * @param psStats  Receives the copy
+ * @return 0 on success, -1 for an out of range tag
+ */
+int32_t RUNTIME_getTaskStats(uint32_t ui32Tag, RUNTIME_TaskStatsType *psStats);
+
+/**
+ * @brief Total execution time of a task since boot
+ */
+uint64_t RUNTIME_getTotalTime(uint32_t ui32Tag);
+
+/**
+ * @brief Average job execution time (0 before the first completed job)
+ */
+uint64_t RUNTIME_getAverageExecTime(const RUNTIME_TaskStatsType *psStats);
+
+/**
+ * @brief Average job response time (0 before the first completed job)
+ */
+uint64_t RUNTIME_getAverageResponseTime(const RUNTIME_TaskStatsType *psStats);
+
+/**
+ * @brief Clears every statistic (the running task keeps being accounted)
+ */
+void RUNTIME_reset(void);
+
+/** @} */
+
+#endif /* SERVICES_RUNTIME_RUNTIME_H_ */
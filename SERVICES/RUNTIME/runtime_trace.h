@@ -0,0 +1,91 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Runtime Accounting
+ *  File        : runtime_trace.h
+ *  Description : FreeRTOS trace hook definitions feeding the runtime accounting
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_RUNTIME_RUNTIME_TRACE_H_
+#define SERVICES_RUNTIME_RUNTIME_TRACE_H_
+
+/*
+ * Include this file at the end of FreeRTOSConfig.h, which also needs:
+ *   #define configUSE_APPLICATION_TASK_TAG   1
+ *
+ * The macros expand inside tasks.c, where pxCurrentTCB and the ready lists
+ * are visible. They only use plain C types so they are safe to pull into the
+ * kernel headers (the POSIX/Linux port included).
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "SERVICES/TRACE/trace.h"
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/** @brief Hook: a task entered the ready state (job release) */
+void RUNTIME_taskReleased(uint32_t ui32Tag);
+
+/** @brief Hook: a task got the CPU */
+void RUNTIME_taskSwitchedIn(uint32_t ui32Tag);
+
+/** @brief Hook: a task lost the CPU, ui32StillReady != 0 means it was preempted */
+void RUNTIME_taskSwitchedOut(uint32_t ui32Tag, uint32_t ui32StillReady);
+
+/*------------------------------------------------------------------------------
+ *  Trace Macros
+ *----------------------------------------------------------------------------*/
+/*
+ * Kernel tasks carry no tag: the idle task is told apart by its priority and
+ * the others (the timer task) go to RUNTIME_OTHER_TAG, so their load is not
+ * mistaken for idle time. The values must match runtime.h, which this file
+ * cannot include from inside the kernel headers.
+ */
+#define RUNTIME_TRACE_IDLE_TAG              0U
+#define RUNTIME_TRACE_OTHER_TAG             9U
+
+#define RUNTIME_TCB_TAG(pxTCB)              (((pxTCB)->pxTaskTag != NULL) ? (uint32_t)(uintptr_t)((pxTCB)->pxTaskTag) : \
+                                             ((pxTCB)->uxPriority == tskIDLE_PRIORITY) ? RUNTIME_TRACE_IDLE_TAG : \
+                                             RUNTIME_TRACE_OTHER_TAG)
+
+#define RUNTIME_TCB_STILL_READY(pxTCB)      ((uint32_t)listIS_CONTAINED_WITHIN(&(pxReadyTasksLists[(pxTCB)->uxPriority]), \
+                                                                           &((pxTCB)->xStateListItem)))
+
+#define traceTASK_SWITCHED_IN()             do { \
+        RUNTIME_taskSwitchedIn(RUNTIME_TCB_TAG(pxCurrentTCB)); \
+        TRACE_HOOK(TRACE_EVENT_SWITCH_IN, RUNTIME_TCB_TAG(pxCurrentTCB), 0); \
+    } while(0)
+
+#define traceTASK_SWITCHED_OUT()            do { \
+        RUNTIME_taskSwitchedOut(RUNTIME_TCB_TAG(pxCurrentTCB), RUNTIME_TCB_STILL_READY(pxCurrentTCB)); \
+        TRACE_HOOK(TRACE_EVENT_SWITCH_OUT, RUNTIME_TCB_TAG(pxCurrentTCB), RUNTIME_TCB_STILL_READY(pxCurrentTCB)); \
+    } while(0)
+
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) do { \
+        RUNTIME_taskReleased(RUNTIME_TCB_TAG(pxTCB)); \
+        TRACE_HOOK(TRACE_EVENT_TASK_RELEASE, RUNTIME_TCB_TAG(pxTCB), 0); \
+    } while(0)
+
+/*
+ * Mutex hooks for the trace recorder, these expand inside queue.c. Mutexes are
+ * the queues without a storage area (pcHead == NULL) and the event is charged
+ * to the calling task's tag.
+ */
+#if TRACE_RECORDER_ENABLE
+#define RUNTIME_TRACE_MUTEX(pxQueue, event) do { \
+        if((pxQueue)->pcHead == NULL) \
+        { \
+            TRACE_record((event), (uint8_t)(uintptr_t)xTaskGetApplicationTaskTag(NULL), 0); \
+        } \
+    } while(0)
+
+#define traceQUEUE_RECEIVE(pxQueue)             RUNTIME_TRACE_MUTEX(pxQueue, TRACE_EVENT_MUTEX_TAKE)
+#define traceQUEUE_SEND(pxQueue)                RUNTIME_TRACE_MUTEX(pxQueue, TRACE_EVENT_MUTEX_GIVE)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) RUNTIME_TRACE_MUTEX(pxQueue, TRACE_EVENT_MUTEX_BLOCK)
+#endif
+
+#endif /* SERVICES_RUNTIME_RUNTIME_TRACE_H_ */
@@ -0,0 +1,71 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Sequence Lock
+ *  File        : seqlock.c
+ *  Description : Double-buffered sequence lock for lock-free state snapshots
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/SEQLOCK/seqlock.h"
+#include "SERVICES/COMMON/memory_barrier.h"
+#include <string.h>
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Binds a lock to its storage and publishes the initial value
+ */
+void SEQLOCK_init(SEQLOCK_Type *psLock, void *pvStorage,
+                  uint32_t ui32Size, const void *pvInitial)
+{
+    psLock->pui8Copies = (uint8_t *)pvStorage;
+    psLock->ui32Size = ui32Size;
+    psLock->ui32Sequence = 0;
+
+    memcpy(&psLock->pui8Copies[0], pvInitial, ui32Size);
+    memcpy(&psLock->pui8Copies[ui32Size], pvInitial, ui32Size);
+    MEMORY_BARRIER();
+}
+
+/**
+ * @brief Publishes a new value (single writer, never blocks)
+ */
+void SEQLOCK_write(SEQLOCK_Type *psLock, const void *pvValue)
+{
+    uint32_t ui32Sequence = psLock->ui32Sequence;
+
+    /* Odd: readers move to copy 1 while copy 0 is rewritten */
+    psLock->ui32Sequence = ui32Sequence + 1;
+    MEMORY_BARRIER();
+    memcpy(&psLock->pui8Copies[0], pvValue, psLock->ui32Size);
+
+    /* Even: readers move back to copy 0 while copy 1 is rewritten */
+    MEMORY_BARRIER();
+    psLock->ui32Sequence = ui32Sequence + 2;
+    MEMORY_BARRIER();
+    memcpy(&psLock->pui8Copies[psLock->ui32Size], pvValue, psLock->ui32Size);
+    MEMORY_BARRIER();
+}
+
+/**
+ * @brief Copies out a consistent snapshot of the last published value
+ */
+void SEQLOCK_read(const SEQLOCK_Type *psLock, void *pvValue)
+{
+    uint32_t ui32Sequence;
+
+    do
+    {
+        ui32Sequence = psLock->ui32Sequence;
+        MEMORY_BARRIER();
+        memcpy(pvValue, &psLock->pui8Copies[(ui32Sequence & 1U) * psLock->ui32Size],
+               psLock->ui32Size);
+
+        /* The copy is only valid if the writer did not switch sides meanwhile */
+        MEMORY_BARRIER();
+    } while(psLock->ui32Sequence != ui32Sequence);
+}
@@ -0,0 +1,68 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Sequence Lock
+ *  File        : seqlock.h
+ *  Description : Double-buffered sequence lock for lock-free state snapshots
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_SEQLOCK_SEQLOCK_H_
+#define SERVICES_SEQLOCK_SEQLOCK_H_
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Sequence lock descriptor
+ *
+ * The value is kept twice. The writer bumps the sequence before updating each
+ * copy, so the copy selected by the low bit of the sequence is never the one
+ * being written. A reader therefore never waits for a preempted writer: it
+ * copies the stable side and only retries if the writer moved on meanwhile.
+ * There must be a single writer per lock, readers are unlimited.
+ */
+typedef struct {
+    uint8_t *pui8Copies;            /**< 2 * value size bytes */
+    uint32_t ui32Size;              /**< Size of the protected value in bytes */
+    volatile uint32_t ui32Sequence; /**< Incremented twice per write */
+} SEQLOCK_Type;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup SEQLOCK_Functions Sequence Lock Functions
+ * @{
+ */
+
+/**
+ * @brief Binds a lock to its storage and publishes the initial value
+ * @param psLock     Lock to initialize
+ * @param pvStorage  2 * ui32Size bytes
+ * @param ui32Size   Size of the protected value in bytes
+ * @param pvInitial  Initial value, copied into both sides
+ */
+void SEQLOCK_init(SEQLOCK_Type *psLock, void *pvStorage,
+                  uint32_t ui32Size, const void *pvInitial);
+
+/**
+ * @brief Publishes a new value (single writer, never blocks)
+ */
+void SEQLOCK_write(SEQLOCK_Type *psLock, const void *pvValue);
+
+/**
+ * @brief Copies out a consistent snapshot of the last published value
+ *
+ * Never blocks. Retries only when a write completed during the copy.
+ */
+void SEQLOCK_read(const SEQLOCK_Type *psLock, void *pvValue);
+
+/** @} */
+
+#endif /* SERVICES_SEQLOCK_SEQLOCK_H_ */
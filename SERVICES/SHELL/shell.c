@@ -0,0 +1,224 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Shell
+ *  File        : shell.c
+ *  Description : Allocation-free command line parser for the diagnostics link
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/SHELL/shell.h"
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define SHELL_CHAR_BACKSPACE    ('\b')
+#define SHELL_CHAR_DELETE       ('\x7F')
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static uint8_t prvIsSeparator(char cChar)
+{
+    return (cChar == ' ') || (cChar == '\t');
+}
+
+static char prvToLower(char cChar)
+{
+    return ((cChar >= 'A') && (cChar <= 'Z')) ? (char)(cChar - 'A' + 'a') : cChar;
+}
+
+static uint8_t prvNamesEqual(const char *pcA, const char *pcB)
+{
+    while((*pcA != '\0') && (prvToLower(*pcA) == prvToLower(*pcB))) {
+        pcA++;
+        pcB++;
+    }
+    return (*pcA == '\0') && (*pcB == '\0');
+}
+
+static void prvPrintUsage(const SHELL_Type *psShell, const SHELL_CommandType *pxCommand)
+{
+    SHELL_print(psShell, pxCommand->pcName);
+    if(pxCommand->pcUsage[0] != '\0') {
+        SHELL_print(psShell, " ");
+        SHELL_print(psShell, pxCommand->pcUsage);
+    }
+    SHELL_print(psShell, "\r\n");
+}
+
+static void prvHelp(const SHELL_Type *psShell)
+{
+    uint8_t ui8Index;
+
+    SHELL_print(psShell, "help\r\n");
+    for(ui8Index = 0; ui8Index < psShell->ui8CommandCount; ui8Index++) {
+        prvPrintUsage(psShell, &psShell->pxCommands[ui8Index]);
+    }
+}
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Binds a shell to its command table and output, "help" is built in
+ */
+void SHELL_init(SHELL_Type *psShell, const SHELL_CommandType *pxCommands, uint8_t ui8CommandCount,
+                SHELL_WriteType pfWrite)
+{
+    psShell->pxCommands = pxCommands;
+    psShell->ui8CommandCount = ui8CommandCount;
+    psShell->pfWrite = pfWrite;
+    psShell->ui8Length = 0;
+    psShell->ui8Overflow = 0;
+}
+
+/**
+ * @brief Feeds received bytes, runs every line they complete
+ */
+void SHELL_input(SHELL_Type *psShell, const uint8_t *pui8Data, uint32_t ui32Length)
+{
+    while(ui32Length-- != 0U) {
+        char cChar = (char)*pui8Data++;
+
+        if((cChar == '\r') || (cChar == '\n')) {
+            // CR LF ends a line and leaves an empty one, which is skipped
+            if(psShell->ui8Overflow) {
+                SHELL_print(psShell, "error: line too long\r\n");
+            } else if(psShell->ui8Length != 0U) {
+                psShell->acLine[psShell->ui8Length] = '\0';
+                SHELL_execute(psShell, psShell->acLine);
+            }
+            psShell->ui8Length = 0;
+            psShell->ui8Overflow = 0;
+        } else if((cChar == SHELL_CHAR_BACKSPACE) || (cChar == SHELL_CHAR_DELETE)) {
+            if(psShell->ui8Length != 0U) {
+                psShell->ui8Length--;
+            }
+        } else if((cChar < ' ') || (cChar > '~')) {
+            // Other control and non-ASCII bytes, line noise
+        } else if(psShell->ui8Length < SHELL_LINE_MAX_LENGTH) {
+            psShell->acLine[psShell->ui8Length++] = cChar;
+        } else {
+            psShell->ui8Overflow = 1;
+        }
+    }
+}
+
+/**
+ * @brief Runs one line, modified in place
+ */
+void SHELL_execute(SHELL_Type *psShell, char *pcLine)
+{
+    char *apcArgv[SHELL_MAX_ARGS];
+    uint8_t ui8Argc = SHELL_tokenize(pcLine, apcArgv, SHELL_MAX_ARGS);
+    uint8_t ui8Index;
+
+    if(ui8Argc == 0U) {
+        return;
+    }
+    if(ui8Argc > SHELL_MAX_ARGS) {
+        SHELL_print(psShell, "error: too many arguments\r\n");
+        return;
+    }
+    if(prvNamesEqual(apcArgv[0], "help")) {
+        prvHelp(psShell);
+        return;
+    }
+
+    for(ui8Index = 0; ui8Index < psShell->ui8CommandCount; ui8Index++) {
+        const SHELL_CommandType *pxCommand = &psShell->pxCommands[ui8Index];
+
+        if(!prvNamesEqual(apcArgv[0], pxCommand->pcName)) {
+            continue;
+        }
+        if(((ui8Argc - 1U) >= pxCommand->ui8MinArgs) && ((ui8Argc - 1U) <= pxCommand->ui8MaxArgs) &&
+           (pxCommand->pfHandler(ui8Argc, apcArgv) == SHELL_OK)) {
+            SHELL_print(psShell, "ok\r\n");
+        } else {
+            SHELL_print(psShell, "usage: ");
+            prvPrintUsage(psShell, pxCommand);
+        }
+        return;
+    }
+
+    SHELL_print(psShell, "error: unknown command, try help\r\n");
+}
+
+/**
+ * @brief Splits a line into words in place, separated by spaces or tabs
+ */
+uint8_t SHELL_tokenize(char *pcLine, char **apcArgv, uint8_t ui8MaxArgs)
+{
+    uint8_t ui8Argc = 0;
+
+    for(;;) {
+        while(prvIsSeparator(*pcLine)) {
+            *pcLine++ = '\0';
+        }
+        if(*pcLine == '\0') {
+            return ui8Argc;
+        }
+        if(ui8Argc == ui8MaxArgs) {
+            return ui8MaxArgs + 1U;
+        }
+        apcArgv[ui8Argc++] = pcLine;
+        while((*pcLine != '\0') && !prvIsSeparator(*pcLine)) {
+            pcLine++;
+        }
+    }
+}
+
+/**
+ * @brief Parses a decimal number without sign, at most 0xFFFFFFFF
+ */
+uint8_t SHELL_parseUnsigned(const char *pcWord, uint32_t *pui32Value)
+{
+    uint32_t ui32Value = 0;
+
+    if(*pcWord == '\0') {
+        return 0;
+    }
+    for(; *pcWord != '\0'; pcWord++) {
+        uint32_t ui32Digit = (uint32_t)(*pcWord - '0');
+
+        if((ui32Digit > 9U) || (ui32Value > ((0xFFFFFFFFUL - ui32Digit) / 10U))) {
+            return 0;
+        }
+        ui32Value = (ui32Value * 10U) + ui32Digit;
+    }
+
+    *pui32Value = ui32Value;
+    return 1;
+}
+
+/**
+ * @brief Looks a word up in a name table, ignoring ASCII case
+ */
+uint8_t SHELL_findName(const char *pcWord, const char * const *apcNames, uint8_t ui8Count)
+{
+    uint8_t ui8Index;
+
+    for(ui8Index = 0; ui8Index < ui8Count; ui8Index++) {
+        if(prvNamesEqual(pcWord, apcNames[ui8Index])) {
+            break;
+        }
+    }
+    return ui8Index;
+}
+
+/**
+ * @brief Writes a NUL terminated string through the shell's output
+ */
+void SHELL_print(const SHELL_Type *psShell, const char *pcText)
+{
+    uint32_t ui32Length = 0;
+
+    while(pcText[ui32Length] != '\0') {
+        ui32Length++;
+    }
+    psShell->pfWrite(pcText, ui32Length);
+}
@@ -0,0 +1,133 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Shell
+ *  File        : shell.h
+ *  Description : Allocation-free command line parser for the diagnostics link
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_SHELL_SHELL_H_
+#define SERVICES_SHELL_SHELL_H_
+
+/*
+ * Bytes are fed in as they arrive; a CR or LF ends the line, which is split
+ * into words in place and dispatched to the matching entry of the command
+ * table. Backspace and DEL erase the last character, other control
+ * characters are ignored, and a line longer than SHELL_LINE_MAX_LENGTH is
+ * discarded as a whole. All state lives in the SHELL_Type object, nothing
+ * is allocated. Every line gets one reply through the write function: the
+ * handler's own output, then "ok" or an error.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Shell_Configuration Shell settings
+ * @{
+ */
+#define SHELL_LINE_MAX_LENGTH    48    /**< Characters per line, terminator excluded */
+#define SHELL_MAX_ARGS           4     /**< Words per line, command name included */
+/** @} */
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Outcome of a command handler
+ */
+typedef enum {
+    SHELL_OK,                   /**< Done, the shell replies "ok" */
+    SHELL_BAD_ARGUMENTS         /**< Rejected, the shell replies with the command's usage */
+} SHELL_ResultType;
+
+/**
+ * @brief Command handler: apcArgv[0] is the command name, the words are NUL terminated
+ */
+typedef SHELL_ResultType (*SHELL_HandlerType)(uint8_t ui8Argc, char * const *apcArgv);
+
+/**
+ * @brief Output sink for the replies
+ */
+typedef void (*SHELL_WriteType)(const char *pcText, uint32_t ui32Length);
+
+/**
+ * @brief One command table entry, the argument counts exclude the command name
+ */
+typedef struct {
+    const char *pcName;
+    const char *pcUsage;                /**< Arguments, shown by "help" and on SHELL_BAD_ARGUMENTS */
+    uint8_t ui8MinArgs;
+    uint8_t ui8MaxArgs;
+    SHELL_HandlerType pfHandler;
+} SHELL_CommandType;
+
+/**
+ * @brief Shell instance: command table, output and the line being received
+ */
+typedef struct {
+    const SHELL_CommandType *pxCommands;
+    uint8_t ui8CommandCount;
+    SHELL_WriteType pfWrite;
+    char acLine[SHELL_LINE_MAX_LENGTH + 1];
+    uint8_t ui8Length;
+    uint8_t ui8Overflow;                /**< Line too long, discarded at its end */
+} SHELL_Type;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup SHELL_Functions Shell Functions
+ * @{
+ */
+
+/**
+ * @brief Binds a shell to its command table and output, "help" is built in
+ */
+void SHELL_init(SHELL_Type *psShell, const SHELL_CommandType *pxCommands, uint8_t ui8CommandCount,
+                SHELL_WriteType pfWrite);
+
+/**
+ * @brief Feeds received bytes, runs every line they complete
+ */
+void SHELL_input(SHELL_Type *psShell, const uint8_t *pui8Data, uint32_t ui32Length);
+
+/**
+ * @brief Runs one line, modified in place
+ */
+void SHELL_execute(SHELL_Type *psShell, char *pcLine);
+
+/**
+ * @brief Splits a line into words in place, separated by spaces or tabs
+ * @return Number of words, ui8MaxArgs + 1 if there are more than ui8MaxArgs
+ */
+uint8_t SHELL_tokenize(char *pcLine, char **apcArgv, uint8_t ui8MaxArgs);
+
+/**
+ * @brief Parses a decimal number without sign, at most 0xFFFFFFFF
+ * @return 1 if the whole word is a number
+ */
+uint8_t SHELL_parseUnsigned(const char *pcWord, uint32_t *pui32Value);
+
+/**
+ * @brief Looks a word up in a name table, ignoring ASCII case
+ * @return Index of the name, ui8Count if it is not there
+ */
+uint8_t SHELL_findName(const char *pcWord, const char * const *apcNames, uint8_t ui8Count);
+
+/**
+ * @brief Writes a NUL terminated string through the shell's output
+ */
+void SHELL_print(const SHELL_Type *psShell, const char *pcText);
+
+/** @} */
+
+#endif /* SERVICES_SHELL_SHELL_H_ */
@@ -0,0 +1,83 @@
+/*------------------------------------------------------------------------------
+ *  Module      : SPSC Ring Buffer
+ *  File        : spsc_ring.c
+ *  Description : Lock-free single-producer/single-consumer ring buffer
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/SPSC_RING/spsc_ring.h"
+#include "SERVICES/COMMON/memory_barrier.h"
+#include <string.h>
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Binds a ring descriptor to its storage
+ */
+void SPSC_init(SPSC_RingType *psRing, void *pvStorage,
+               uint32_t ui32ElementSize, uint32_t ui32Capacity)
+{
+    psRing->pui8Storage = (uint8_t *)pvStorage;
+    psRing->ui32ElementSize = ui32ElementSize;
+    psRing->ui32Capacity = ui32Capacity;
+    psRing->ui32Head = 0;
+    psRing->ui32Tail = 0;
+}
+
+/**
+ * @brief Copies one element in (producer side)
+ */
+bool SPSC_push(SPSC_RingType *psRing, const void *pvElement)
+{
+    uint32_t ui32Head = psRing->ui32Head;
+
+    if((ui32Head - psRing->ui32Tail) >= psRing->ui32Capacity)
+    {
+        return false;
+    }
+
+    memcpy(&psRing->pui8Storage[(ui32Head & (psRing->ui32Capacity - 1)) * psRing->ui32ElementSize],
+           pvElement, psRing->ui32ElementSize);
+
+    /* The element must be visible before the consumer can see the new head */
+    MEMORY_BARRIER();
+    psRing->ui32Head = ui32Head + 1;
+    return true;
+}
+
+/**
+ * @brief Copies the oldest element out (consumer side)
+ */
+bool SPSC_pop(SPSC_RingType *psRing, void *pvElement)
+{
+    uint32_t ui32Tail = psRing->ui32Tail;
+
+    if(ui32Tail == psRing->ui32Head)
+    {
+        return false;
+    }
+
+    /* Do not read the slot before the head that published it */
+    MEMORY_BARRIER();
+    memcpy(pvElement,
+           &psRing->pui8Storage[(ui32Tail & (psRing->ui32Capacity - 1)) * psRing->ui32ElementSize],
+           psRing->ui32ElementSize);
+
+    /* The slot must be fully read before the producer may reuse it */
+    MEMORY_BARRIER();
+    psRing->ui32Tail = ui32Tail + 1;
+    return true;
+}
+
+/**
+ * @brief Number of elements currently stored
+ */
+uint32_t SPSC_getCount(const SPSC_RingType *psRing)
+{
+    return psRing->ui32Head - psRing->ui32Tail;
+}
@@ -0,0 +1,75 @@
+/*------------------------------------------------------------------------------
+ *  Module      : SPSC Ring Buffer
+ *  File        : spsc_ring.h
+ *  Description : Lock-free single-producer/single-consumer ring buffer
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_SPSC_RING_SPSC_RING_H_
+#define SERVICES_SPSC_RING_SPSC_RING_H_
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Ring descriptor
+ *
+ * The indices run freely and are masked on access, so the whole capacity is
+ * usable. Only the producer writes ui32Head and only the consumer writes
+ * ui32Tail, which is what makes the ring safe without a lock (e.g. an ISR
+ * producing and one task consuming).
+ */
+typedef struct {
+    uint8_t *pui8Storage;           /**< Capacity * element size bytes */
+    uint32_t ui32ElementSize;       /**< Size of one element in bytes */
+    uint32_t ui32Capacity;          /**< Number of elements, power of 2 */
+    volatile uint32_t ui32Head;     /**< Next slot to write (producer) */
+    volatile uint32_t ui32Tail;     /**< Next slot to read (consumer) */
+} SPSC_RingType;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup SPSC_Functions SPSC Ring Functions
+ * @{
+ */
+
+/**
+ * @brief Binds a ring descriptor to its storage
+ * @param psRing          Ring to initialize
+ * @param pvStorage       ui32Capacity * ui32ElementSize bytes
+ * @param ui32ElementSize Size of one element in bytes
+ * @param ui32Capacity    Number of elements, must be a power of 2
+ */
+void SPSC_init(SPSC_RingType *psRing, void *pvStorage,
+               uint32_t ui32ElementSize, uint32_t ui32Capacity);
+
+/**
+ * @brief Copies one element in (producer side)
+ * @return false if the ring is full, the element is then dropped
+ */
+bool SPSC_push(SPSC_RingType *psRing, const void *pvElement);
+
+/**
+ * @brief Copies the oldest element out (consumer side)
+ * @return false if the ring is empty
+ */
+bool SPSC_pop(SPSC_RingType *psRing, void *pvElement);
+
+/**
+ * @brief Number of elements currently stored (approximate from the other side)
+ */
+uint32_t SPSC_getCount(const SPSC_RingType *psRing);
+
+/** @} */
+
+#endif /* SERVICES_SPSC_RING_SPSC_RING_H_ */
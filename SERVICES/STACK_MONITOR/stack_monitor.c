@@ -0,0 +1,102 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Stack Monitor
+ *  File        : stack_monitor.c
+ *  Description : Per-task stack headroom tracking against a budget
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/STACK_MONITOR/stack_monitor.h"
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+typedef struct {
+    TaskHandle_t xTask;              /* NULL: slot not in use */
+    uint32_t ui32BudgetWords;
+    uint32_t ui32HeadroomWords;
+    uint8_t ui8OverBudget;           /* Already reported */
+} StackMonitorEntryType;
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+
+/* Written by the registering code before the scheduler starts, then by the sampling task only,
+   except for the task handle a task clears before deleting itself */
+static StackMonitorEntryType axEntries[STACK_MONITOR_MAX_TASKS];
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Adds a task to the monitor
+ */
+void STACK_MONITOR_register(uint32_t ui32Tag, TaskHandle_t xTask, uint32_t ui32BudgetWords)
+{
+    if(ui32Tag >= STACK_MONITOR_MAX_TASKS) {
+        return;
+    }
+
+    axEntries[ui32Tag].xTask = xTask;
+    axEntries[ui32Tag].ui32BudgetWords = ui32BudgetWords;
+    axEntries[ui32Tag].ui32HeadroomWords = UINT32_MAX;
+    axEntries[ui32Tag].ui8OverBudget = 0;
+}
+
+/**
+ * @brief Stops sampling a task, before it is deleted
+ */
+void STACK_MONITOR_unregister(uint32_t ui32Tag)
+{
+    if(ui32Tag >= STACK_MONITOR_MAX_TASKS) {
+        return;
+    }
+
+    /* A single store: the sampler sees either the live task or no task, and the last headroom stays readable */
+    axEntries[ui32Tag].xTask = NULL;
+}
+
+/**
+ * @brief Samples the high water mark of every registered task
+ */
+uint32_t STACK_MONITOR_sample(void)
+{
+    uint32_t ui32NewlyOver = 0;
+    uint32_t ui32Tag;
+
+    for(ui32Tag = 0; ui32Tag < STACK_MONITOR_MAX_TASKS; ui32Tag++) {
+        StackMonitorEntryType *pxEntry = &axEntries[ui32Tag];
+
+        if(pxEntry->xTask == NULL) {
+            continue;
+        }
+
+        pxEntry->ui32HeadroomWords = (uint32_t)uxTaskGetStackHighWaterMark(pxEntry->xTask);
+        if((pxEntry->ui32HeadroomWords < pxEntry->ui32BudgetWords) && (pxEntry->ui8OverBudget == 0U)) {
+            pxEntry->ui8OverBudget = 1;
+            ui32NewlyOver |= (1UL << ui32Tag);
+        }
+    }
+
+    return ui32NewlyOver;
+}
+
+/**
+ * @brief Headroom at the last sample, in stack words
+ */
+uint32_t STACK_MONITOR_getHeadroom(uint32_t ui32Tag)
+{
+    return (ui32Tag < STACK_MONITOR_MAX_TASKS) ? axEntries[ui32Tag].ui32HeadroomWords : 0U;
+}
+
+/**
+ * @brief Budget the task was registered with, in stack words
+ */
+uint32_t STACK_MONITOR_getBudget(uint32_t ui32Tag)
+{
+    return (ui32Tag < STACK_MONITOR_MAX_TASKS) ? axEntries[ui32Tag].ui32BudgetWords : 0U;
+}
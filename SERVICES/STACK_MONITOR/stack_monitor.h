@@ -0,0 +1,88 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Stack Monitor
+ *  File        : stack_monitor.h
+ *  Description : Per-task stack headroom tracking against a budget
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_STACK_MONITOR_STACK_MONITOR_H_
+#define SERVICES_STACK_MONITOR_STACK_MONITOR_H_
+
+/*
+ * Needs INCLUDE_uxTaskGetStackHighWaterMark set to 1 in FreeRTOSConfig.h.
+ *
+ * Headroom is the stack high water mark: the fewest words that were ever
+ * left unused, as found by the kernel's scan for the fill pattern. A task
+ * whose headroom drops below its budget is reported once; the budget is the
+ * margin to keep when stack depths are shrunk from measured headroom.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Stack_Monitor_Configuration Stack monitor settings
+ * @{
+ */
+#define STACK_MONITOR_MAX_TASKS    10    /**< Table size, indexed by the application task tag */
+/** @} */
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup STACK_MONITOR_Functions Stack Monitor Functions
+ * @{
+ */
+
+/**
+ * @brief Adds a task to the monitor
+ * @param ui32Tag          Slot, the task's application tag
+ * @param xTask            Task to sample
+ * @param ui32BudgetWords  Smallest acceptable headroom in stack words
+ */
+void STACK_MONITOR_register(uint32_t ui32Tag, TaskHandle_t xTask, uint32_t ui32BudgetWords);
+
+/**
+ * @brief Stops sampling a task
+ *
+ * Must be called before the task is deleted: once the idle task has freed the
+ * TCB and the stack, sampling the handle would read freed memory. The last
+ * headroom and the budget stay available.
+ *
+ * @param ui32Tag  Slot the task was registered in
+ */
+void STACK_MONITOR_unregister(uint32_t ui32Tag);
+
+/**
+ * @brief Samples the high water mark of every registered task
+ *
+ * Called periodically by a single task. Walks each stack from its end, so
+ * the cost grows with the unused part of the stacks.
+ *
+ * @return Bit mask of the tags that dropped below their budget since the last call
+ */
+uint32_t STACK_MONITOR_sample(void);
+
+/**
+ * @brief Headroom at the last sample, in stack words
+ */
+uint32_t STACK_MONITOR_getHeadroom(uint32_t ui32Tag);
+
+/**
+ * @brief Budget the task was registered with, in stack words
+ */
+uint32_t STACK_MONITOR_getBudget(uint32_t ui32Tag);
+
+/** @} */
+
+#endif /* SERVICES_STACK_MONITOR_STACK_MONITOR_H_ */
@@ -0,0 +1,185 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Status Frame
+ *  File        : status_frame.c
+ *  Description : Precomputed text frame with fixed-width fields, rewritten in place
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/STATUS_FRAME/status_frame.h"
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+
+/* Slot value that no real value renders to, forces the first update */
+#define STATUS_FRAME_UNRENDERED    (0xFFFFFFFFU)
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+
+/* "00".."99": two digits per division by 100 instead of one per division by 10 */
+static const char acDigitPairs[200] = {
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Writes the decimal digits of a number ending just before pui8End
+ * @return Number of digits written
+ */
+static uint8_t prvRenderDigits(uint8_t *pui8End, uint32_t ui32Number)
+{
+    uint8_t *pui8Digit = pui8End;
+
+    while(ui32Number >= 100U) {
+        uint32_t ui32Pair = (ui32Number % 100U) * 2U;
+
+        ui32Number /= 100U;
+        *--pui8Digit = (uint8_t)acDigitPairs[ui32Pair + 1U];
+        *--pui8Digit = (uint8_t)acDigitPairs[ui32Pair];
+    }
+    if(ui32Number >= 10U) {
+        *--pui8Digit = (uint8_t)acDigitPairs[(ui32Number * 2U) + 1U];
+        *--pui8Digit = (uint8_t)acDigitPairs[ui32Number * 2U];
+    } else {
+        *--pui8Digit = (uint8_t)('0' + ui32Number);
+    }
+
+    return (uint8_t)(pui8End - pui8Digit);
+}
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Binds an empty frame to its buffer
+ */
+void STATUS_FRAME_init(STATUS_FRAME_Type *psFrame, uint8_t *pui8Buffer, uint32_t ui32Capacity)
+{
+    psFrame->pui8Buffer = pui8Buffer;
+    psFrame->ui32Capacity = ui32Capacity;
+    psFrame->ui32Length = 0;
+}
+
+/**
+ * @brief Layout: appends constant text, truncated at the buffer end
+ */
+void STATUS_FRAME_appendText(STATUS_FRAME_Type *psFrame, const char *pcText)
+{
+    while((*pcText != '\0') && (psFrame->ui32Length < psFrame->ui32Capacity)) {
+        psFrame->pui8Buffer[psFrame->ui32Length++] = (uint8_t)*pcText++;
+    }
+}
+
+/**
+ * @brief Layout: appends a constant unsigned decimal number
+ */
+void STATUS_FRAME_appendNumber(STATUS_FRAME_Type *psFrame, uint32_t ui32Number)
+{
+    uint8_t aui8Digits[10];
+    uint8_t ui8Count = prvRenderDigits(&aui8Digits[sizeof(aui8Digits)], ui32Number);
+    uint8_t ui8Index;
+
+    for(ui8Index = sizeof(aui8Digits) - ui8Count;
+        (ui8Index < sizeof(aui8Digits)) && (psFrame->ui32Length < psFrame->ui32Capacity);
+        ui8Index++) {
+        psFrame->pui8Buffer[psFrame->ui32Length++] = aui8Digits[ui8Index];
+    }
+}
+
+/**
+ * @brief Layout: reserves a blank slot of ui8Width characters for a variable value
+ */
+void STATUS_FRAME_appendField(STATUS_FRAME_Type *psFrame, STATUS_FRAME_FieldType *psField,
+                              uint8_t ui8Width)
+{
+    psField->ui16Offset = (uint16_t)psFrame->ui32Length;
+    psField->ui32Value = STATUS_FRAME_UNRENDERED;
+
+    if((psFrame->ui32Capacity - psFrame->ui32Length) < ui8Width) {
+        psField->ui8Width = 0;
+        return;
+    }
+
+    psField->ui8Width = ui8Width;
+    while(ui8Width-- != 0U) {
+        psFrame->pui8Buffer[psFrame->ui32Length++] = ' ';
+    }
+}
+
+/**
+ * @brief Renders a number right-aligned in its slot, only if it changed
+ */
+void STATUS_FRAME_setNumber(STATUS_FRAME_Type *psFrame, STATUS_FRAME_FieldType *psField,
+                            uint32_t ui32Number)
+{
+    uint8_t aui8Digits[10];
+    uint8_t *pui8Slot;
+    uint8_t ui8Count;
+    uint8_t ui8Index;
+
+    if(ui32Number == psField->ui32Value) {
+        return;
+    }
+    psField->ui32Value = ui32Number;
+
+    pui8Slot = &psFrame->pui8Buffer[psField->ui16Offset];
+    ui8Count = prvRenderDigits(&aui8Digits[sizeof(aui8Digits)], ui32Number);
+
+    if(ui8Count > psField->ui8Width) {
+        for(ui8Index = 0; ui8Index < psField->ui8Width; ui8Index++) {
+            pui8Slot[ui8Index] = '*';
+        }
+        return;
+    }
+
+    for(ui8Index = 0; ui8Index < (psField->ui8Width - ui8Count); ui8Index++) {
+        pui8Slot[ui8Index] = ' ';
+    }
+    for(; ui8Index < psField->ui8Width; ui8Index++) {
+        pui8Slot[ui8Index] = aui8Digits[(sizeof(aui8Digits) - psField->ui8Width) + ui8Index];
+    }
+}
+
+/**
+ * @brief Renders apcNames[ui32Index] left-aligned in its slot, only if the index changed
+ */
+void STATUS_FRAME_setName(STATUS_FRAME_Type *psFrame, STATUS_FRAME_FieldType *psField,
+                          const char * const *apcNames, uint32_t ui32Index)
+{
+    const char *pcName;
+    uint8_t *pui8Slot;
+    uint8_t ui8Index;
+
+    if(ui32Index == psField->ui32Value) {
+        return;
+    }
+    psField->ui32Value = ui32Index;
+
+    pcName = apcNames[ui32Index];
+    pui8Slot = &psFrame->pui8Buffer[psField->ui16Offset];
+
+    for(ui8Index = 0; (ui8Index < psField->ui8Width) && (pcName[ui8Index] != '\0'); ui8Index++) {
+        pui8Slot[ui8Index] = (uint8_t)pcName[ui8Index];
+    }
+    for(; ui8Index < psField->ui8Width; ui8Index++) {
+        pui8Slot[ui8Index] = ' ';
+    }
+}
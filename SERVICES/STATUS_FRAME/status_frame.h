@@ -0,0 +1,101 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Status Frame
+ *  File        : status_frame.h
+ *  Description : Precomputed text frame with fixed-width fields, rewritten in place
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_STATUS_FRAME_STATUS_FRAME_H_
+#define SERVICES_STATUS_FRAME_STATUS_FRAME_H_
+
+/*
+ * The frame is laid out once: constant text is copied into the buffer and
+ * every variable value gets a slot of fixed width. Afterwards a report only
+ * touches the slots whose value differs from the one already rendered, and
+ * the frame length never changes, so the whole buffer goes out in one
+ * transmit call. Numbers are converted with 32-bit arithmetic and a digit
+ * pair table, names come from caller lookup tables. No allocation.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Frame descriptor, bound to caller storage
+ */
+typedef struct {
+    uint8_t *pui8Buffer;            /**< Rendered frame */
+    uint32_t ui32Capacity;          /**< Buffer size in bytes */
+    uint32_t ui32Length;            /**< Frame length, fixed once the layout is done */
+} STATUS_FRAME_Type;
+
+/**
+ * @brief Slot of one variable value inside the frame
+ */
+typedef struct {
+    uint16_t ui16Offset;            /**< First byte of the slot in the buffer */
+    uint8_t ui8Width;               /**< Slot width, 0 if the layout ran out of room */
+    uint32_t ui32Value;             /**< Value currently rendered in the slot */
+} STATUS_FRAME_FieldType;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup STATUS_FRAME_Functions Status Frame Functions
+ * @{
+ */
+
+/**
+ * @brief Binds an empty frame to its buffer
+ * @param psFrame       Frame to initialize
+ * @param pui8Buffer    Frame storage
+ * @param ui32Capacity  Buffer size in bytes
+ */
+void STATUS_FRAME_init(STATUS_FRAME_Type *psFrame, uint8_t *pui8Buffer, uint32_t ui32Capacity);
+
+/**
+ * @brief Layout: appends constant text, truncated at the buffer end
+ */
+void STATUS_FRAME_appendText(STATUS_FRAME_Type *psFrame, const char *pcText);
+
+/**
+ * @brief Layout: appends a constant unsigned decimal number
+ */
+void STATUS_FRAME_appendNumber(STATUS_FRAME_Type *psFrame, uint32_t ui32Number);
+
+/**
+ * @brief Layout: reserves a blank slot of ui8Width characters for a variable value
+ *
+ * A slot that does not fit in the buffer gets width 0 and is never written.
+ * The first set call always renders, whatever the value.
+ */
+void STATUS_FRAME_appendField(STATUS_FRAME_Type *psFrame, STATUS_FRAME_FieldType *psField,
+                              uint8_t ui8Width);
+
+/**
+ * @brief Renders a number right-aligned in its slot, only if it changed
+ *
+ * A number wider than the slot is shown as '*' characters.
+ */
+void STATUS_FRAME_setNumber(STATUS_FRAME_Type *psFrame, STATUS_FRAME_FieldType *psField,
+                            uint32_t ui32Number);
+
+/**
+ * @brief Renders apcNames[ui32Index] left-aligned in its slot, only if the index changed
+ *
+ * The name is truncated or padded with spaces to the slot width.
+ */
+void STATUS_FRAME_setName(STATUS_FRAME_Type *psFrame, STATUS_FRAME_FieldType *psField,
+                          const char * const *apcNames, uint32_t ui32Index);
+
+/** @} */
+
+#endif /* SERVICES_STATUS_FRAME_STATUS_FRAME_H_ */
@@ -0,0 +1,111 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Telemetry
+ *  File        : telemetry.c
+ *  Description : Binary telemetry records, CRC-16 protected and COBS framed,
+ *                see tools/telemetry_decode.py
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/TELEMETRY/telemetry.h"
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+
+/* CRC-16/CCITT-FALSE (poly 0x1021) per nibble: 32 bytes of table instead of 512 */
+static const uint16_t aui16CrcNibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static uint16_t prvCrc16(const uint8_t *pui8Data, uint32_t ui32Length)
+{
+    uint16_t ui16Crc = 0xFFFF;
+
+    while(ui32Length-- != 0U) {
+        ui16Crc = (uint16_t)((ui16Crc << 4) ^ aui16CrcNibble[(ui16Crc >> 12) ^ (*pui8Data >> 4)]);
+        ui16Crc = (uint16_t)((ui16Crc << 4) ^ aui16CrcNibble[(ui16Crc >> 12) ^ (*pui8Data & 0x0FU)]);
+        pui8Data++;
+    }
+    return ui16Crc;
+}
+
+static void prvPutByte(TELEMETRY_WriterType *psWriter, uint8_t ui8Value)
+{
+    if(psWriter->ui8Length < (TELEMETRY_HEADER_SIZE + TELEMETRY_PAYLOAD_MAX_SIZE)) {
+        psWriter->aui8Record[psWriter->ui8Length++] = ui8Value;
+    }
+}
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Starts a record: writes the header with the next sequence number
+ */
+void TELEMETRY_begin(TELEMETRY_WriterType *psWriter, TELEMETRY_RecordType eType, uint16_t ui16TimeMs)
+{
+    psWriter->ui8Length = 0;
+    prvPutByte(psWriter, (uint8_t)eType);
+    prvPutByte(psWriter, psWriter->ui8Sequence++);
+    prvPutByte(psWriter, (uint8_t)ui16TimeMs);
+    prvPutByte(psWriter, (uint8_t)(ui16TimeMs >> 8));
+}
+
+void TELEMETRY_putU8(TELEMETRY_WriterType *psWriter, uint8_t ui8Value)
+{
+    prvPutByte(psWriter, ui8Value);
+}
+
+void TELEMETRY_putU16(TELEMETRY_WriterType *psWriter, uint32_t ui32Value)
+{
+    if(ui32Value > 0xFFFFU) {
+        ui32Value = 0xFFFFU;
+    }
+    prvPutByte(psWriter, (uint8_t)ui32Value);
+    prvPutByte(psWriter, (uint8_t)(ui32Value >> 8));
+}
+
+void TELEMETRY_putU32(TELEMETRY_WriterType *psWriter, uint32_t ui32Value)
+{
+    prvPutByte(psWriter, (uint8_t)ui32Value);
+    prvPutByte(psWriter, (uint8_t)(ui32Value >> 8));
+    prvPutByte(psWriter, (uint8_t)(ui32Value >> 16));
+    prvPutByte(psWriter, (uint8_t)(ui32Value >> 24));
+}
+
+/**
+ * @brief Closes the record: appends the CRC and COBS encodes it into aui8Frame
+ */
+uint32_t TELEMETRY_end(TELEMETRY_WriterType *psWriter)
+{
+    uint16_t ui16Crc = prvCrc16(psWriter->aui8Record, psWriter->ui8Length);
+    uint32_t ui32Code = 0;          /* Position of the current code byte */
+    uint32_t ui32Out = 1;
+    uint32_t ui32In;
+
+    psWriter->aui8Record[psWriter->ui8Length++] = (uint8_t)ui16Crc;
+    psWriter->aui8Record[psWriter->ui8Length++] = (uint8_t)(ui16Crc >> 8);
+
+    /* COBS: each code byte holds the distance to the next zero, records are shorter than 254 bytes */
+    for(ui32In = 0; ui32In < psWriter->ui8Length; ui32In++) {
+        if(psWriter->aui8Record[ui32In] == 0U) {
+            psWriter->aui8Frame[ui32Code] = (uint8_t)(ui32Out - ui32Code);
+            ui32Code = ui32Out++;
+        } else {
+            psWriter->aui8Frame[ui32Out++] = psWriter->aui8Record[ui32In];
+        }
+    }
+    psWriter->aui8Frame[ui32Code] = (uint8_t)(ui32Out - ui32Code);
+    psWriter->aui8Frame[ui32Out++] = 0U;
+
+    return ui32Out;
+}
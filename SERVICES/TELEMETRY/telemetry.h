@@ -0,0 +1,115 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Telemetry
+ *  File        : telemetry.h
+ *  Description : Binary telemetry records, CRC-16 protected and COBS framed,
+ *                see tools/telemetry_decode.py
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_TELEMETRY_TELEMETRY_H_
+#define SERVICES_TELEMETRY_TELEMETRY_H_
+
+/*
+ * Build with -DTELEMETRY_BINARY_ENABLE=1 to replace the text reports on UART0
+ * with binary records. A record is built in a writer:
+ *
+ *   type u8 | sequence u8 | time ms u16 | payload | CRC-16/CCITT-FALSE u16
+ *
+ * all fields little endian, the CRC over everything before it. The writer
+ * then COBS encodes the record and appends a 0x00 delimiter, so a receiver
+ * resynchronizes on the next zero byte after a dropped or corrupted byte.
+ * The sequence counts every record of the writer, a gap means records were
+ * lost; the time is the low 16 bits of the tick count in ms.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Telemetry_Configuration Telemetry settings
+ * @{
+ */
+#ifndef TELEMETRY_BINARY_ENABLE
+#define TELEMETRY_BINARY_ENABLE      0
+#endif
+#define TELEMETRY_PAYLOAD_MAX_SIZE   24    /**< Largest record payload in bytes */
+#define TELEMETRY_FORMAT_VERSION     3     /**< Bumped when a record layout changes */
+/** @} */
+
+#define TELEMETRY_HEADER_SIZE        4
+#define TELEMETRY_CRC_SIZE           2
+#define TELEMETRY_RECORD_MAX_SIZE    (TELEMETRY_HEADER_SIZE + TELEMETRY_PAYLOAD_MAX_SIZE + TELEMETRY_CRC_SIZE)
+
+/* COBS adds one byte per 254 and the delimiter one more */
+#define TELEMETRY_FRAME_MAX_SIZE     (TELEMETRY_RECORD_MAX_SIZE + 2)
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Record types and their payloads (u16 fields saturate at 65535)
+ */
+typedef enum {
+    TELEMETRY_RECORD_SEAT        = 1,   /**< seat u8 (1-based), temperature C u8, heating level u8,
+                                             heater state u8, duty % u8 */
+    TELEMETRY_RECORD_CPU_LOAD    = 2,   /**< load 1 s, 10 s, 60 s, peak, average u16 each, in 0.01 % */
+    TELEMETRY_RECORD_TASK_TIMING = 3,   /**< task tag u8, exec min/avg/max us u32, response avg/max us u32,
+                                             preemptions u16 */
+    TELEMETRY_RECORD_LATENCY     = 4,   /**< sensor to actuator min/max us u32, both 0 before the first sample */
+    TELEMETRY_RECORD_STACK       = 5,   /**< task tag u8, headroom, budget, depth in stack words u16 */
+    TELEMETRY_RECORD_TICKLESS    = 6    /**< sleeps, ms asleep, timer wakeups, interrupt wakeups, aborted
+                                             sleeps u32 each, since boot */
+} TELEMETRY_RecordType;
+
+/**
+ * @brief Record under construction and its encoded frame
+ *
+ * One writer per output stream; the owner serializes access to it.
+ */
+typedef struct {
+    uint8_t aui8Record[TELEMETRY_RECORD_MAX_SIZE];
+    uint8_t ui8Length;                  /**< Record bytes so far */
+    uint8_t ui8Sequence;                /**< Sequence number of the next record */
+    uint8_t aui8Frame[TELEMETRY_FRAME_MAX_SIZE];
+} TELEMETRY_WriterType;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup TELEMETRY_Functions Telemetry Functions
+ * @{
+ */
+
+/**
+ * @brief Starts a record: writes the header with the next sequence number
+ * @param psWriter  Writer
+ * @param eType     Record type
+ * @param ui16TimeMs Time stamp, low 16 bits of the ms tick count
+ */
+void TELEMETRY_begin(TELEMETRY_WriterType *psWriter, TELEMETRY_RecordType eType, uint16_t ui16TimeMs);
+
+/**
+ * @brief Appends payload fields, bytes past TELEMETRY_PAYLOAD_MAX_SIZE are dropped
+ */
+void TELEMETRY_putU8(TELEMETRY_WriterType *psWriter, uint8_t ui8Value);
+void TELEMETRY_putU16(TELEMETRY_WriterType *psWriter, uint32_t ui32Value);   /**< Saturates at 0xFFFF */
+void TELEMETRY_putU32(TELEMETRY_WriterType *psWriter, uint32_t ui32Value);
+
+/**
+ * @brief Closes the record: appends the CRC and COBS encodes it into aui8Frame
+ * @return Frame length in bytes, delimiter included
+ */
+uint32_t TELEMETRY_end(TELEMETRY_WriterType *psWriter);
+
+/** @} */
+
+#endif /* SERVICES_TELEMETRY_TELEMETRY_H_ */
@@ -0,0 +1,111 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Tickless Idle
+ *  File        : tickless.c
+ *  Description : Sleep length, tick compensation and sleep statistics
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/TICKLESS/tickless.h"
+#include "SERVICES/COMMON/irq_lock.h"
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+
+/* Written by the idle task with interrupts masked, read under the same lock */
+static TICKLESS_StatsType xStats;
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Wakeup timer count for a sleep
+ */
+uint32_t TICKLESS_wakeupDelay(const TICKLESS_ConfigType *psConfig, uint32_t ui32CyclesToNextTick,
+                              uint32_t ui32ExpectedIdleTicks)
+{
+    uint64_t ui64Delay = (uint64_t)ui32CyclesToNextTick;
+
+    if(ui32ExpectedIdleTicks > 1U) {
+        ui64Delay += (uint64_t)(ui32ExpectedIdleTicks - 1U) * psConfig->ui32CyclesPerTick;
+    }
+
+    /* Too short to be worth the margin: sleep until the tick itself wakes the CPU */
+    if(ui64Delay > psConfig->ui32WakeupMargin) {
+        ui64Delay -= psConfig->ui32WakeupMargin;
+    }
+    if(ui64Delay > psConfig->ui32MaxDelay) {
+        ui64Delay = psConfig->ui32MaxDelay;
+    }
+    if(ui64Delay == 0U) {
+        ui64Delay = 1U;
+    }
+
+    return (uint32_t)ui64Delay;
+}
+
+/**
+ * @brief Splits the time asleep into completed ticks and the rest of the period
+ */
+void TICKLESS_compensate(const TICKLESS_ConfigType *psConfig, uint32_t ui32CyclesToNextTick,
+                         uint32_t ui32ElapsedCycles, uint32_t ui32ExpectedIdleTicks,
+                         TICKLESS_StepType *psStep)
+{
+    uint32_t ui32MaxSteps = (ui32ExpectedIdleTicks > 0U) ? (ui32ExpectedIdleTicks - 1U) : 0U;
+    uint32_t ui32Past;
+
+    if(ui32ElapsedCycles < ui32CyclesToNextTick) {
+        /* Woken within the period the sleep began in */
+        psStep->ui32CompletedTicks = 0;
+        psStep->ui32CyclesToNextTick = ui32CyclesToNextTick - ui32ElapsedCycles;
+    } else {
+        ui32Past = ui32ElapsedCycles - ui32CyclesToNextTick;
+        psStep->ui32CompletedTicks = 1U + (ui32Past / psConfig->ui32CyclesPerTick);
+        psStep->ui32CyclesToNextTick = psConfig->ui32CyclesPerTick - (ui32Past % psConfig->ui32CyclesPerTick);
+    }
+
+    if(psStep->ui32CompletedTicks > ui32MaxSteps) {
+        psStep->ui32CompletedTicks = ui32MaxSteps;
+        psStep->ui32CyclesToNextTick = TICKLESS_MIN_RELOAD_CYCLES;
+    }
+    if(psStep->ui32CyclesToNextTick < TICKLESS_MIN_RELOAD_CYCLES) {
+        psStep->ui32CyclesToNextTick = TICKLESS_MIN_RELOAD_CYCLES;
+    }
+}
+
+/**
+ * @brief Counts a completed sleep and its wake reason
+ */
+void TICKLESS_recordSleep(uint32_t ui32ElapsedCycles, uint32_t ui32TimerWakeup)
+{
+    xStats.ui32SleepCount++;
+    xStats.ui64SleepCycles += ui32ElapsedCycles;
+    if(ui32TimerWakeup != 0U) {
+        xStats.ui32TimerWakeups++;
+    } else {
+        xStats.ui32InterruptWakeups++;
+    }
+}
+
+/**
+ * @brief Counts a sleep abandoned before the WFI
+ */
+void TICKLESS_recordAbort(void)
+{
+    xStats.ui32AbortCount++;
+}
+
+/**
+ * @brief Consistent copy of the counters, callable from any task
+ */
+void TICKLESS_getStats(TICKLESS_StatsType *psStats)
+{
+    uint32_t ui32State = IRQ_LOCK_SAVE();
+
+    *psStats = xStats;
+    IRQ_LOCK_RESTORE(ui32State);
+}
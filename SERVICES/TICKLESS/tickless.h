@@ -0,0 +1,143 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Tickless Idle
+ *  File        : tickless.h
+ *  Description : Tickless idle with a WTimer1 wakeup: sleep length, tick
+ *                compensation and sleep statistics
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_TICKLESS_TICKLESS_H_
+#define SERVICES_TICKLESS_TICKLESS_H_
+
+/*
+ * Include this file at the end of FreeRTOSConfig.h, after:
+ *   #define configUSE_TICKLESS_IDLE   2
+ *
+ * The kernel then calls TICKLESS_suppressTicksAndSleep() from the idle task
+ * instead of the port's default tickless code. SysTick is stopped and WTimer1A
+ * wakes the CPU one margin before the tick the kernel expects next, so SysTick
+ * restarts in phase; any other interrupt ends the sleep early.
+ *
+ * TICKLESS_wakeupDelay() and TICKLESS_compensate() are plain arithmetic on
+ * cycle counts, so they build and run on the host; only tickless_port.c
+ * touches the hardware.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Tickless_Configuration Tickless idle settings
+ * @{
+ */
+#define TICKLESS_WAKEUP_MARGIN_US   50U   /**< Wake this early to restart SysTick before the tick is due */
+#define TICKLESS_MIN_RELOAD_CYCLES  16U   /**< Shortest SysTick period programmed after a sleep */
+/** @} */
+
+#if defined(configUSE_TICKLESS_IDLE) && (configUSE_TICKLESS_IDLE == 2)
+#define portSUPPRESS_TICKS_AND_SLEEP(xExpectedIdleTime)   TICKLESS_suppressTicksAndSleep(xExpectedIdleTime)
+#endif
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Clock figures, all in CPU clock cycles
+ */
+typedef struct {
+    uint32_t ui32CyclesPerTick;       /**< SysTick period */
+    uint32_t ui32MaxDelay;            /**< Longest wakeup timer count */
+    uint32_t ui32WakeupMargin;        /**< Wake this long before the expected tick */
+} TICKLESS_ConfigType;
+
+/**
+ * @brief How to resume the tick after a sleep
+ */
+typedef struct {
+    uint32_t ui32CompletedTicks;      /**< Whole tick periods that ended while asleep, for vTaskStepTick() */
+    uint32_t ui32CyclesToNextTick;    /**< SysTick reload for the rest of the current period */
+} TICKLESS_StepType;
+
+/**
+ * @brief Sleep counters since boot
+ */
+typedef struct {
+    uint32_t ui32SleepCount;          /**< Sleeps entered */
+    uint32_t ui32AbortCount;          /**< Sleeps abandoned, a task or the tick became ready first */
+    uint32_t ui32TimerWakeups;        /**< Woken by WTimer1A, the expected idle time ran out */
+    uint32_t ui32InterruptWakeups;    /**< Woken early by another interrupt */
+    uint64_t ui64SleepCycles;         /**< Total time asleep, CPU clock cycles */
+} TICKLESS_StatsType;
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup TICKLESS_Functions Tickless Idle Functions
+ * @{
+ */
+
+/**
+ * @brief Wakeup timer count for a sleep
+ *
+ * The kernel expects the first tick after ui32CyclesToNextTick and the last
+ * of ui32ExpectedIdleTicks one tick period apart after that; the sleep ends
+ * the wakeup margin before it, clamped to the timer range.
+ *
+ * @param psConfig              Clock figures
+ * @param ui32CyclesToNextTick  SysTick count left in the current period
+ * @param ui32ExpectedIdleTicks Ticks until the kernel has work, at least 1
+ * @return Cycles to sleep, at least 1
+ */
+uint32_t TICKLESS_wakeupDelay(const TICKLESS_ConfigType *psConfig, uint32_t ui32CyclesToNextTick,
+                              uint32_t ui32ExpectedIdleTicks);
+
+/**
+ * @brief Splits the time asleep into completed ticks and the rest of the period
+ *
+ * At most ui32ExpectedIdleTicks - 1 ticks are stepped, the kernel requires the
+ * last one to come from the tick interrupt. If more time passed, the tick is
+ * made due at once and the excess is lost from the tick count (not from the
+ * WTimer0 timebase).
+ *
+ * @param psConfig              Clock figures
+ * @param ui32CyclesToNextTick  SysTick count left when the sleep began
+ * @param ui32ElapsedCycles     Time asleep
+ * @param ui32ExpectedIdleTicks Value passed to the sleep
+ * @param psStep                Result
+ */
+void TICKLESS_compensate(const TICKLESS_ConfigType *psConfig, uint32_t ui32CyclesToNextTick,
+                         uint32_t ui32ElapsedCycles, uint32_t ui32ExpectedIdleTicks,
+                         TICKLESS_StepType *psStep);
+
+/**
+ * @brief Counts a completed sleep and its wake reason
+ */
+void TICKLESS_recordSleep(uint32_t ui32ElapsedCycles, uint32_t ui32TimerWakeup);
+
+/**
+ * @brief Counts a sleep abandoned before the WFI
+ */
+void TICKLESS_recordAbort(void);
+
+/**
+ * @brief Consistent copy of the counters, callable from any task
+ */
+void TICKLESS_getStats(TICKLESS_StatsType *psStats);
+
+/**
+ * @brief portSUPPRESS_TICKS_AND_SLEEP() implementation, runs in the idle task
+ */
+void TICKLESS_suppressTicksAndSleep(uint32_t ui32ExpectedIdleTicks);
+
+/** @} */
+
+#endif /* SERVICES_TICKLESS_TICKLESS_H_ */
@@ -0,0 +1,103 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Tickless Idle
+ *  File        : tickless_port.c
+ *  Description : portSUPPRESS_TICKS_AND_SLEEP() for the TM4C123: SysTick
+ *                stopped, WTimer1A wakeup, WFI in sleep mode
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "GPTM.h"
+#include "tm4c123gh6pm_registers.h"
+#include "SERVICES/TICKLESS/tickless.h"
+#include "SERVICES/COMMON/irq_lock.h"
+
+/* The host simulation has no SysTick or WFI, the POSIX port idles on its own */
+#if (configUSE_TICKLESS_IDLE == 2) && !defined(SIMULATION)
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define TICKLESS_SYSTICK_ENABLE_MASK     0x00000001   /* Counter enable */
+#define TICKLESS_SYSTICK_RUN_VALUE       0x00000007   /* Enabled, interrupt on, system clock */
+#define TICKLESS_PENDSTSET_MASK          0x04000000   /* SysTick exception pending (NVIC_SYSTEM_INTCTRL) */
+
+/*
+ * The WFI has to run with interrupts masked so the wakeup interrupt cannot be
+ * serviced before the tick is corrected; a pending interrupt still ends it.
+ */
+#if defined(__TI_COMPILER_VERSION__)
+#define TICKLESS_WAIT_FOR_INTERRUPT()    do { __asm(" dsb"); __asm(" wfi"); __asm(" isb"); } while(0)
+#elif defined(__GNUC__)
+#define TICKLESS_WAIT_FOR_INTERRUPT()    __asm volatile ("dsb\n wfi\n isb" : : : "memory")
+#else
+#error "TICKLESS_WAIT_FOR_INTERRUPT() is not defined for this compiler"
+#endif
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+static const TICKLESS_ConfigType xTicklessConfig = {
+    configCPU_CLOCK_HZ / configTICK_RATE_HZ,
+    0xFFFFFFFFUL,                                                   /* WTimer1A is 32 bits wide */
+    (configCPU_CLOCK_HZ / 1000000UL) * TICKLESS_WAKEUP_MARGIN_US
+};
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief portSUPPRESS_TICKS_AND_SLEEP() implementation, runs in the idle task
+ */
+void TICKLESS_suppressTicksAndSleep(uint32_t ui32ExpectedIdleTicks)
+{
+    TICKLESS_StepType xStep;
+    uint32_t ui32State;
+    uint32_t ui32CyclesToNextTick;
+    uint32_t ui32ElapsedCycles;
+    uint64_t ui64SleepStart;
+    uint8 bTimerWakeup;
+
+    ui32State = IRQ_LOCK_SAVE();
+
+    /* Freeze the current period, SysTick resumes from here if the sleep is abandoned */
+    SYSTICK_CTRL_REG &= ~TICKLESS_SYSTICK_ENABLE_MASK;
+    ui32CyclesToNextTick = SYSTICK_CURRENT_REG;
+
+    if((ui32CyclesToNextTick == 0U) ||
+       ((NVIC_SYSTEM_INTCTRL & TICKLESS_PENDSTSET_MASK) != 0U) ||
+       (eTaskConfirmSleepModeStatus() == eAbortSleep)) {
+        SYSTICK_CTRL_REG |= TICKLESS_SYSTICK_ENABLE_MASK;
+        TICKLESS_recordAbort();
+        IRQ_LOCK_RESTORE(ui32State);
+        return;
+    }
+
+    ui64SleepStart = GPTM_WTimer0Read64();
+    GPTM_WTimer1WakeupStart(TICKLESS_wakeupDelay(&xTicklessConfig, ui32CyclesToNextTick, ui32ExpectedIdleTicks));
+
+    TICKLESS_WAIT_FOR_INTERRUPT();
+
+    bTimerWakeup = GPTM_WTimer1WakeupStop();
+    ui32ElapsedCycles = (uint32_t)((GPTM_WTimer0Read64() - ui64SleepStart) << GPTM_TIMEBASE_SHIFT);
+    TICKLESS_compensate(&xTicklessConfig, ui32CyclesToNextTick, ui32ElapsedCycles,
+                        ui32ExpectedIdleTicks, &xStep);
+
+    /* Finish the current period with the remainder, full periods again after the next reload */
+    SYSTICK_RELOAD_REG = xStep.ui32CyclesToNextTick - 1U;
+    SYSTICK_CURRENT_REG = 0;
+    SYSTICK_CTRL_REG = TICKLESS_SYSTICK_RUN_VALUE;
+    SYSTICK_RELOAD_REG = xTicklessConfig.ui32CyclesPerTick - 1U;
+
+    vTaskStepTick(xStep.ui32CompletedTicks);
+    TICKLESS_recordSleep(ui32ElapsedCycles, bTimerWakeup);
+
+    IRQ_LOCK_RESTORE(ui32State);
+}
+
+#endif /* (configUSE_TICKLESS_IDLE == 2) && !defined(SIMULATION) */
@@ -0,0 +1,213 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Trace Recorder
+ *  File        : trace.c
+ *  Description : Binary scheduling trace (task switches, ISRs, mutexes) kept in
+ *                a preallocated RAM ring, see tools/trace_convert.py
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/TRACE/trace.h"
+#include "SERVICES/COMMON/irq_lock.h"
+#include "GPTM.h"
+
+/*------------------------------------------------------------------------------
+ *  LOCAL DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Timestamp source, low 32 bits of the GPTM_TIMEBASE_HZ timebase
+ *
+ * The converter unwraps it, which holds as long as two consecutive records are
+ * less than 2^32 ticks (268 s at 16 MHz) apart.
+ */
+#ifndef TRACE_GET_TIME
+#define TRACE_GET_TIME()       ((uint32_t)GPTM_WTimer0Read64())
+#endif
+
+#define TRACE_LINE_MAX         96    /**< Longest dump line, header included */
+
+/*------------------------------------------------------------------------------
+ *  LOCAL DATA
+ *----------------------------------------------------------------------------*/
+static TRACE_RecordType asTraceBuffer[TRACE_BUFFER_RECORDS];
+static uint32_t ui32TraceWritten = 0;       /**< Free running count of records written */
+static uint32_t ui32TraceDropped = 0;
+static volatile uint8_t ui8TraceRunning = 1;
+
+/*------------------------------------------------------------------------------
+ *  LOCAL FUNCTIONS
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Appends a NUL terminated string to a dump line
+ */
+static uint32_t TRACE_appendString(char *pcLine, uint32_t ui32Length, const char *pcText)
+{
+    while((*pcText != '\0') && (ui32Length < (TRACE_LINE_MAX - 2)))
+    {
+        pcLine[ui32Length++] = *pcText++;
+    }
+    return ui32Length;
+}
+
+/**
+ * @brief Appends an unsigned decimal number to a dump line
+ */
+static uint32_t TRACE_appendDecimal(char *pcLine, uint32_t ui32Length, uint32_t ui32Value)
+{
+    char acDigits[11];
+    uint8_t ui8Count = sizeof(acDigits) - 1;
+
+    acDigits[ui8Count] = '\0';
+    do
+    {
+        acDigits[--ui8Count] = (char)('0' + (ui32Value % 10));
+        ui32Value /= 10;
+    } while(ui32Value != 0);
+
+    return TRACE_appendString(pcLine, ui32Length, &acDigits[ui8Count]);
+}
+
+/**
+ * @brief Appends bytes as lower case hex
+ */
+static uint32_t TRACE_appendHex(char *pcLine, uint32_t ui32Length, uint32_t ui32Value, uint8_t ui8Bytes)
+{
+    static const char acHex[] = "0123456789abcdef";
+
+    while(ui8Bytes-- != 0)
+    {
+        pcLine[ui32Length++] = acHex[(ui32Value >> 4) & 0x0F];
+        pcLine[ui32Length++] = acHex[ui32Value & 0x0F];
+        ui32Value >>= 8;
+    }
+    return ui32Length;
+}
+
+/**
+ * @brief Terminates a dump line with CR LF and hands it to the sink
+ */
+static void TRACE_writeLine(TRACE_WriteFnType pfWrite, char *pcLine, uint32_t ui32Length)
+{
+    pcLine[ui32Length++] = '\r';
+    pcLine[ui32Length++] = '\n';
+    pfWrite(pcLine, ui32Length);
+}
+
+/*------------------------------------------------------------------------------
+ *  FUNCTIONS DEFINITIONS
+ *----------------------------------------------------------------------------*/
+
+void TRACE_record(uint8_t ui8Event, uint8_t ui8Id, uint16_t ui16Arg)
+{
+    TRACE_RecordType *psRecord;
+    uint32_t ui32State;
+
+    if(!ui8TraceRunning)
+    {
+        return;
+    }
+
+    /* Timestamp taken inside the lock so the ring stays in time order */
+    ui32State = IRQ_LOCK_SAVE();
+    if(ui32TraceWritten >= TRACE_BUFFER_RECORDS)
+    {
+        ui32TraceDropped++;
+        if(TRACE_STOP_WHEN_FULL)
+        {
+            IRQ_LOCK_RESTORE(ui32State);
+            return;
+        }
+    }
+
+    psRecord = &asTraceBuffer[ui32TraceWritten & (TRACE_BUFFER_RECORDS - 1)];
+    psRecord->ui32Timestamp = TRACE_GET_TIME();
+    psRecord->ui8Event = ui8Event;
+    psRecord->ui8Id = ui8Id;
+    psRecord->ui16Arg = ui16Arg;
+    ui32TraceWritten++;
+    IRQ_LOCK_RESTORE(ui32State);
+}
+
+void TRACE_start(void)
+{
+    ui8TraceRunning = 1;
+}
+
+void TRACE_stop(void)
+{
+    ui8TraceRunning = 0;
+}
+
+uint32_t TRACE_getCount(void)
+{
+    uint32_t ui32Written = ui32TraceWritten;
+
+    return (ui32Written < TRACE_BUFFER_RECORDS) ? ui32Written : TRACE_BUFFER_RECORDS;
+}
+
+uint32_t TRACE_getDropped(void)
+{
+    return ui32TraceDropped;
+}
+
+void TRACE_dump(TRACE_WriteFnType pfWrite, const char * const *ppcTaskNames, uint32_t ui32NameCount)
+{
+    char acLine[TRACE_LINE_MAX];
+    uint32_t ui32Length;
+    uint32_t ui32Count;
+    uint32_t ui32First;
+    uint32_t ui32Index;
+    uint32_t ui32State;
+
+    /* Freeze the ring; a hook already past the running check finishes under the lock */
+    TRACE_stop();
+    ui32State = IRQ_LOCK_SAVE();
+    IRQ_LOCK_RESTORE(ui32State);
+
+    ui32Count = TRACE_getCount();
+    ui32First = (TRACE_STOP_WHEN_FULL || (ui32TraceWritten <= TRACE_BUFFER_RECORDS)) ? 0 : (ui32TraceWritten - TRACE_BUFFER_RECORDS);
+
+    ui32Length = TRACE_appendString(acLine, 0, "#TRACE v");
+    ui32Length = TRACE_appendDecimal(acLine, ui32Length, TRACE_FORMAT_VERSION);
+    ui32Length = TRACE_appendString(acLine, ui32Length, " hz=");
+    ui32Length = TRACE_appendDecimal(acLine, ui32Length, GPTM_TIMEBASE_HZ);
+    ui32Length = TRACE_appendString(acLine, ui32Length, " records=");
+    ui32Length = TRACE_appendDecimal(acLine, ui32Length, ui32Count);
+    ui32Length = TRACE_appendString(acLine, ui32Length, " dropped=");
+    ui32Length = TRACE_appendDecimal(acLine, ui32Length, ui32TraceDropped);
+    TRACE_writeLine(pfWrite, acLine, ui32Length);
+
+    for(ui32Index = 0; (ppcTaskNames != 0) && (ui32Index < ui32NameCount); ui32Index++)
+    {
+        ui32Length = TRACE_appendString(acLine, 0, "#TN ");
+        ui32Length = TRACE_appendDecimal(acLine, ui32Length, ui32Index);
+        ui32Length = TRACE_appendString(acLine, ui32Length, " ");
+        ui32Length = TRACE_appendString(acLine, ui32Length, ppcTaskNames[ui32Index]);
+        TRACE_writeLine(pfWrite, acLine, ui32Length);
+    }
+
+    for(ui32Index = 0; ui32Index < ui32Count; ui32Index++)
+    {
+        const TRACE_RecordType *psRecord = &asTraceBuffer[(ui32First + ui32Index) & (TRACE_BUFFER_RECORDS - 1)];
+
+        if((ui32Index % TRACE_DUMP_RECORDS_PER_LINE) == 0)
+        {
+            ui32Length = TRACE_appendString(acLine, 0, "#T ");
+        }
+        ui32Length = TRACE_appendHex(acLine, ui32Length, psRecord->ui32Timestamp, 4);
+        ui32Length = TRACE_appendHex(acLine, ui32Length, psRecord->ui8Event, 1);
+        ui32Length = TRACE_appendHex(acLine, ui32Length, psRecord->ui8Id, 1);
+        ui32Length = TRACE_appendHex(acLine, ui32Length, psRecord->ui16Arg, 2);
+        if(((ui32Index + 1) % TRACE_DUMP_RECORDS_PER_LINE == 0) || (ui32Index + 1 == ui32Count))
+        {
+            TRACE_writeLine(pfWrite, acLine, ui32Length);
+        }
+    }
+
+    ui32Length = TRACE_appendString(acLine, 0, "#TEND");
+    TRACE_writeLine(pfWrite, acLine, ui32Length);
+}
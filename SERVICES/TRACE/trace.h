@@ -0,0 +1,148 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Trace Recorder
+ *  File        : trace.h
+ *  Description : Binary scheduling trace (task switches, ISRs, mutexes) kept in
+ *                a preallocated RAM ring, see tools/trace_convert.py
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+#ifndef SERVICES_TRACE_TRACE_H_
+#define SERVICES_TRACE_TRACE_H_
+
+/*
+ * Build with -DTRACE_RECORDER_ENABLE=1 to record. When it is 0 (default) the
+ * TRACE_* hook macros compile to nothing, in the kernel and in the ISRs alike.
+ * This header only uses plain C types, it is pulled into the kernel through
+ * runtime_trace.h.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants and Configurations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Trace_Configuration Trace recorder settings
+ * @{
+ */
+#ifndef TRACE_RECORDER_ENABLE
+#define TRACE_RECORDER_ENABLE    0
+#endif
+#define TRACE_BUFFER_RECORDS     512   /**< Ring size in records (8 bytes each), power of two */
+#define TRACE_STOP_WHEN_FULL     0     /**< 1 keeps the first records, 0 overwrites the oldest */
+#define TRACE_FORMAT_VERSION     1     /**< Bumped when the record layout changes */
+#define TRACE_DUMP_RECORDS_PER_LINE  4
+/** @} */
+
+#if (TRACE_BUFFER_RECORDS & (TRACE_BUFFER_RECORDS - 1)) != 0
+#error "TRACE_BUFFER_RECORDS must be a power of two"
+#endif
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief Recorded events, ui8Id is a task tag, an ISR id or the tag of the mutex user
+ */
+typedef enum {
+    TRACE_EVENT_TASK_RELEASE = 1,    /**< Task made ready */
+    TRACE_EVENT_SWITCH_IN    = 2,    /**< Task got the CPU */
+    TRACE_EVENT_SWITCH_OUT   = 3,    /**< Task lost the CPU, ui16Arg = 1 if still ready (preempted) */
+    TRACE_EVENT_ISR_ENTER    = 4,
+    TRACE_EVENT_ISR_EXIT     = 5,
+    TRACE_EVENT_MUTEX_TAKE   = 6,
+    TRACE_EVENT_MUTEX_GIVE   = 7,
+    TRACE_EVENT_MUTEX_BLOCK  = 8     /**< Task blocks waiting for a mutex */
+} TRACE_EventType;
+
+/**
+ * @brief Interrupt sources instrumented with TRACE_ISR_ENTER/EXIT
+ */
+typedef enum {
+    TRACE_ISR_UART0,
+    TRACE_ISR_ADC0SS1,
+    TRACE_ISR_GPIOF,
+    TRACE_ISR_GPIOB,
+    TRACE_ISR_TIMER1A
+} TRACE_IsrIdType;
+
+/**
+ * @brief One trace record, little endian on the wire
+ */
+typedef struct {
+    uint32_t ui32Timestamp;          /**< Low 32 bits of the WTimer0 timebase */
+    uint8_t ui8Event;                /**< TRACE_EventType */
+    uint8_t ui8Id;                   /**< Task tag or TRACE_IsrIdType */
+    uint16_t ui16Arg;                /**< Event specific */
+} TRACE_RecordType;
+
+/**
+ * @brief Output sink of TRACE_dump, called from task context
+ */
+typedef void (*TRACE_WriteFnType)(const char *pcText, uint32_t ui32Length);
+
+/*------------------------------------------------------------------------------
+ *  Hook Macros
+ *----------------------------------------------------------------------------*/
+#if TRACE_RECORDER_ENABLE
+#define TRACE_HOOK(event, id, arg)   TRACE_record((event), (uint8_t)(id), (uint16_t)(arg))
+#else
+#define TRACE_HOOK(event, id, arg)
+#endif
+
+#define TRACE_ISR_ENTER(isr)         TRACE_HOOK(TRACE_EVENT_ISR_ENTER, (isr), 0)
+#define TRACE_ISR_EXIT(isr)          TRACE_HOOK(TRACE_EVENT_ISR_EXIT, (isr), 0)
+
+/*------------------------------------------------------------------------------
+ *  Function Declarations
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @defgroup Trace_Functions Trace Recorder Functions
+ * @{
+ */
+
+/**
+ * @brief Appends a record, callable from tasks, ISRs and kernel hooks
+ */
+void TRACE_record(uint8_t ui8Event, uint8_t ui8Id, uint16_t ui16Arg);
+
+/**
+ * @brief Resumes recording (recording is on from reset)
+ */
+void TRACE_start(void);
+
+/**
+ * @brief Freezes the ring, later events are dropped
+ */
+void TRACE_stop(void);
+
+/**
+ * @brief Records currently held in the ring
+ */
+uint32_t TRACE_getCount(void);
+
+/**
+ * @brief Records lost to a full ring (stop mode) or overwritten (ring mode)
+ */
+uint32_t TRACE_getDropped(void);
+
+/**
+ * @brief Stops recording and writes the ring as text lines for tools/trace_convert.py
+ * @param pfWrite       Output sink, may block
+ * @param ppcTaskNames  Name of each task tag, written as a header (may be 0)
+ * @param ui32NameCount Entries in ppcTaskNames
+ *
+ * Format: "#TRACE" header, one "#TN <tag> <name>" per task, "#T" lines of hex
+ * encoded records (oldest first) and "#TEND".
+ */
+void TRACE_dump(TRACE_WriteFnType pfWrite, const char * const *ppcTaskNames, uint32_t ui32NameCount);
+
+/** @} */
+
+#endif /* SERVICES_TRACE_TRACE_H_ */
@@ -0,0 +1,55 @@
+ /******************************************************************************
+ *
+ * Module: SIM
+ *
+ * File Name: FreeRTOSConfig.h
+ *
+ * Description: FreeRTOS configuration of the host simulation (GCC/Posix port)
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* Same scheduling parameters as the target, the clock only feeds configCPU_CLOCK_HZ users */
+#define configUSE_PREEMPTION                     1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  0
+#define configCPU_CLOCK_HZ                       16000000UL
+#define configTICK_RATE_HZ                       1000
+#define configMAX_PRIORITIES                     6
+#define configMINIMAL_STACK_SIZE                 ((unsigned short)256)
+#define configTOTAL_HEAP_SIZE                    ((size_t)(256 * 1024))
+#define configMAX_TASK_NAME_LEN                  24
+#define configUSE_16_BIT_TICKS                   0
+#define configIDLE_SHOULD_YIELD                  1
+
+#define configUSE_MUTEXES                        1
+#define configUSE_TASK_NOTIFICATIONS             1
+#define configUSE_APPLICATION_TASK_TAG           1
+#define configUSE_IDLE_HOOK                      0
+#define configUSE_TICK_HOOK                      0
+#define configUSE_MALLOC_FAILED_HOOK             1
+#define configCHECK_FOR_STACK_OVERFLOW           0
+#define configUSE_TIMERS                         0   /* No daemon task, the application uses no software timers */
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#ifndef configSUPPORT_STATIC_ALLOCATION
+#define configSUPPORT_STATIC_ALLOCATION          0   /* -DconfigSUPPORT_STATIC_ALLOCATION=1: application objects in xRtosArena */
+#endif
+#define configENABLE_BACKWARD_COMPATIBILITY      1   /* xSemaphoreHandle */
+
+#define INCLUDE_vTaskDelay                       1
+#define INCLUDE_vTaskDelayUntil                  1
+#define INCLUDE_xTaskDelayUntil                  1
+#define INCLUDE_vTaskSuspend                     1
+#define INCLUDE_xTaskGetSchedulerState           1
+#define INCLUDE_uxTaskGetStackHighWaterMark      1
+#define INCLUDE_xTaskGetIdleTaskHandle           1
+
+extern void vAssertCalled(const char *pFile, unsigned long uLine);
+#define configASSERT(x)                          if((x) == 0) vAssertCalled(__FILE__, __LINE__)
+
+#include "SERVICES/RUNTIME/runtime_trace.h"
+
+#endif /* FREERTOS_CONFIG_H */
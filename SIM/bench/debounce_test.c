@@ -0,0 +1,254 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Host Simulation
+ *  File        : debounce_test.c
+ *  Description : Host test of the button debouncer on synthetic pin traces
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*
+ * Drives HAL/BUTTONS/debounce the way buttons.c does: the falling (press)
+ * edge interrupt feeds DEBOUNCE_edge and is masked until the button is idle
+ * again, edges seen while masked are dropped, and a 5 ms timer started by the
+ * edge feeds DEBOUNCE_tick until the button is idle. A trace gives the pin
+ * one character per ms: '1' pressed, '0' released, '^' a press edge that
+ * reads released by the time the interrupt samples the pin. Each trace
+ * checks the events and the ms they are reported at:
+ *  - a clean press and release
+ *  - bounce inside the debounce window, on the press and on the release
+ *  - a release glitch while held, a spike while idle, and a press whose
+ *    edge read released
+ *  - a long hold
+ *
+ *   gcc -O2 -Wall -I. SIM/bench/debounce_test.c HAL/BUTTONS/debounce.c -o debounce_test
+ *   ./debounce_test
+ *
+ * The exit status is the number of failed checks.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "HAL/BUTTONS/debounce.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define TEST_TICK_PERIOD_MS      (5U)       /* BUTTONS_TICK_PERIOD_MS */
+#define TEST_MAX_EVENTS          (8U)
+#define TEST_TRACE_SIZE          (10100U)
+#define TEST_HOLD_MS             (10000U)
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+typedef struct {
+    DEBOUNCE_EventType eEvent;
+    uint32_t ui32Ms;
+} TestEventType;
+
+typedef struct {
+    TestEventType axEvents[TEST_MAX_EVENTS];
+    uint32_t ui32Events;
+    uint8_t ui8Armed;                               /* Edge interrupt unmasked at the end */
+    uint8_t ui8Running;                             /* Debounce timer running at the end */
+} TestRunType;
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+static char acTrace[TEST_TRACE_SIZE];
+static uint32_t ui32Failures;
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static void prvCheck(int iCondition, const char *pcWhat)
+{
+    if(!iCondition) {
+        printf("FAIL: %s\n", pcWhat);
+        ui32Failures++;
+    }
+}
+
+static void prvRecord(TestRunType *pxRun, DEBOUNCE_EventType eEvent, uint32_t ui32Ms)
+{
+    if((eEvent != DEBOUNCE_EVENT_NONE) && (pxRun->ui32Events < TEST_MAX_EVENTS)) {
+        pxRun->axEvents[pxRun->ui32Events].eEvent = eEvent;
+        pxRun->axEvents[pxRun->ui32Events].ui32Ms = ui32Ms;
+        pxRun->ui32Events++;
+    }
+}
+
+/* Plays a trace through the edge interrupt and the debounce timer of one button */
+static void prvRun(const char *pcTrace, TestRunType *pxRun)
+{
+    DEBOUNCE_StateType xState;
+    uint32_t ui32NextTick = 0;
+    uint32_t ui32Ms;
+    uint8_t ui8Previous = 0;
+
+    memset(pxRun, 0, sizeof(*pxRun));
+    pxRun->ui8Armed = 1U;
+    DEBOUNCE_init(&xState);
+
+    for(ui32Ms = 0; pcTrace[ui32Ms] != '\0'; ui32Ms++) {
+        uint8_t ui8Level = (pcTrace[ui32Ms] == '1') ? 1U : 0U;
+        uint8_t ui8Edge = ((pcTrace[ui32Ms] != '0') && !ui8Previous) ? 1U : 0U;
+
+        if(pxRun->ui8Running && (ui32Ms == ui32NextTick)) {
+            ui32NextTick += TEST_TICK_PERIOD_MS;
+            prvRecord(pxRun, DEBOUNCE_tick(&xState, ui8Level), ui32Ms);
+            if(DEBOUNCE_isIdle(&xState)) {
+                pxRun->ui8Armed = 1U;
+                pxRun->ui8Running = 0U;
+            }
+        }
+
+        if(ui8Edge && pxRun->ui8Armed) {
+            pxRun->ui8Armed = 0U;
+            prvRecord(pxRun, DEBOUNCE_edge(&xState, ui8Level), ui32Ms);
+            if(!pxRun->ui8Running) {
+                pxRun->ui8Running = 1U;
+                ui32NextTick = ui32Ms + TEST_TICK_PERIOD_MS;
+            }
+        }
+        ui8Previous = ui8Level;
+    }
+}
+
+/* Builds a trace from runs of one character */
+static void prvTraceAppend(char cLevel, uint32_t ui32Length)
+{
+    uint32_t ui32Used = (uint32_t)strlen(acTrace);
+
+    if((ui32Used + ui32Length) < TEST_TRACE_SIZE) {
+        memset(&acTrace[ui32Used], cLevel, ui32Length);
+        acTrace[ui32Used + ui32Length] = '\0';
+    }
+}
+
+static void prvTraceText(const char *pcText)
+{
+    if((strlen(acTrace) + strlen(pcText)) < TEST_TRACE_SIZE) {
+        strcat(acTrace, pcText);
+    }
+}
+
+/* The run reported a press at ui32PressMs and a release at ui32ReleaseMs, nothing else, and ended idle */
+static void prvCheckPressRelease(const TestRunType *pxRun, uint32_t ui32PressMs, uint32_t ui32ReleaseMs,
+                                 const char *pcWhat)
+{
+    char acWhat[80];
+
+    snprintf(acWhat, sizeof(acWhat), "%s: one press and one release", pcWhat);
+    prvCheck(pxRun->ui32Events == 2U, acWhat);
+    snprintf(acWhat, sizeof(acWhat), "%s: press at %u ms", pcWhat, (unsigned)ui32PressMs);
+    prvCheck((pxRun->ui32Events >= 1U) && (pxRun->axEvents[0].eEvent == DEBOUNCE_EVENT_PRESS) &&
+             (pxRun->axEvents[0].ui32Ms == ui32PressMs), acWhat);
+    snprintf(acWhat, sizeof(acWhat), "%s: release at %u ms", pcWhat, (unsigned)ui32ReleaseMs);
+    prvCheck((pxRun->ui32Events >= 2U) && (pxRun->axEvents[1].eEvent == DEBOUNCE_EVENT_RELEASE) &&
+             (pxRun->axEvents[1].ui32Ms == ui32ReleaseMs), acWhat);
+    snprintf(acWhat, sizeof(acWhat), "%s: edge re-armed and timer stopped", pcWhat);
+    prvCheck(pxRun->ui8Armed && !pxRun->ui8Running, acWhat);
+}
+
+/*------------------------------------------------------------------------------
+ *  Tests
+ *----------------------------------------------------------------------------*/
+
+static void prvTestCleanPress(void)
+{
+    TestRunType xRun;
+
+    // Pressed 5..54 ms. The press is reported on the edge; the timer samples at 10, 15, ... and the
+    // release needs DEBOUNCE_RELEASE_TICKS released samples: 55, 60, 65, 70
+    acTrace[0] = '\0';
+    prvTraceAppend('0', 5);
+    prvTraceAppend('1', 50);
+    prvTraceAppend('0', 40);
+    prvRun(acTrace, &xRun);
+    prvCheckPressRelease(&xRun, 5, 55 + ((DEBOUNCE_RELEASE_TICKS - 1) * TEST_TICK_PERIOD_MS), "clean");
+}
+
+static void prvTestBounce(void)
+{
+    TestRunType xRun;
+
+    // The press bounces for 7 ms: its edges arrive masked and the released sample at 10 ms is absorbed.
+    // The release bounces back at 51 and 55 ms; the sample at 55 restarts the count: 60, 65, 70, 75
+    acTrace[0] = '\0';
+    prvTraceAppend('0', 5);
+    prvTraceText("1011001");
+    prvTraceAppend('1', 38);
+    prvTraceText("010001");
+    prvTraceAppend('0', 40);
+    prvRun(acTrace, &xRun);
+    prvCheckPressRelease(&xRun, 5, 75, "bounce");
+}
+
+static void prvTestGlitches(void)
+{
+    TestRunType xRun;
+
+    // Released for 8 ms while held, shorter than the release window: samples 25 and 30 read released,
+    // 35 pressed again, so the hold goes on until the release counted at 65, 70, 75, 80
+    acTrace[0] = '\0';
+    prvTraceAppend('0', 5);
+    prvTraceAppend('1', 20);
+    prvTraceAppend('0', 8);
+    prvTraceAppend('1', 30);
+    prvTraceAppend('0', 40);
+    prvRun(acTrace, &xRun);
+    prvCheckPressRelease(&xRun, 5, 80, "release glitch");
+
+    // A spike while idle: the edge reads released and the first sample too, nothing is reported
+    acTrace[0] = '\0';
+    prvTraceAppend('0', 5);
+    prvTraceText("^");
+    prvTraceAppend('0', 30);
+    prvRun(acTrace, &xRun);
+    prvCheck(xRun.ui32Events == 0U, "spike: no event");
+    prvCheck(xRun.ui8Armed && !xRun.ui8Running, "spike: edge re-armed after one sample");
+
+    // The edge reads released but the button stays down: DEBOUNCE_PRESS_TICKS samples confirm it
+    acTrace[0] = '\0';
+    prvTraceAppend('0', 5);
+    prvTraceText("^");
+    prvTraceAppend('1', 30);
+    prvTraceAppend('0', 40);
+    prvRun(acTrace, &xRun);
+    prvCheckPressRelease(&xRun, 5 + (DEBOUNCE_PRESS_TICKS * TEST_TICK_PERIOD_MS),
+                         40 + ((DEBOUNCE_RELEASE_TICKS - 1) * TEST_TICK_PERIOD_MS), "late edge");
+}
+
+static void prvTestLongHold(void)
+{
+    TestRunType xRun;
+    uint32_t ui32Release = 5 + TEST_HOLD_MS;
+
+    // Ten seconds held: one press, no repeat and no release until the button comes up
+    acTrace[0] = '\0';
+    prvTraceAppend('0', 5);
+    prvTraceAppend('1', TEST_HOLD_MS);
+    prvTraceAppend('0', 40);
+    prvRun(acTrace, &xRun);
+    prvCheckPressRelease(&xRun, 5, ui32Release + ((DEBOUNCE_RELEASE_TICKS - 1) * TEST_TICK_PERIOD_MS), "long hold");
+}
+
+/*------------------------------------------------------------------------------
+ *  Main Function
+ *----------------------------------------------------------------------------*/
+int main(void)
+{
+    prvTestCleanPress();
+    prvTestBounce();
+    prvTestGlitches();
+    prvTestLongHold();
+
+    printf("%s (%u failed)\n", (ui32Failures == 0U) ? "PASS" : "FAIL", (unsigned)ui32Failures);
+    return (int)ui32Failures;
+}
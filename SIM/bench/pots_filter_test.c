@@ -0,0 +1,212 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Host Simulation
+ *  File        : pots_filter_test.c
+ *  Description : Host accuracy test and benchmark of the seat sensor filters
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*
+ * Checks HAL/POTS/pots_filter on the host against reference models:
+ *  - median: the sorting networks against qsort of the same window, over
+ *    random samples, while the window fills up and once it is full
+ *  - IIR step response: every output against the closed form
+ *    x1 + (x0 - x1) * (1 - 2^-shift)^k, within the output rounding plus
+ *    the truncation the Q8 state can accumulate, and the final value exact
+ *  - IIR tracking: the lag behind a ramp of slope r settles at r * (2^shift - 1)
+ * then times FILTER_process per sample. Build it with a window of 5 to cover
+ * the largest network (the firmware default is 3):
+ *
+ *   gcc -O2 -Wall -DFILTER_MEDIAN_SIZE=5 -I. SIM/bench/pots_filter_test.c HAL/POTS/pots_filter.c -lm -o pots_filter_test
+ *   ./pots_filter_test
+ *
+ * The exit status is the number of failed checks.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "HAL/POTS/pots_filter.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define TEST_RAW_MAX             (4095U)
+#define TEST_MEDIAN_SAMPLES      (200000UL)
+#define TEST_STEP_LENGTH         (200U)
+#define TEST_RAMP_LENGTH         (400U)
+#define TEST_BENCH_SAMPLES       (20000000UL)
+
+/* The Q8 state truncates at most one LSB per update, which adds up to 2^shift LSB at most */
+#define TEST_IIR_TOLERANCE       (0.5 + ((double)(1U << FILTER_IIR_SHIFT) / (1U << FILTER_IIR_FRAC_BITS)))
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+static uint32_t ui32Failures;
+static volatile uint32_t ui32Sink;
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static void prvCheck(int iCondition, const char *pcWhat)
+{
+    if(!iCondition) {
+        printf("FAIL: %s\n", pcWhat);
+        ui32Failures++;
+    }
+}
+
+static int prvCompare(const void *pvA, const void *pvB)
+{
+    return (int)*(const uint16_t *)pvA - (int)*(const uint16_t *)pvB;
+}
+
+/* Median of the last ui32Count samples by sorting, the mean of the middle pair rounded up when even */
+static uint16_t prvReferenceMedian(const uint16_t *pui16Samples, uint32_t ui32Count)
+{
+    uint16_t aui16Sorted[FILTER_MEDIAN_SIZE];
+    uint32_t ui32Index;
+
+    for(ui32Index = 0; ui32Index < ui32Count; ui32Index++) {
+        aui16Sorted[ui32Index] = pui16Samples[ui32Index];
+    }
+    qsort(aui16Sorted, ui32Count, sizeof(uint16_t), prvCompare);
+    if((ui32Count & 1U) != 0U) {
+        return aui16Sorted[ui32Count / 2U];
+    }
+    return (uint16_t)((aui16Sorted[(ui32Count / 2U) - 1U] + aui16Sorted[ui32Count / 2U] + 1U) / 2U);
+}
+
+static uint64_t prvNowNs(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return ((uint64_t)xNow.tv_sec * 1000000000ULL) + (uint64_t)xNow.tv_nsec;
+}
+
+/*------------------------------------------------------------------------------
+ *  Tests
+ *----------------------------------------------------------------------------*/
+
+static void prvTestMedian(void)
+{
+    FILTER_StateType xState;
+    uint16_t aui16History[FILTER_MEDIAN_SIZE] = { 0 };
+    uint32_t ui32Sample;
+    uint32_t ui32Mismatches = 0;
+
+    srand(1);
+    for(ui32Sample = 0; ui32Sample < TEST_MEDIAN_SAMPLES; ui32Sample++) {
+        uint16_t ui16Sample = (uint16_t)(rand() % (TEST_RAW_MAX + 1U));
+        uint32_t ui32Count;
+        uint32_t ui32Index;
+
+        // A fresh filter every 50 samples, so the filling window is covered too
+        if((ui32Sample % 50U) == 0U) {
+            FILTER_init(&xState);
+        }
+        ui32Count = ((ui32Sample % 50U) + 1U < FILTER_MEDIAN_SIZE) ? (ui32Sample % 50U) + 1U : FILTER_MEDIAN_SIZE;
+
+        for(ui32Index = FILTER_MEDIAN_SIZE - 1U; ui32Index > 0U; ui32Index--) {
+            aui16History[ui32Index] = aui16History[ui32Index - 1U];
+        }
+        aui16History[0] = ui16Sample;
+
+        if(FILTER_median(&xState, ui16Sample) != prvReferenceMedian(aui16History, ui32Count)) {
+            ui32Mismatches++;
+        }
+    }
+
+    printf("median of %u: %u of %lu outputs differ from the sorted reference\n", (unsigned)FILTER_MEDIAN_SIZE,
+           (unsigned)ui32Mismatches, (unsigned long)TEST_MEDIAN_SAMPLES);
+    prvCheck(ui32Mismatches == 0U, "median: matches the sorted reference");
+}
+
+static void prvTestStep(uint16_t ui16From, uint16_t ui16To)
+{
+    FILTER_StateType xState;
+    double dDecay = 1.0 - (1.0 / (1U << FILTER_IIR_SHIFT));
+    double dWorst = 0.0;
+    uint32_t ui32Step;
+    uint16_t ui16Output = 0;
+    char acWhat[64];
+
+    FILTER_init(&xState);
+    prvCheck(FILTER_iir(&xState, ui16From) == ui16From, "iir: starts from the first sample");
+    for(ui32Step = 1; ui32Step <= TEST_STEP_LENGTH; ui32Step++) {
+        double dExpected = ui16To + ((double)ui16From - ui16To) * pow(dDecay, ui32Step);
+
+        ui16Output = FILTER_iir(&xState, ui16To);
+        if(fabs(ui16Output - dExpected) > dWorst) {
+            dWorst = fabs(ui16Output - dExpected);
+        }
+    }
+
+    printf("iir step %u -> %u: max error %.3f against the closed form\n", (unsigned)ui16From, (unsigned)ui16To,
+           dWorst);
+    snprintf(acWhat, sizeof(acWhat), "iir: step %u -> %u follows the closed form", (unsigned)ui16From,
+             (unsigned)ui16To);
+    prvCheck(dWorst <= TEST_IIR_TOLERANCE, acWhat);
+    snprintf(acWhat, sizeof(acWhat), "iir: step %u -> %u settles exactly", (unsigned)ui16From, (unsigned)ui16To);
+    prvCheck(ui16Output == ui16To, acWhat);
+}
+
+static void prvTestRamp(uint32_t ui32Slope)
+{
+    FILTER_StateType xState;
+    double dLag = (double)ui32Slope * ((1U << FILTER_IIR_SHIFT) - 1U);
+    uint32_t ui32Step;
+    uint16_t ui16Output = 0;
+    uint32_t ui32Input = 0;
+
+    FILTER_init(&xState);
+    for(ui32Step = 0; ui32Step < TEST_RAMP_LENGTH; ui32Step++) {
+        ui32Input = ui32Step * ui32Slope;
+        ui16Output = FILTER_iir(&xState, (uint16_t)ui32Input);
+    }
+
+    printf("iir ramp of %u per sample: lag %d, expected %.1f\n", (unsigned)ui32Slope,
+           (int)ui32Input - (int)ui16Output, dLag);
+    prvCheck(fabs(((double)ui32Input - ui16Output) - dLag) <= TEST_IIR_TOLERANCE, "iir: ramp lag");
+}
+
+static void prvBench(void)
+{
+    FILTER_StateType xState;
+    uint64_t ui64StartNs;
+    uint32_t ui32Sample;
+    uint32_t ui32Sum = 0;
+
+    FILTER_init(&xState);
+    ui64StartNs = prvNowNs();
+    for(ui32Sample = 0; ui32Sample < TEST_BENCH_SAMPLES; ui32Sample++) {
+        ui32Sum += FILTER_process(&xState, (uint16_t)((ui32Sample * 2654435761UL) >> 20));
+    }
+    ui32Sink = ui32Sum;
+    printf("FILTER_process: %.2f ns/sample\n", (double)(prvNowNs() - ui64StartNs) / TEST_BENCH_SAMPLES);
+}
+
+/*------------------------------------------------------------------------------
+ *  Main Function
+ *----------------------------------------------------------------------------*/
+int main(void)
+{
+    prvTestMedian();
+    prvTestStep(0, TEST_RAW_MAX);
+    prvTestStep(TEST_RAW_MAX, 0);
+    prvTestStep(1000, 1010);
+    prvTestStep(2000, 1990);
+    prvTestRamp(1);
+    prvTestRamp(5);
+    prvBench();
+
+    printf("%s (%u failed)\n", (ui32Failures == 0U) ? "PASS" : "FAIL", (unsigned)ui32Failures);
+    return (int)ui32Failures;
+}
@@ -0,0 +1,226 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Host Simulation
+ *  File        : seqlock_test.c
+ *  Description : Torn-read stress test of the sequence lock
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*
+ * Checks SERVICES/SEQLOCK on the host: the initial value and back-to-back
+ * writes on one thread, then one writer thread publishing a multi-word record
+ * as fast as it can while reader threads take snapshots, the way the seat
+ * tasks publish their status to the display and shell tasks but with real
+ * concurrency. Every word of the record is derived from the write count, so a
+ * snapshot mixing two writes breaks the invariant; each reader also checks
+ * that the snapshots it takes never go back in time. On a single core the
+ * threads are preempted in the middle of their copies instead.
+ *
+ *   gcc -O2 -Wall -pthread -I. SIM/bench/seqlock_test.c SERVICES/SEQLOCK/seqlock.c -o seqlock_test
+ *   ./seqlock_test [writes]
+ *
+ * The exit status is the number of failed checks.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/SEQLOCK/seqlock.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define TEST_READERS             (3U)
+#define TEST_RECORD_WORDS        (16U)
+#define TEST_DEFAULT_WRITES      (5000000UL)
+#define TEST_CHECK_WORD          (0x9E3779B9UL)
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+typedef struct {
+    uint32_t ui32Count;                             /* Writes published so far */
+    uint32_t aui32Words[TEST_RECORD_WORDS];         /* (count + index) ^ TEST_CHECK_WORD */
+    uint32_t ui32Inverse;                           /* ~count, last so a partial copy shows */
+} TestRecordType;
+
+typedef struct {
+    pthread_t xThread;
+    uint32_t ui32Reads;
+    uint32_t ui32Torn;
+    uint32_t ui32Backwards;
+    uint32_t ui32Changes;                           /* Snapshots that differed from the previous one */
+} TestReaderType;
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+static TestRecordType axCopies[2];
+static SEQLOCK_Type xLock;
+static TestReaderType axReaders[TEST_READERS];
+static uint32_t ui32WriterDone;                     /* Set once the last write is published */
+static uint32_t ui32Writes;
+static uint32_t ui32Failures;
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static void prvCheck(int iCondition, const char *pcWhat)
+{
+    if(!iCondition) {
+        printf("FAIL: %s\n", pcWhat);
+        ui32Failures++;
+    }
+}
+
+static void prvRecord(TestRecordType *pxRecord, uint32_t ui32Count)
+{
+    uint32_t ui32Index;
+
+    pxRecord->ui32Count = ui32Count;
+    for(ui32Index = 0; ui32Index < TEST_RECORD_WORDS; ui32Index++) {
+        pxRecord->aui32Words[ui32Index] = (ui32Count + ui32Index) ^ TEST_CHECK_WORD;
+    }
+    pxRecord->ui32Inverse = ~ui32Count;
+}
+
+static int prvIsConsistent(const TestRecordType *pxRecord)
+{
+    uint32_t ui32Index;
+
+    for(ui32Index = 0; ui32Index < TEST_RECORD_WORDS; ui32Index++) {
+        if(pxRecord->aui32Words[ui32Index] != ((pxRecord->ui32Count + ui32Index) ^ TEST_CHECK_WORD)) {
+            return 0;
+        }
+    }
+    return pxRecord->ui32Inverse == ~pxRecord->ui32Count;
+}
+
+static void *prvWriter(void *pvArgument)
+{
+    TestRecordType xRecord;
+    uint32_t ui32Count;
+
+    (void)pvArgument;
+    for(ui32Count = 1; ui32Count <= ui32Writes; ui32Count++) {
+        prvRecord(&xRecord, ui32Count);
+        SEQLOCK_write(&xLock, &xRecord);
+    }
+    __atomic_store_n(&ui32WriterDone, 1U, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void *prvReader(void *pvArgument)
+{
+    TestReaderType *pxReader = (TestReaderType *)pvArgument;
+    TestRecordType xRecord;
+    uint32_t ui32Last = 0;
+
+    // One more snapshot after the writer is done, which must be its last write
+    do {
+        uint32_t ui32Done = __atomic_load_n(&ui32WriterDone, __ATOMIC_ACQUIRE);
+
+        SEQLOCK_read(&xLock, &xRecord);
+        pxReader->ui32Reads++;
+        if(!prvIsConsistent(&xRecord)) {
+            pxReader->ui32Torn++;
+            continue;
+        }
+        if(xRecord.ui32Count < ui32Last) {
+            pxReader->ui32Backwards++;
+        }
+        if(xRecord.ui32Count != ui32Last) {
+            pxReader->ui32Changes++;
+        }
+        ui32Last = xRecord.ui32Count;
+        if(ui32Done) {
+            break;
+        }
+    } while(1);
+
+    if(ui32Last != ui32Writes) {
+        pxReader->ui32Backwards++;
+    }
+    return NULL;
+}
+
+/*------------------------------------------------------------------------------
+ *  Tests
+ *----------------------------------------------------------------------------*/
+
+static void prvTestSingleThread(void)
+{
+    TestRecordType xRecord;
+    uint32_t ui32Count;
+
+    prvRecord(&xRecord, 0);
+    SEQLOCK_init(&xLock, axCopies, sizeof(TestRecordType), &xRecord);
+    prvRecord(&xRecord, 99);
+    SEQLOCK_read(&xLock, &xRecord);
+    prvCheck(prvIsConsistent(&xRecord) && (xRecord.ui32Count == 0U), "single: initial value");
+
+    for(ui32Count = 1; ui32Count <= 5U; ui32Count++) {
+        prvRecord(&xRecord, ui32Count);
+        SEQLOCK_write(&xLock, &xRecord);
+    }
+    SEQLOCK_read(&xLock, &xRecord);
+    prvCheck(prvIsConsistent(&xRecord) && (xRecord.ui32Count == 5U), "single: last write wins");
+    prvCheck(xLock.ui32Sequence == 10U, "single: sequence moves by two per write");
+}
+
+static void prvTestStress(void)
+{
+    TestRecordType xRecord;
+    pthread_t xWriter;
+    uint32_t ui32Index;
+    uint32_t ui32Reads = 0;
+    uint32_t ui32Torn = 0;
+    uint32_t ui32Backwards = 0;
+    uint32_t ui32Changes = 0;
+
+    prvRecord(&xRecord, 0);
+    SEQLOCK_init(&xLock, axCopies, sizeof(TestRecordType), &xRecord);
+    for(ui32Index = 0; ui32Index < TEST_READERS; ui32Index++) {
+        if(pthread_create(&axReaders[ui32Index].xThread, NULL, prvReader, &axReaders[ui32Index]) != 0) {
+            perror("pthread_create");
+            exit(1);
+        }
+    }
+    if(pthread_create(&xWriter, NULL, prvWriter, NULL) != 0) {
+        perror("pthread_create");
+        exit(1);
+    }
+    pthread_join(xWriter, NULL);
+    for(ui32Index = 0; ui32Index < TEST_READERS; ui32Index++) {
+        pthread_join(axReaders[ui32Index].xThread, NULL);
+        ui32Reads += axReaders[ui32Index].ui32Reads;
+        ui32Torn += axReaders[ui32Index].ui32Torn;
+        ui32Backwards += axReaders[ui32Index].ui32Backwards;
+        ui32Changes += axReaders[ui32Index].ui32Changes;
+    }
+
+    printf("stress: %u writes of %u bytes, %u reads by %u readers, %u of them saw a new write\n",
+           (unsigned)ui32Writes, (unsigned)sizeof(TestRecordType), (unsigned)ui32Reads, (unsigned)TEST_READERS,
+           (unsigned)ui32Changes);
+    prvCheck(ui32Torn == 0U, "stress: no torn snapshot");
+    prvCheck(ui32Backwards == 0U, "stress: snapshots never go back and end on the last write");
+    prvCheck(xLock.ui32Sequence == (2U * ui32Writes), "stress: sequence moves by two per write");
+}
+
+/*------------------------------------------------------------------------------
+ *  Main Function
+ *----------------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+    ui32Writes = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : TEST_DEFAULT_WRITES;
+
+    prvTestSingleThread();
+    prvTestStress();
+
+    printf("%s (%u failed)\n", (ui32Failures == 0U) ? "PASS" : "FAIL", (unsigned)ui32Failures);
+    return (int)ui32Failures;
+}
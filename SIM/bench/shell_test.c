@@ -0,0 +1,230 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Host Simulation
+ *  File        : shell_test.c
+ *  Description : Host test of the command shell line parser over a pipe
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*
+ * Checks SERVICES/SHELL on the host: the word splitting and number parsing
+ * helpers directly, then whole sessions written into a pipe that stands in
+ * for the UART. The read end is drained in small chunks, the way the shell
+ * task drains the UART0 receive ring, so lines arrive split at arbitrary
+ * points. The replies are compared with the expected transcript.
+ *
+ *   gcc -O2 -Wall -I. SIM/bench/shell_test.c SERVICES/SHELL/shell.c -o shell_test
+ *   ./shell_test
+ *
+ * The exit status is the number of failed checks.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/SHELL/shell.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define TEST_OUTPUT_SIZE         (2048U)
+#define TEST_READ_CHUNK          (5U)       /* Smaller than any line, like a few bytes per RX interrupt */
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+static char acOutput[TEST_OUTPUT_SIZE];
+static uint32_t ui32OutputLength;
+static uint32_t ui32Failures;
+
+static const char * const apcLevels[] = { "off", "low", "medium", "high" };
+static uint32_t aui32Levels[2];
+static uint32_t ui32Rate;
+
+/*------------------------------------------------------------------------------
+ *  Command Handlers
+ *----------------------------------------------------------------------------*/
+
+static SHELL_ResultType prvLevel(uint8_t ui8Argc, char * const *apcArgv)
+{
+    uint32_t ui32Seat;
+    uint8_t ui8Level = SHELL_findName(apcArgv[2], apcLevels, 4);
+
+    (void)ui8Argc;
+    if(!SHELL_parseUnsigned(apcArgv[1], &ui32Seat) || (ui32Seat < 1U) || (ui32Seat > 2U) || (ui8Level == 4U)) {
+        return SHELL_BAD_ARGUMENTS;
+    }
+    aui32Levels[ui32Seat - 1U] = ui8Level;
+    return SHELL_OK;
+}
+
+static SHELL_ResultType prvRate(uint8_t ui8Argc, char * const *apcArgv)
+{
+    (void)ui8Argc;
+    return SHELL_parseUnsigned(apcArgv[1], &ui32Rate) ? SHELL_OK : SHELL_BAD_ARGUMENTS;
+}
+
+static SHELL_ResultType prvStats(uint8_t ui8Argc, char * const *apcArgv)
+{
+    (void)ui8Argc;
+    (void)apcArgv;
+    return SHELL_OK;
+}
+
+static const SHELL_CommandType axCommands[] = {
+    { "level", "<seat> <off|low|medium|high>", 2, 2, prvLevel },
+    { "rate",  "<ms>",                         1, 1, prvRate },
+    { "stats", "",                             0, 0, prvStats }
+};
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static void prvCapture(const char *pcText, uint32_t ui32Length)
+{
+    if(ui32Length > (TEST_OUTPUT_SIZE - 1U - ui32OutputLength)) {
+        ui32Length = TEST_OUTPUT_SIZE - 1U - ui32OutputLength;
+    }
+    memcpy(&acOutput[ui32OutputLength], pcText, ui32Length);
+    ui32OutputLength += ui32Length;
+    acOutput[ui32OutputLength] = '\0';
+}
+
+static void prvCheck(int iCondition, const char *pcWhat)
+{
+    if(!iCondition) {
+        printf("FAIL: %s\n", pcWhat);
+        ui32Failures++;
+    }
+}
+
+/* Writes the input into a pipe and feeds the shell from its read end, returns the transcript */
+static const char *prvSession(const char *pcInput)
+{
+    SHELL_Type xShell;
+    uint8_t aui8Chunk[TEST_READ_CHUNK];
+    int aiPipe[2];
+    ssize_t iCount;
+
+    ui32OutputLength = 0;
+    acOutput[0] = '\0';
+    SHELL_init(&xShell, axCommands, sizeof(axCommands) / sizeof(axCommands[0]), prvCapture);
+
+    if(pipe(aiPipe) != 0) {
+        perror("pipe");
+        ui32Failures++;
+        return acOutput;
+    }
+    // Sessions are far below the pipe capacity, so writing everything first cannot block
+    if(write(aiPipe[1], pcInput, strlen(pcInput)) != (ssize_t)strlen(pcInput)) {
+        perror("write");
+        ui32Failures++;
+    }
+    close(aiPipe[1]);
+
+    while((iCount = read(aiPipe[0], aui8Chunk, sizeof(aui8Chunk))) > 0) {
+        SHELL_input(&xShell, aui8Chunk, (uint32_t)iCount);
+    }
+    close(aiPipe[0]);
+
+    return acOutput;
+}
+
+static void prvExpectSession(const char *pcName, const char *pcInput, const char *pcExpected)
+{
+    const char *pcOutput = prvSession(pcInput);
+
+    if(strcmp(pcOutput, pcExpected) != 0) {
+        printf("FAIL: %s\n--- expected\n%s--- got\n%s---\n", pcName, pcExpected, pcOutput);
+        ui32Failures++;
+    }
+}
+
+/*------------------------------------------------------------------------------
+ *  Tests
+ *----------------------------------------------------------------------------*/
+
+static void prvTestTokenize(void)
+{
+    char acLine[] = "  level\t2   high ";
+    char acFull[] = "a b c d e";
+    char acBlank[] = " \t ";
+    char *apcArgv[SHELL_MAX_ARGS];
+
+    prvCheck(SHELL_tokenize(acLine, apcArgv, SHELL_MAX_ARGS) == 3, "tokenize: word count");
+    prvCheck(strcmp(apcArgv[0], "level") == 0, "tokenize: first word");
+    prvCheck(strcmp(apcArgv[1], "2") == 0, "tokenize: tab separator");
+    prvCheck(strcmp(apcArgv[2], "high") == 0, "tokenize: trailing space");
+    prvCheck(SHELL_tokenize(acFull, apcArgv, SHELL_MAX_ARGS) == SHELL_MAX_ARGS + 1, "tokenize: too many words");
+    prvCheck(SHELL_tokenize(acBlank, apcArgv, SHELL_MAX_ARGS) == 0, "tokenize: blank line");
+}
+
+static void prvTestParseUnsigned(void)
+{
+    uint32_t ui32Value = 7;
+
+    prvCheck(SHELL_parseUnsigned("0", &ui32Value) && (ui32Value == 0), "parse: zero");
+    prvCheck(SHELL_parseUnsigned("1000", &ui32Value) && (ui32Value == 1000), "parse: 1000");
+    prvCheck(SHELL_parseUnsigned("4294967295", &ui32Value) && (ui32Value == 4294967295UL), "parse: largest");
+    prvCheck(!SHELL_parseUnsigned("4294967296", &ui32Value), "parse: overflow");
+    prvCheck(!SHELL_parseUnsigned("", &ui32Value), "parse: empty");
+    prvCheck(!SHELL_parseUnsigned("-1", &ui32Value), "parse: sign");
+    prvCheck(!SHELL_parseUnsigned("12a", &ui32Value), "parse: trailing letter");
+    prvCheck(SHELL_findName("HIGH", apcLevels, 4) == 3, "find: case");
+    prvCheck(SHELL_findName("hi", apcLevels, 4) == 4, "find: prefix is no match");
+}
+
+static void prvTestSessions(void)
+{
+    char acLong[SHELL_LINE_MAX_LENGTH + 16];
+
+    prvExpectSession("commands", "level 2 high\r\nrate 250\nstats\r\n",
+                     "ok\r\nok\r\nok\r\n");
+    prvCheck((aui32Levels[1] == 3) && (aui32Levels[0] == 0), "commands: level applied");
+    prvCheck(ui32Rate == 250, "commands: rate applied");
+
+    prvExpectSession("bad arguments", "level 3 low\nlevel 1\nrate fast\n",
+                     "usage: level <seat> <off|low|medium|high>\r\n"
+                     "usage: level <seat> <off|low|medium|high>\r\n"
+                     "usage: rate <ms>\r\n");
+
+    prvExpectSession("unknown and empty lines", "\r\n\r\n  \nreboot\n",
+                     "error: unknown command, try help\r\n");
+
+    prvExpectSession("too many words", "level 1 low now please\n",
+                     "error: too many arguments\r\n");
+
+    prvExpectSession("help", "HELP\n",
+                     "help\r\nlevel <seat> <off|low|medium|high>\r\nrate <ms>\r\nstats\r\n");
+
+    prvExpectSession("backspace and noise", "ratx\b\x7F" "te\x01 10\x1b" "0\n",
+                     "ok\r\n");
+    prvCheck(ui32Rate == 100, "backspace and noise: rate applied");
+
+    // A line one character too long is dropped whole, the next line is parsed normally
+    memset(acLong, 'x', SHELL_LINE_MAX_LENGTH + 1);
+    strcpy(&acLong[SHELL_LINE_MAX_LENGTH + 1], "\nrate 5\n");
+    prvExpectSession("long line", acLong, "error: line too long\r\nok\r\n");
+    prvCheck(ui32Rate == 5, "long line: next line applied");
+
+    // No terminator yet: nothing runs
+    prvExpectSession("partial line", "rate 9", "");
+    prvCheck(ui32Rate == 5, "partial line: not applied");
+}
+
+/*------------------------------------------------------------------------------
+ *  Main Function
+ *----------------------------------------------------------------------------*/
+int main(void)
+{
+    prvTestTokenize();
+    prvTestParseUnsigned();
+    prvTestSessions();
+
+    printf("%s (%u failed)\n", (ui32Failures == 0U) ? "PASS" : "FAIL", (unsigned)ui32Failures);
+    return (int)ui32Failures;
+}
@@ -0,0 +1,191 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Host Simulation
+ *  File        : spsc_ring_test.c
+ *  Description : Two-thread stress test of the lock-free SPSC ring
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*
+ * Checks SERVICES/SPSC_RING on the host: the full and empty edges on one
+ * thread, then a producer thread and a consumer thread running flat out on
+ * different cores, the way the ADC interrupt and a seat task share a ring
+ * on target but with real concurrency. The ring is kept small so the free
+ * running indices wrap the storage millions of times. Every element carries
+ * its sequence number in three words; the consumer checks that each one
+ * arrives exactly once, in order and not torn. A side that finds the ring
+ * full or empty yields, so the test also finishes on a single core.
+ *
+ *   gcc -O2 -Wall -pthread -I. SIM/bench/spsc_ring_test.c SERVICES/SPSC_RING/spsc_ring.c -o spsc_ring_test
+ *   ./spsc_ring_test [elements]
+ *
+ * The exit status is the number of failed checks.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/SPSC_RING/spsc_ring.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define TEST_RING_CAPACITY       (8U)
+#define TEST_DEFAULT_ELEMENTS    (5000000UL)
+#define TEST_CHECK_WORD          (0xA5A5A5A5UL)
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+typedef struct {
+    uint32_t ui32Sequence;
+    uint32_t ui32Inverse;           /* ~sequence */
+    uint32_t ui32Mixed;             /* sequence ^ TEST_CHECK_WORD */
+} TestElementType;
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+static TestElementType axStorage[TEST_RING_CAPACITY];
+static SPSC_RingType xRing;
+static uint32_t ui32Elements;
+static uint32_t ui32Failures;
+
+/* Written by one thread each, read after the join */
+static uint32_t ui32ProducerFull;
+static uint32_t ui32ConsumerEmpty;
+static uint32_t ui32OutOfOrder;
+static uint32_t ui32Torn;
+static uint32_t ui32Received;
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static void prvCheck(int iCondition, const char *pcWhat)
+{
+    if(!iCondition) {
+        printf("FAIL: %s\n", pcWhat);
+        ui32Failures++;
+    }
+}
+
+static TestElementType prvElement(uint32_t ui32Sequence)
+{
+    TestElementType xElement = { ui32Sequence, ~ui32Sequence, ui32Sequence ^ TEST_CHECK_WORD };
+
+    return xElement;
+}
+
+static void *prvProducer(void *pvArgument)
+{
+    uint32_t ui32Sequence;
+
+    (void)pvArgument;
+    for(ui32Sequence = 0; ui32Sequence < ui32Elements; ui32Sequence++) {
+        TestElementType xElement = prvElement(ui32Sequence);
+
+        // A full ring drops on target; here the producer retries so every element must come out
+        while(!SPSC_push(&xRing, &xElement)) {
+            ui32ProducerFull++;
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *prvConsumer(void *pvArgument)
+{
+    TestElementType xElement;
+    uint32_t ui32Expected = 0;
+
+    (void)pvArgument;
+    while(ui32Expected < ui32Elements) {
+        if(!SPSC_pop(&xRing, &xElement)) {
+            ui32ConsumerEmpty++;
+            sched_yield();
+            continue;
+        }
+        if((xElement.ui32Inverse != ~xElement.ui32Sequence) ||
+           (xElement.ui32Mixed != (xElement.ui32Sequence ^ TEST_CHECK_WORD))) {
+            ui32Torn++;
+        }
+        if(xElement.ui32Sequence != ui32Expected) {
+            // Lost (skipped ahead) or duplicated (behind): resynchronize to report each fault once
+            ui32OutOfOrder++;
+        }
+        ui32Expected = xElement.ui32Sequence + 1U;
+        ui32Received++;
+    }
+    return NULL;
+}
+
+/*------------------------------------------------------------------------------
+ *  Tests
+ *----------------------------------------------------------------------------*/
+
+static void prvTestEdges(void)
+{
+    TestElementType xElement;
+    uint32_t ui32Index;
+
+    SPSC_init(&xRing, axStorage, sizeof(TestElementType), TEST_RING_CAPACITY);
+    prvCheck(!SPSC_pop(&xRing, &xElement), "edges: empty ring");
+
+    // Indices just below the wrap of 32 bits, the count must stay right across it
+    xRing.ui32Head = 0xFFFFFFFCUL;
+    xRing.ui32Tail = 0xFFFFFFFCUL;
+    for(ui32Index = 0; ui32Index < TEST_RING_CAPACITY; ui32Index++) {
+        xElement = prvElement(ui32Index);
+        prvCheck(SPSC_push(&xRing, &xElement), "edges: push up to capacity");
+    }
+    xElement = prvElement(99);
+    prvCheck(!SPSC_push(&xRing, &xElement), "edges: full ring refuses");
+    prvCheck(SPSC_getCount(&xRing) == TEST_RING_CAPACITY, "edges: count across the index wrap");
+
+    for(ui32Index = 0; ui32Index < TEST_RING_CAPACITY; ui32Index++) {
+        prvCheck(SPSC_pop(&xRing, &xElement) && (xElement.ui32Sequence == ui32Index), "edges: FIFO order");
+    }
+    prvCheck(!SPSC_pop(&xRing, &xElement), "edges: empty again");
+}
+
+static void prvTestStress(void)
+{
+    pthread_t xProducer;
+    pthread_t xConsumer;
+
+    SPSC_init(&xRing, axStorage, sizeof(TestElementType), TEST_RING_CAPACITY);
+    if((pthread_create(&xConsumer, NULL, prvConsumer, NULL) != 0) ||
+       (pthread_create(&xProducer, NULL, prvProducer, NULL) != 0)) {
+        perror("pthread_create");
+        exit(1);
+    }
+    pthread_join(xProducer, NULL);
+    pthread_join(xConsumer, NULL);
+
+    printf("stress: %u elements, %u wraps, producer found the ring full %u times, consumer empty %u times\n",
+           (unsigned)ui32Received, (unsigned)(ui32Elements / TEST_RING_CAPACITY), (unsigned)ui32ProducerFull,
+           (unsigned)ui32ConsumerEmpty);
+    prvCheck(ui32Received == ui32Elements, "stress: nothing lost or duplicated");
+    prvCheck(ui32OutOfOrder == 0U, "stress: in order");
+    prvCheck(ui32Torn == 0U, "stress: no torn element");
+    prvCheck(SPSC_getCount(&xRing) == 0U, "stress: ring empty at the end");
+}
+
+/*------------------------------------------------------------------------------
+ *  Main Function
+ *----------------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+    ui32Elements = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : TEST_DEFAULT_ELEMENTS;
+
+    prvTestEdges();
+    prvTestStress();
+
+    printf("%s (%u failed)\n", (ui32Failures == 0U) ? "PASS" : "FAIL", (unsigned)ui32Failures);
+    return (int)ui32Failures;
+}
@@ -0,0 +1,306 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Host Simulation
+ *  File        : status_frame_bench.c
+ *  Description : Host microbenchmark of the display task status frame formatting
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*
+ * Compares the cost per frame of the two ways the display task has built its
+ * status report:
+ *  - string path: a switch per level/state name and UART0_SendInteger style
+ *    conversion (one 64-bit division per digit), every byte rewritten each frame
+ *  - status frame: SERVICES/STATUS_FRAME layout done once, lookup table names,
+ *    digit pair conversion, only changed slots rewritten
+ * Both render into a RAM buffer, the transmit itself is left out. The seat
+ * values follow a recorded-like pattern: temperatures drift by one degree
+ * every few frames, duties move most frames, levels change rarely.
+ *
+ *   gcc -O2 -I. SIM/bench/status_frame_bench.c SERVICES/STATUS_FRAME/status_frame.c -o status_frame_bench
+ *   ./status_frame_bench [frames]
+ *
+ * Cycles are read from the x86 time stamp counter where available, the time
+ * per frame is printed on every host.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/STATUS_FRAME/status_frame.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC    1
+#else
+#define BENCH_HAS_TSC    0
+#endif
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define BENCH_SEATS              (2U)
+#define BENCH_FRAME_SIZE         ((80U * BENCH_SEATS) + 48U)
+#define BENCH_DEFAULT_FRAMES     (1000000UL)
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+typedef struct {
+    uint8_t ui8TempValueC;
+    uint8_t ui8Level;
+    uint8_t ui8HeaterState;
+    uint8_t ui8HeaterDuty;
+} BenchSeatType;
+
+typedef struct {
+    STATUS_FRAME_FieldType xTemp;
+    STATUS_FRAME_FieldType xLevel;
+    STATUS_FRAME_FieldType xHeater;
+    STATUS_FRAME_FieldType xDuty;
+} BenchFieldsType;
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+static uint8_t aui8StringFrame[BENCH_FRAME_SIZE];
+static uint32_t ui32StringLength;
+
+static uint8_t aui8StatusFrame[BENCH_FRAME_SIZE];
+static STATUS_FRAME_Type xStatusFrame;
+static BenchFieldsType axFields[BENCH_SEATS];
+
+static const char * const apcNames[] = { "OFF", "LOW", "MEDIUM", "HIGH" };
+
+/* Keeps the compiler from dropping either formatter */
+static volatile uint32_t ui32Sink;
+
+/*------------------------------------------------------------------------------
+ *  String path
+ *----------------------------------------------------------------------------*/
+static void prvStringSend(const char *pcString)
+{
+    while((*pcString != '\0') && (ui32StringLength < BENCH_FRAME_SIZE)) {
+        aui8StringFrame[ui32StringLength++] = (uint8_t)*pcString++;
+    }
+}
+
+/* Same conversion as UART0_SendInteger */
+static void prvStringSendInteger(int64_t sNumber)
+{
+    char acDigits[22];
+    int8_t uCounter = 0;
+    int8_t uIndex;
+    char acText[22];
+
+    if(sNumber < 0) {
+        sNumber *= -1;
+    }
+    do {
+        acDigits[uCounter++] = (char)(sNumber % 10 + '0');
+        sNumber /= 10;
+    } while(sNumber != 0);
+
+    for(uIndex = 0; uIndex < uCounter; uIndex++) {
+        acText[uIndex] = acDigits[uCounter - 1 - uIndex];
+    }
+    acText[uCounter] = '\0';
+    prvStringSend(acText);
+}
+
+static void prvStringSendName(uint8_t ui8Value)
+{
+    switch(ui8Value) {
+        case 1:   prvStringSend("LOW");    break;
+        case 2:   prvStringSend("MEDIUM"); break;
+        case 3:   prvStringSend("HIGH");   break;
+        default:  prvStringSend("OFF");    break;
+    }
+}
+
+static void prvStringSendLabel(uint8_t ui8Seat, const char *pcField)
+{
+    if(ui8Seat != 0) {
+        prvStringSend(" | ");
+    }
+    prvStringSend("Seat");
+    prvStringSendInteger(ui8Seat + 1U);
+    prvStringSend(" ");
+    prvStringSend(pcField);
+}
+
+static void prvStringFrame(const BenchSeatType *pxSeats)
+{
+    uint8_t ui8Seat;
+
+    ui32StringLength = 0;
+    for(ui8Seat = 0; ui8Seat < BENCH_SEATS; ui8Seat++) {
+        prvStringSendLabel(ui8Seat, "Temp: ");
+        prvStringSendInteger(pxSeats[ui8Seat].ui8TempValueC);
+        prvStringSend("\xb0" "C");
+    }
+    prvStringSend("\r\n");
+    for(ui8Seat = 0; ui8Seat < BENCH_SEATS; ui8Seat++) {
+        prvStringSendLabel(ui8Seat, "Level: ");
+        prvStringSendName(pxSeats[ui8Seat].ui8Level);
+    }
+    prvStringSend("\r\n");
+    for(ui8Seat = 0; ui8Seat < BENCH_SEATS; ui8Seat++) {
+        prvStringSendLabel(ui8Seat, "Heater: ");
+        prvStringSendName(pxSeats[ui8Seat].ui8HeaterState);
+        prvStringSend(" (");
+        prvStringSendInteger(pxSeats[ui8Seat].ui8HeaterDuty);
+        prvStringSend("%)");
+    }
+    prvStringSend("\r\n");
+    prvStringSend("----------------------------------------\r\n");
+
+    ui32Sink += ui32StringLength;
+}
+
+/*------------------------------------------------------------------------------
+ *  Status frame path
+ *----------------------------------------------------------------------------*/
+static void prvStatusLabel(uint8_t ui8Seat, const char *pcField)
+{
+    if(ui8Seat != 0) {
+        STATUS_FRAME_appendText(&xStatusFrame, " | ");
+    }
+    STATUS_FRAME_appendText(&xStatusFrame, "Seat");
+    STATUS_FRAME_appendNumber(&xStatusFrame, ui8Seat + 1U);
+    STATUS_FRAME_appendText(&xStatusFrame, " ");
+    STATUS_FRAME_appendText(&xStatusFrame, pcField);
+}
+
+static void prvStatusLayout(void)
+{
+    uint8_t ui8Seat;
+
+    STATUS_FRAME_init(&xStatusFrame, aui8StatusFrame, sizeof(aui8StatusFrame));
+    for(ui8Seat = 0; ui8Seat < BENCH_SEATS; ui8Seat++) {
+        prvStatusLabel(ui8Seat, "Temp: ");
+        STATUS_FRAME_appendField(&xStatusFrame, &axFields[ui8Seat].xTemp, 3);
+        STATUS_FRAME_appendText(&xStatusFrame, "\xb0" "C");
+    }
+    STATUS_FRAME_appendText(&xStatusFrame, "\r\n");
+    for(ui8Seat = 0; ui8Seat < BENCH_SEATS; ui8Seat++) {
+        prvStatusLabel(ui8Seat, "Level: ");
+        STATUS_FRAME_appendField(&xStatusFrame, &axFields[ui8Seat].xLevel, 6);
+    }
+    STATUS_FRAME_appendText(&xStatusFrame, "\r\n");
+    for(ui8Seat = 0; ui8Seat < BENCH_SEATS; ui8Seat++) {
+        prvStatusLabel(ui8Seat, "Heater: ");
+        STATUS_FRAME_appendField(&xStatusFrame, &axFields[ui8Seat].xHeater, 6);
+        STATUS_FRAME_appendText(&xStatusFrame, " (");
+        STATUS_FRAME_appendField(&xStatusFrame, &axFields[ui8Seat].xDuty, 3);
+        STATUS_FRAME_appendText(&xStatusFrame, "%)");
+    }
+    STATUS_FRAME_appendText(&xStatusFrame, "\r\n");
+    STATUS_FRAME_appendText(&xStatusFrame, "----------------------------------------\r\n");
+}
+
+static void prvStatusFrame(const BenchSeatType *pxSeats)
+{
+    uint8_t ui8Seat;
+
+    for(ui8Seat = 0; ui8Seat < BENCH_SEATS; ui8Seat++) {
+        STATUS_FRAME_setNumber(&xStatusFrame, &axFields[ui8Seat].xTemp, pxSeats[ui8Seat].ui8TempValueC);
+        STATUS_FRAME_setName(&xStatusFrame, &axFields[ui8Seat].xLevel, apcNames, pxSeats[ui8Seat].ui8Level);
+        STATUS_FRAME_setName(&xStatusFrame, &axFields[ui8Seat].xHeater, apcNames, pxSeats[ui8Seat].ui8HeaterState);
+        STATUS_FRAME_setNumber(&xStatusFrame, &axFields[ui8Seat].xDuty, pxSeats[ui8Seat].ui8HeaterDuty);
+    }
+
+    ui32Sink += xStatusFrame.ui32Length;
+}
+
+/*------------------------------------------------------------------------------
+ *  Benchmark
+ *----------------------------------------------------------------------------*/
+
+/* Seat values of frame ui32Frame, the same sequence for both paths */
+static void prvSeatValues(uint32_t ui32Frame, BenchSeatType *pxSeats)
+{
+    uint8_t ui8Seat;
+
+    for(ui8Seat = 0; ui8Seat < BENCH_SEATS; ui8Seat++) {
+        uint32_t ui32Phase = ui32Frame + (ui8Seat * 37U);
+
+        pxSeats[ui8Seat].ui8TempValueC = (uint8_t)(20U + ((ui32Phase / 4U) % 20U));
+        pxSeats[ui8Seat].ui8Level = (uint8_t)((ui32Phase / 64U) % 4U);
+        pxSeats[ui8Seat].ui8HeaterState = (uint8_t)((ui32Phase / 16U) % 4U);
+        pxSeats[ui8Seat].ui8HeaterDuty = (uint8_t)((ui32Phase * 7U) % 101U);
+    }
+}
+
+static uint64_t prvNowNs(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return ((uint64_t)xNow.tv_sec * 1000000000ULL) + (uint64_t)xNow.tv_nsec;
+}
+
+static uint64_t prvCycles(void)
+{
+#if BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static void prvRun(const char *pcName, void (*pfFrame)(const BenchSeatType *), uint32_t ui32Frames)
+{
+    BenchSeatType axSeats[BENCH_SEATS];
+    uint64_t ui64StartNs;
+    uint64_t ui64StartCycles;
+    uint64_t ui64ElapsedNs;
+    uint64_t ui64ElapsedCycles;
+    uint32_t ui32Frame;
+
+    ui64StartNs = prvNowNs();
+    ui64StartCycles = prvCycles();
+    for(ui32Frame = 0; ui32Frame < ui32Frames; ui32Frame++) {
+        prvSeatValues(ui32Frame, axSeats);
+        pfFrame(axSeats);
+    }
+    ui64ElapsedCycles = prvCycles() - ui64StartCycles;
+    ui64ElapsedNs = prvNowNs() - ui64StartNs;
+
+    printf("%-14s %8.1f ns/frame", pcName, (double)ui64ElapsedNs / ui32Frames);
+    if(BENCH_HAS_TSC) {
+        printf(" %8.1f cycles/frame", (double)ui64ElapsedCycles / ui32Frames);
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t ui32Frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_FRAMES;
+
+    if(ui32Frames == 0) {
+        fprintf(stderr, "usage: %s [frames]\n", argv[0]);
+        return 1;
+    }
+
+    BenchSeatType axSeats[BENCH_SEATS];
+    uint32_t ui32Frame;
+
+    prvStatusLayout();
+
+    /* Warm up caches and branch predictors on both paths first */
+    for(ui32Frame = 0; ui32Frame < 1000U; ui32Frame++) {
+        prvSeatValues(ui32Frame, axSeats);
+        prvStringFrame(axSeats);
+        prvStatusFrame(axSeats);
+    }
+
+    printf("%u frames, %u and %u bytes\n", (unsigned)ui32Frames,
+           (unsigned)ui32StringLength, (unsigned)xStatusFrame.ui32Length);
+    prvRun("string path", prvStringFrame, ui32Frames);
+    prvRun("status frame", prvStatusFrame, ui32Frames);
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Host Simulation
+ *  File        : temp_cal_bench.c
+ *  Description : Host microbenchmark of the seat sensor temperature conversion
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*
+ * Compares the cost per sample of converting a raw ADC code to a calibrated
+ * seat temperature:
+ *  - float beta: the NTC Beta model evaluated at run time, one logf and two
+ *    divisions per sample, then the trim, as a floating point port would do
+ *  - float linear: the potentiometer scaling and the trim in float
+ *  - lut: HAL/POTS/pots_cal, table interpolation and trim in fixed point
+ * The codes sweep the whole 12-bit range in a scattered order so the table
+ * entries are not all cached in one line. The host has a double precision
+ * FPU and a fast logf, the Cortex-M4F only single precision hardware and
+ * a library logf, so the gap on target is wider than measured here.
+ *
+ *   gcc -O2 -I. SIM/bench/temp_cal_bench.c HAL/POTS/pots_cal.c HAL/POTS/pots_cal_curves.c -lm -o temp_cal_bench
+ *   ./temp_cal_bench [samples]
+ *
+ * Cycles are read from the x86 time stamp counter where available, the time
+ * per sample is printed on every host.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "HAL/POTS/pots.h"
+#include "HAL/POTS/pots_cal.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC    1
+#else
+#define BENCH_HAS_TSC    0
+#endif
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define BENCH_DEFAULT_SAMPLES    (10000000UL)
+#define BENCH_CODE_STRIDE        (1021U)    /* Odd, so the sweep visits every code once per 4096 */
+#define BENCH_KELVIN             (273.15f)
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+static const CAL_ChannelType xChannel = { ai16CalCurveNtc, CAL_GAIN_Q14(1.02), CAL_OFFSET_Q8(-0.5) };
+static const float fGain = 1.02f;
+static const float fOffsetC = -0.5f;
+
+static volatile int32_t i32Sink;
+
+/*------------------------------------------------------------------------------
+ *  Conversions
+ *----------------------------------------------------------------------------*/
+
+static int32_t prvFloatBeta(uint32_t ui32Raw)
+{
+    float fRaw = (float)((ui32Raw == 0U) ? 1U : ui32Raw);
+    float fResistance = (float)CAL_NTC_PULLUP_OHM * fRaw / ((float)POTS_MAX_VALUE - fRaw);
+    float fCelsius = 1.0f / ((1.0f / (25.0f + BENCH_KELVIN)) +
+                             (logf(fResistance / (float)CAL_NTC_R25_OHM) / (float)CAL_NTC_BETA_K)) - BENCH_KELVIN;
+
+    return (int32_t)(((fCelsius * fGain) + fOffsetC) * (1 << CAL_TEMP_FRAC_BITS));
+}
+
+static int32_t prvFloatLinear(uint32_t ui32Raw)
+{
+    float fCelsius = (float)ui32Raw * ((float)POTS_TEMP_MAX_C / (float)POTS_MAX_VALUE);
+
+    return (int32_t)(((fCelsius * fGain) + fOffsetC) * (1 << CAL_TEMP_FRAC_BITS));
+}
+
+static int32_t prvLut(uint32_t ui32Raw)
+{
+    return CAL_toCelsiusQ8(&xChannel, ui32Raw);
+}
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static uint64_t prvNowNs(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return ((uint64_t)xNow.tv_sec * 1000000000ULL) + (uint64_t)xNow.tv_nsec;
+}
+
+static uint64_t prvCycles(void)
+{
+#if BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static void prvRun(const char *pcName, int32_t (*pfConvert)(uint32_t), uint32_t ui32Samples)
+{
+    uint64_t ui64StartNs;
+    uint64_t ui64StartCycles;
+    uint64_t ui64ElapsedNs;
+    uint64_t ui64ElapsedCycles;
+    uint32_t ui32Sample;
+    uint32_t ui32Raw = 0;
+    int32_t i32Sum = 0;
+
+    ui64StartNs = prvNowNs();
+    ui64StartCycles = prvCycles();
+    for(ui32Sample = 0; ui32Sample < ui32Samples; ui32Sample++) {
+        i32Sum += pfConvert(ui32Raw);
+        ui32Raw = (ui32Raw + BENCH_CODE_STRIDE) & (POTS_MAX_VALUE - 1U);
+    }
+    ui64ElapsedCycles = prvCycles() - ui64StartCycles;
+    ui64ElapsedNs = prvNowNs() - ui64StartNs;
+    i32Sink = i32Sum;
+
+    printf("%-14s %8.2f ns/sample", pcName, (double)ui64ElapsedNs / ui32Samples);
+    if(BENCH_HAS_TSC) {
+        printf(" %8.2f cycles/sample", (double)ui64ElapsedCycles / ui32Samples);
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t ui32Samples = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_SAMPLES;
+
+    if(ui32Samples == 0) {
+        fprintf(stderr, "usage: %s [samples]\n", argv[0]);
+        return 1;
+    }
+
+    uint32_t ui32Raw;
+
+    /* Warm up caches and branch predictors on every path first */
+    for(ui32Raw = 0; ui32Raw < POTS_MAX_VALUE; ui32Raw++) {
+        i32Sink = prvFloatBeta(ui32Raw) + prvFloatLinear(ui32Raw) + prvLut(ui32Raw);
+    }
+
+    printf("%u samples\n", (unsigned)ui32Samples);
+    prvRun("float beta", prvFloatBeta, ui32Samples);
+    prvRun("float linear", prvFloatLinear, ui32Samples);
+    prvRun("lut", prvLut, ui32Samples);
+
+    return 0;
+}
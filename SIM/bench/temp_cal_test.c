@@ -0,0 +1,178 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Host Simulation
+ *  File        : temp_cal_test.c
+ *  Description : Host accuracy test of the seat sensor calibration against
+ *                reference curves
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*
+ * Runs HAL/POTS/pots_cal over every raw code 0-4095 and compares it with the
+ * exact curves in double precision:
+ *  - potentiometer curve: bit exact with POTS_RAW_TO_CELSIUS_Q8, the
+ *    conversion it replaces, so the seats keep their behaviour
+ *  - NTC curve: within TEST_NTC_MAX_ERROR_C of the Beta model over the seat
+ *    range, and never rising with the code
+ *  - trim: gain and offset applied with rounding to the nearest 1/256 C
+ *  - codes past full scale read as 4095
+ *
+ *   gcc -O2 -Wall -I. SIM/bench/temp_cal_test.c HAL/POTS/pots_cal.c HAL/POTS/pots_cal_curves.c -lm -o temp_cal_test
+ *   ./temp_cal_test
+ *
+ * The exit status is the number of failed checks.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "HAL/POTS/pots.h"
+#include "HAL/POTS/pots_cal.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define TEST_KELVIN              (273.15)
+#define TEST_Q8_STEP_C           (1.0 / 256.0)
+#define TEST_NTC_MAX_ERROR_C     (0.1)      /* Interpolation plus Q8 rounding */
+#define TEST_NTC_RANGE_MIN_C     (-20.0)    /* Cold start of the bench scenarios */
+#define TEST_NTC_RANGE_MAX_C     (80.0)     /* Well above any seat target */
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+static uint32_t ui32Failures;
+
+static const CAL_ChannelType xPot = { ai16CalCurvePot, CAL_GAIN_Q14(1.0), CAL_OFFSET_Q8(0.0) };
+static const CAL_ChannelType xNtc = { ai16CalCurveNtc, CAL_GAIN_Q14(1.0), CAL_OFFSET_Q8(0.0) };
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static void prvCheck(int iCondition, const char *pcWhat)
+{
+    if(!iCondition) {
+        printf("FAIL: %s\n", pcWhat);
+        ui32Failures++;
+    }
+}
+
+/* Beta model temperature of the divider in pots_cal_curves.h, the code must be inside 1..4095 */
+static double prvNtcReferenceC(uint32_t ui32Raw)
+{
+    double dResistance = CAL_NTC_PULLUP_OHM * (double)ui32Raw / (double)(POTS_MAX_VALUE - ui32Raw);
+
+    return 1.0 / ((1.0 / (25.0 + TEST_KELVIN)) + (log(dResistance / CAL_NTC_R25_OHM) / CAL_NTC_BETA_K))
+           - TEST_KELVIN;
+}
+
+/*------------------------------------------------------------------------------
+ *  Tests
+ *----------------------------------------------------------------------------*/
+
+static void prvTestPot(void)
+{
+    uint32_t ui32Raw;
+    uint32_t ui32Mismatches = 0;
+
+    for(ui32Raw = 0; ui32Raw < POTS_MAX_VALUE; ui32Raw++) {
+        if(CAL_toCelsiusQ8(&xPot, ui32Raw) != POTS_RAW_TO_CELSIUS_Q8(ui32Raw)) {
+            ui32Mismatches++;
+        }
+    }
+    printf("pot: %u codes differ from POTS_RAW_TO_CELSIUS_Q8\n", (unsigned)ui32Mismatches);
+    prvCheck(ui32Mismatches == 0U, "pot: same as POTS_RAW_TO_CELSIUS_Q8");
+}
+
+static void prvTestNtc(void)
+{
+    uint32_t ui32Raw;
+    uint32_t ui32WorstRaw = 0;
+    uint32_t ui32Rises = 0;
+    double dWorst = 0.0;
+
+    for(ui32Raw = 1; ui32Raw < POTS_MAX_VALUE; ui32Raw++) {
+        double dReference = prvNtcReferenceC(ui32Raw);
+        double dError;
+
+        if(CAL_toCelsiusQ8(&xNtc, ui32Raw) > CAL_toCelsiusQ8(&xNtc, ui32Raw - 1U)) {
+            ui32Rises++;
+        }
+        if((dReference < TEST_NTC_RANGE_MIN_C) || (dReference > TEST_NTC_RANGE_MAX_C)) {
+            continue;
+        }
+        dError = fabs((CAL_toCelsiusQ8(&xNtc, ui32Raw) * TEST_Q8_STEP_C) - dReference);
+        if(dError > dWorst) {
+            dWorst = dError;
+            ui32WorstRaw = ui32Raw;
+        }
+    }
+
+    printf("ntc: max error %.3f C at code %u (%.2f C) over %.0f..%.0f C\n", dWorst, (unsigned)ui32WorstRaw,
+           prvNtcReferenceC(ui32WorstRaw), TEST_NTC_RANGE_MIN_C, TEST_NTC_RANGE_MAX_C);
+    prvCheck(dWorst <= TEST_NTC_MAX_ERROR_C, "ntc: error over the seat range");
+    prvCheck(ui32Rises == 0U, "ntc: falls with the code");
+    prvCheck(CAL_toCelsiusQ8(&xNtc, 0) == (CAL_CURVE_MAX_C << CAL_TEMP_FRAC_BITS),
+             "ntc: shorted sensor reads the maximum");
+    prvCheck(CAL_toCelsiusQ8(&xNtc, POTS_MAX_VALUE - 1U) >= (CAL_CURVE_MIN_C * (1 << CAL_TEMP_FRAC_BITS)),
+             "ntc: open sensor stays within the minimum");
+}
+
+static void prvTestTrim(void)
+{
+    static const double adGains[] = { 0.95, 1.0, 1.02, 1.5 };
+    static const double adOffsets[] = { -1.5, 0.0, 0.25, 3.0 };
+    uint32_t ui32Gain;
+    uint32_t ui32Offset;
+    uint32_t ui32Raw;
+    double dWorst = 0.0;
+
+    for(ui32Gain = 0; ui32Gain < (sizeof(adGains) / sizeof(adGains[0])); ui32Gain++) {
+        for(ui32Offset = 0; ui32Offset < (sizeof(adOffsets) / sizeof(adOffsets[0])); ui32Offset++) {
+            CAL_ChannelType xTrimmed = { ai16CalCurveNtc, CAL_GAIN_Q14(adGains[ui32Gain]),
+                                         CAL_OFFSET_Q8(adOffsets[ui32Offset]) };
+
+            for(ui32Raw = 0; ui32Raw < POTS_MAX_VALUE; ui32Raw++) {
+                // Against the gain as stored, its Q14 rounding is a calibration step of its own
+                double dExpected = (CAL_toCelsiusQ8(&xNtc, ui32Raw) * TEST_Q8_STEP_C
+                                    * ((double)xTrimmed.i32GainQ14 / (1 << CAL_GAIN_FRAC_BITS)))
+                                   + adOffsets[ui32Offset];
+                double dError = fabs((CAL_toCelsiusQ8(&xTrimmed, ui32Raw) * TEST_Q8_STEP_C) - dExpected);
+
+                if(dError > dWorst) {
+                    dWorst = dError;
+                }
+            }
+        }
+    }
+
+    printf("trim: max error %.5f C\n", dWorst);
+    prvCheck(dWorst <= (TEST_Q8_STEP_C / 2.0), "trim: rounded to the nearest Q8 step");
+    prvCheck(CAL_OFFSET_Q8(-1.5) == -384, "trim: negative offset rounding");
+}
+
+static void prvTestClamp(void)
+{
+    int32_t i32FullScale = CAL_toCelsiusQ8(&xPot, POTS_MAX_VALUE - 1U);
+
+    prvCheck(CAL_toCelsiusQ8(&xPot, POTS_MAX_VALUE) == i32FullScale, "clamp: 4096");
+    prvCheck(CAL_toCelsiusQ8(&xPot, 0xFFFFFFFFUL) == i32FullScale, "clamp: 0xFFFFFFFF");
+    prvCheck(CAL_toCelsiusQ8(&xNtc, 65535U) == CAL_toCelsiusQ8(&xNtc, POTS_MAX_VALUE - 1U), "clamp: ntc");
+}
+
+/*------------------------------------------------------------------------------
+ *  Main Function
+ *----------------------------------------------------------------------------*/
+int main(void)
+{
+    prvTestPot();
+    prvTestNtc();
+    prvTestTrim();
+    prvTestClamp();
+
+    printf("%s (%u failed)\n", (ui32Failures == 0U) ? "PASS" : "FAIL", (unsigned)ui32Failures);
+    return (int)ui32Failures;
+}
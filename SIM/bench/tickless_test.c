@@ -0,0 +1,216 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Host Simulation
+ *  File        : tickless_test.c
+ *  Description : Host test of the tickless idle sleep length and tick compensation
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*
+ * Checks the arithmetic of SERVICES/TICKLESS on the host with the target's
+ * clock figures (16 MHz, 1 kHz tick, 50 us margin, 32-bit WTimer1A):
+ *  - timer wake: the sleep ends one margin before the last expected tick,
+ *    all but that tick are stepped and SysTick finishes the period in phase
+ *  - short sleeps: no margin below it, and never a zero timer count
+ *  - early wake: an interrupt inside the first period or a later one steps
+ *    the whole periods that passed and keeps the phase
+ *  - overshoot clamp: a sleep running past the expected time steps at most
+ *    ui32ExpectedIdleTicks - 1 ticks and makes the tick due at once
+ *  - timer range clamp: a long idle time is cut to the timer range, 32 and
+ *    16 bits, and a sleep of that length still keeps the phase
+ *  - the sleep counters
+ *
+ *   gcc -O2 -Wall -DSIMULATION -I. SIM/bench/tickless_test.c SERVICES/TICKLESS/tickless.c -o tickless_test
+ *   ./tickless_test
+ *
+ * The exit status is the number of failed checks.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "SERVICES/TICKLESS/tickless.h"
+#include <stdint.h>
+#include <stdio.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define TEST_CPU_CLOCK_HZ        (16000000UL)
+#define TEST_TICK_RATE_HZ        (1000UL)
+#define TEST_CYCLES_PER_TICK     (TEST_CPU_CLOCK_HZ / TEST_TICK_RATE_HZ)
+#define TEST_MARGIN_CYCLES       ((TEST_CPU_CLOCK_HZ / 1000000UL) * TICKLESS_WAKEUP_MARGIN_US)
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+
+/* Same figures as tickless_port.c builds from FreeRTOSConfig.h */
+static const TICKLESS_ConfigType xConfig = {
+    TEST_CYCLES_PER_TICK,
+    0xFFFFFFFFUL,
+    TEST_MARGIN_CYCLES
+};
+
+/* A 16-bit wakeup timer, to reach the range clamp with a short idle time */
+static const TICKLESS_ConfigType xShortTimerConfig = {
+    TEST_CYCLES_PER_TICK,
+    0xFFFFUL,
+    TEST_MARGIN_CYCLES
+};
+
+static uint32_t ui32Failures;
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static void prvCheck(int iCondition, const char *pcWhat)
+{
+    if(!iCondition) {
+        printf("FAIL: %s\n", pcWhat);
+        ui32Failures++;
+    }
+}
+
+/* The stepped ticks and the new SysTick period account for the whole sleep, so the tick keeps its phase */
+static int prvInPhase(uint32_t ui32CyclesToNextTick, uint32_t ui32ElapsedCycles, const TICKLESS_StepType *psStep)
+{
+    return ((uint64_t)ui32ElapsedCycles + psStep->ui32CyclesToNextTick) ==
+           ((uint64_t)ui32CyclesToNextTick + ((uint64_t)psStep->ui32CompletedTicks * TEST_CYCLES_PER_TICK));
+}
+
+/*------------------------------------------------------------------------------
+ *  Tests
+ *----------------------------------------------------------------------------*/
+
+static void prvTestTimerWake(void)
+{
+    TICKLESS_StepType xStep;
+    uint32_t ui32Delay;
+
+    // 10000 cycles left in the current period, the kernel has work 5 ticks from now
+    ui32Delay = TICKLESS_wakeupDelay(&xConfig, 10000U, 5U);
+    prvCheck(ui32Delay == (10000U + (4U * TEST_CYCLES_PER_TICK) - TEST_MARGIN_CYCLES),
+             "timer: wakes one margin before the last tick");
+
+    TICKLESS_compensate(&xConfig, 10000U, ui32Delay, 5U, &xStep);
+    prvCheck(xStep.ui32CompletedTicks == 4U, "timer: all but the last tick stepped");
+    prvCheck(xStep.ui32CyclesToNextTick == TEST_MARGIN_CYCLES, "timer: SysTick runs out the margin");
+    prvCheck(prvInPhase(10000U, ui32Delay, &xStep), "timer: in phase");
+
+    // One expected tick: the sleep stays inside the current period
+    ui32Delay = TICKLESS_wakeupDelay(&xConfig, 10000U, 1U);
+    prvCheck(ui32Delay == (10000U - TEST_MARGIN_CYCLES), "timer: single tick sleep");
+    TICKLESS_compensate(&xConfig, 10000U, ui32Delay, 1U, &xStep);
+    prvCheck((xStep.ui32CompletedTicks == 0U) && (xStep.ui32CyclesToNextTick == TEST_MARGIN_CYCLES),
+             "timer: single tick sleep resumes the same period");
+}
+
+static void prvTestShortSleep(void)
+{
+    prvCheck(TICKLESS_wakeupDelay(&xConfig, TEST_MARGIN_CYCLES, 1U) == TEST_MARGIN_CYCLES,
+             "short: no margin taken from a sleep of one margin");
+    prvCheck(TICKLESS_wakeupDelay(&xConfig, 100U, 1U) == 100U, "short: sleeps until the tick itself");
+    prvCheck(TICKLESS_wakeupDelay(&xConfig, 0U, 1U) == 1U, "short: never a zero timer count");
+}
+
+static void prvTestEarlyWake(void)
+{
+    TICKLESS_StepType xStep;
+
+    // A button press 4000 cycles in, still inside the first period
+    TICKLESS_compensate(&xConfig, 10000U, 4000U, 5U, &xStep);
+    prvCheck((xStep.ui32CompletedTicks == 0U) && (xStep.ui32CyclesToNextTick == 6000U),
+             "early: woken in the first period");
+
+    // 30000 cycles in: the first period and one full period passed
+    TICKLESS_compensate(&xConfig, 10000U, 30000U, 5U, &xStep);
+    prvCheck(xStep.ui32CompletedTicks == 2U, "early: whole periods stepped");
+    prvCheck(xStep.ui32CyclesToNextTick == 12000U, "early: rest of the period");
+    prvCheck(prvInPhase(10000U, 30000U, &xStep), "early: in phase");
+
+    // Exactly on a tick boundary: that tick is stepped and a full period follows
+    TICKLESS_compensate(&xConfig, 10000U, 10000U + TEST_CYCLES_PER_TICK, 5U, &xStep);
+    prvCheck((xStep.ui32CompletedTicks == 2U) && (xStep.ui32CyclesToNextTick == TEST_CYCLES_PER_TICK),
+             "early: woken on a tick boundary");
+
+    // A few cycles short of the tick: SysTick gets the shortest period it is given
+    TICKLESS_compensate(&xConfig, 10000U, 10000U - 5U, 5U, &xStep);
+    prvCheck((xStep.ui32CompletedTicks == 0U) && (xStep.ui32CyclesToNextTick == TICKLESS_MIN_RELOAD_CYCLES),
+             "early: shortest SysTick period");
+}
+
+static void prvTestOvershoot(void)
+{
+    TICKLESS_StepType xStep;
+    uint32_t ui32Elapsed = 10000U + (4U * TEST_CYCLES_PER_TICK) + 20000U;
+
+    // Woken late, past the last expected tick: the kernel takes that tick from the interrupt
+    TICKLESS_compensate(&xConfig, 10000U, ui32Elapsed, 5U, &xStep);
+    prvCheck(xStep.ui32CompletedTicks == 4U, "overshoot: at most expected - 1 ticks stepped");
+    prvCheck(xStep.ui32CyclesToNextTick == TICKLESS_MIN_RELOAD_CYCLES, "overshoot: tick due at once");
+
+    TICKLESS_compensate(&xConfig, 10000U, 12000U, 1U, &xStep);
+    prvCheck((xStep.ui32CompletedTicks == 0U) && (xStep.ui32CyclesToNextTick == TICKLESS_MIN_RELOAD_CYCLES),
+             "overshoot: nothing stepped for a single tick sleep");
+
+    TICKLESS_compensate(&xConfig, 10000U, 0xFFFFFFFFUL, 5U, &xStep);
+    prvCheck((xStep.ui32CompletedTicks == 4U) && (xStep.ui32CyclesToNextTick == TICKLESS_MIN_RELOAD_CYCLES),
+             "overshoot: longest measurable sleep");
+}
+
+static void prvTestTimerRange(void)
+{
+    TICKLESS_StepType xStep;
+    uint32_t ui32Delay;
+
+    // portMAX_DELAY idle time: the 64-bit sum must not wrap before the clamp
+    ui32Delay = TICKLESS_wakeupDelay(&xConfig, 10000U, 0xFFFFFFFFUL);
+    prvCheck(ui32Delay == 0xFFFFFFFFUL, "range: 32-bit timer clamped");
+    TICKLESS_compensate(&xConfig, 10000U, ui32Delay, 0xFFFFFFFFUL, &xStep);
+    prvCheck(xStep.ui32CompletedTicks == (1U + ((0xFFFFFFFFUL - 10000U) / TEST_CYCLES_PER_TICK)),
+             "range: 32-bit sleep steps the ticks that passed");
+    prvCheck(prvInPhase(10000U, ui32Delay, &xStep), "range: 32-bit sleep in phase");
+
+    ui32Delay = TICKLESS_wakeupDelay(&xShortTimerConfig, 10000U, 10U);
+    prvCheck(ui32Delay == 0xFFFFU, "range: 16-bit timer clamped");
+    TICKLESS_compensate(&xShortTimerConfig, 10000U, ui32Delay, 10U, &xStep);
+    prvCheck(xStep.ui32CompletedTicks == 4U, "range: 16-bit sleep steps the ticks that passed");
+    prvCheck(prvInPhase(10000U, ui32Delay, &xStep), "range: 16-bit sleep in phase");
+
+    prvCheck(TICKLESS_wakeupDelay(&xShortTimerConfig, 10000U, 4U) == (10000U + (3U * TEST_CYCLES_PER_TICK) -
+             TEST_MARGIN_CYCLES), "range: sleep within range untouched");
+}
+
+static void prvTestStats(void)
+{
+    TICKLESS_StatsType xStats;
+
+    TICKLESS_recordSleep(1000U, 1U);
+    TICKLESS_recordSleep(0xFFFFFFFFUL, 1U);
+    TICKLESS_recordSleep(500U, 0U);
+    TICKLESS_recordAbort();
+    TICKLESS_getStats(&xStats);
+
+    prvCheck(xStats.ui32SleepCount == 3U, "stats: sleeps");
+    prvCheck(xStats.ui32TimerWakeups == 2U, "stats: timer wakeups");
+    prvCheck(xStats.ui32InterruptWakeups == 1U, "stats: interrupt wakeups");
+    prvCheck(xStats.ui32AbortCount == 1U, "stats: aborts");
+    prvCheck(xStats.ui64SleepCycles == (1500ULL + 0xFFFFFFFFULL), "stats: time asleep past 32 bits");
+}
+
+/*------------------------------------------------------------------------------
+ *  Main Function
+ *----------------------------------------------------------------------------*/
+int main(void)
+{
+    prvTestTimerWake();
+    prvTestShortSleep();
+    prvTestEarlyWake();
+    prvTestOvershoot();
+    prvTestTimerRange();
+    prvTestStats();
+
+    printf("%s (%u failed)\n", (ui32Failures == 0U) ? "PASS" : "FAIL", (unsigned)ui32Failures);
+    return (int)ui32Failures;
+}
@@ -0,0 +1,279 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Host Simulation
+ *  File        : uart0_baud_test.c
+ *  Description : Host test of the UART0 baud rate divisors and range checks
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*
+ * Builds MCAL/UART/uart0.c for the host with SIMULATION defined, with a plain
+ * register bank standing in for SIM_RegAccess, and runs UART0_Init over:
+ *  - the supported table (9600 to 1 Mbaud, 1.5 and 2 Mbaud with HSE): IBRD,
+ *    FBRD and HSE against the datasheet formula, BRD = clock / (16 or 8 x
+ *    baud) with FBRD = round(fraction x 64), and the error within 2 %
+ *  - the rejections: no configuration, 0 baud, below the 65535 IBRD limit,
+ *    above the clock divider with and without HSE; UART0 is left untouched,
+ *    and the last accepted rate next to each limit
+ *  - a sweep from 10 baud to 2.1 Mbaud, where a rate must be accepted exactly
+ *    when its divisor is in range and then land within the error budget: half
+ *    a 1/64 step at IBRD 1 is 0.8 %, so the 2 % check never rejects a rate the
+ *    divider can reach
+ *
+ *   gcc -O2 -Wall -DSIMULATION -I. -IMCAL -IMCAL/UDMA -ISIM -I<std_types.h dir> \
+ *       SIM/bench/uart0_baud_test.c MCAL/UART/uart0.c MCAL/UDMA/udma.c -o uart0_baud_test
+ *   ./uart0_baud_test
+ *
+ * The exit status is the number of failed checks.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "MCAL/UART/uart0.h"
+#include "SIM/sim_registers.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define TEST_REG_COUNT           (64U)
+#define TEST_MAX_ERROR           (UART0_BAUD_MAX_ERROR_PERMILLE / 1000.0)
+#define TEST_SWEEP_FIRST         (10.0)
+#define TEST_SWEEP_LAST          (2100000.0)
+#define TEST_SWEEP_STEP          (1.003)
+
+#define TEST_UART0_IBRD          (0x4000C024UL)
+#define TEST_UART0_FBRD          (0x4000C028UL)
+#define TEST_UART0_CTL           (0x4000C030UL)
+#define TEST_SYSCTL_RCGCUART     (0x400FE618UL)
+#define TEST_SYSCTL_PRGPIO       (0x400FEA08UL)
+#define TEST_SYSCTL_PRUART       (0x400FEA18UL)
+
+/*------------------------------------------------------------------------------
+ *  Type Definitions
+ *----------------------------------------------------------------------------*/
+typedef struct {
+    uint32_t ui32Baud;
+    uint8_t ui8HighSpeed;
+} TestRateType;
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+
+/* Same table as the UART0_CHECK_BAUD lines of uart0.c */
+static const TestRateType axSupported[] = {
+    {9600, 0}, {19200, 0}, {38400, 0}, {57600, 0}, {115200, 0}, {230400, 0},
+    {460800, 0}, {921600, 0}, {1000000, 0}, {1500000, 1}, {2000000, 1}
+};
+
+static uint32_t aui32RegAddress[TEST_REG_COUNT];
+static volatile uint32 aui32RegValue[TEST_REG_COUNT];
+static uint32_t ui32RegCount;
+static uint32_t ui32Failures;
+
+/*------------------------------------------------------------------------------
+ *  Register Bank
+ *----------------------------------------------------------------------------*/
+
+static volatile uint32 *prvSlot(uint32_t ui32Address)
+{
+    uint32_t ui32Index;
+
+    for(ui32Index = 0; ui32Index < ui32RegCount; ui32Index++) {
+        if(aui32RegAddress[ui32Index] == ui32Address) {
+            return &aui32RegValue[ui32Index];
+        }
+    }
+    if(ui32RegCount == TEST_REG_COUNT) {
+        fprintf(stderr, "register bank full at 0x%08lX\n", (unsigned long)ui32Address);
+        return &aui32RegValue[0];
+    }
+    aui32RegAddress[ui32RegCount] = ui32Address;
+    aui32RegValue[ui32RegCount] = 0U;
+    return &aui32RegValue[ui32RegCount++];
+}
+
+/* Plain storage, only the clock ready registers read as ready */
+volatile uint32 *SIM_RegAccess(uint32 uAddress)
+{
+    volatile uint32 *pui32Slot = prvSlot(uAddress);
+
+    if((uAddress == TEST_SYSCTL_PRGPIO) || (uAddress == TEST_SYSCTL_PRUART)) {
+        *pui32Slot = 0xFFU;
+    }
+    return pui32Slot;
+}
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static void prvCheck(int iCondition, const char *pcWhat)
+{
+    if(!iCondition) {
+        printf("FAIL: %s\n", pcWhat);
+        ui32Failures++;
+    }
+}
+
+static void prvResetRegisters(void)
+{
+    ui32RegCount = 0;
+}
+
+/* IBRD x 64 + FBRD per the datasheet: BRD = clock / (divider x baud), FBRD = round(fraction x 64) */
+static uint64_t prvReferenceDivisor64(uint32_t ui32Baud, uint8_t ui8HighSpeed)
+{
+    uint64_t ui64Denominator = (uint64_t)(ui8HighSpeed ? 8U : 16U) * ui32Baud;
+
+    return ((2ULL * UART0_CLOCK_HZ * 64U) + ui64Denominator) / (2ULL * ui64Denominator);
+}
+
+static double prvError(uint32_t ui32Baud, uint8_t ui8HighSpeed, uint64_t ui64Divisor64)
+{
+    double dActual = ((double)UART0_CLOCK_HZ * 64.0) / ((ui8HighSpeed ? 8.0 : 16.0) * (double)ui64Divisor64);
+    double dError = (dActual - (double)ui32Baud) / (double)ui32Baud;
+
+    return (dError < 0.0) ? -dError : dError;
+}
+
+static boolean prvInit(uint32_t ui32Baud, uint8_t ui8HighSpeed)
+{
+    UART0_ConfigType xConfig = { 0, FALSE, TRUE, UART0_FIFO_LEVEL_1_2, UART0_FIFO_LEVEL_1_2 };
+
+    xConfig.uBaudRate = ui32Baud;
+    xConfig.bHighSpeed = ui8HighSpeed ? TRUE : FALSE;
+    prvResetRegisters();
+    return UART0_Init(&xConfig);
+}
+
+/*------------------------------------------------------------------------------
+ *  Tests
+ *----------------------------------------------------------------------------*/
+
+static void prvTestSupported(void)
+{
+    uint32_t ui32Index;
+    double dWorst = 0.0;
+    char acWhat[80];
+
+    printf("     baud  HSE   IBRD  FBRD   error\n");
+    for(ui32Index = 0; ui32Index < (sizeof(axSupported) / sizeof(axSupported[0])); ui32Index++) {
+        const TestRateType *pxRate = &axSupported[ui32Index];
+        uint64_t ui64Expected = prvReferenceDivisor64(pxRate->ui32Baud, pxRate->ui8HighSpeed);
+        double dError = prvError(pxRate->ui32Baud, pxRate->ui8HighSpeed, ui64Expected);
+        boolean bAccepted = prvInit(pxRate->ui32Baud, pxRate->ui8HighSpeed);
+        uint32_t ui32Ibrd = *prvSlot(TEST_UART0_IBRD);
+        uint32_t ui32Fbrd = *prvSlot(TEST_UART0_FBRD);
+        uint32_t ui32Ctl = *prvSlot(TEST_UART0_CTL);
+
+        printf("%9u  %3s  %5u  %4u  %5.2f %%\n", (unsigned)pxRate->ui32Baud, pxRate->ui8HighSpeed ? "yes" : "no",
+               (unsigned)ui32Ibrd, (unsigned)ui32Fbrd, dError * 100.0);
+
+        snprintf(acWhat, sizeof(acWhat), "supported %u: accepted", (unsigned)pxRate->ui32Baud);
+        prvCheck(bAccepted == TRUE, acWhat);
+        snprintf(acWhat, sizeof(acWhat), "supported %u: IBRD and FBRD", (unsigned)pxRate->ui32Baud);
+        prvCheck((ui32Ibrd == (uint32_t)(ui64Expected >> 6)) && (ui32Fbrd == (uint32_t)(ui64Expected & 0x3FU)), acWhat);
+        snprintf(acWhat, sizeof(acWhat), "supported %u: HSE and enable bits", (unsigned)pxRate->ui32Baud);
+        prvCheck(((ui32Ctl & UART_CTL_HSE_MASK) != 0U) == (pxRate->ui8HighSpeed != 0U) &&
+                 ((ui32Ctl & UART_CTL_UARTEN_MASK) != 0U), acWhat);
+        snprintf(acWhat, sizeof(acWhat), "supported %u: error within 2 %%", (unsigned)pxRate->ui32Baud);
+        prvCheck(dError <= TEST_MAX_ERROR, acWhat);
+        snprintf(acWhat, sizeof(acWhat), "supported %u: error macro agrees", (unsigned)pxRate->ui32Baud);
+        prvCheck((UART0_BAUD_ERROR_PERMILLE(pxRate->ui32Baud, pxRate->ui8HighSpeed) + 1U) >=
+                 (uint32_t)(dError * 1000.0) &&
+                 UART0_BAUD_ERROR_PERMILLE(pxRate->ui32Baud, pxRate->ui8HighSpeed) <= (uint32_t)(dError * 1000.0),
+                 acWhat);
+        if(dError > dWorst) {
+            dWorst = dError;
+        }
+    }
+    printf("worst supported rate error %.2f %%\n", dWorst * 100.0);
+}
+
+static void prvTestRejected(void)
+{
+    const TestRateType axRejected[] = {
+        {0, 0},             /* No rate */
+        {15, 0},            /* IBRD would be 66666 */
+        {30, 1},            /* IBRD would be 66666 */
+        {1500000, 0},       /* Above clock / 16 without HSE */
+        {2500000, 1}        /* Above clock / 8 with HSE */
+    };
+    uint32_t ui32Index;
+    char acWhat[80];
+
+    prvResetRegisters();
+    prvCheck(UART0_Init(NULL_PTR) == FALSE, "rejected: no configuration");
+
+    for(ui32Index = 0; ui32Index < (sizeof(axRejected) / sizeof(axRejected[0])); ui32Index++) {
+        const TestRateType *pxRate = &axRejected[ui32Index];
+
+        snprintf(acWhat, sizeof(acWhat), "rejected %u%s", (unsigned)pxRate->ui32Baud, pxRate->ui8HighSpeed ? " HSE" : "");
+        prvCheck(prvInit(pxRate->ui32Baud, pxRate->ui8HighSpeed) == FALSE, acWhat);
+        snprintf(acWhat, sizeof(acWhat), "rejected %u%s: UART0 untouched", (unsigned)pxRate->ui32Baud,
+                 pxRate->ui8HighSpeed ? " HSE" : "");
+        prvCheck((*prvSlot(TEST_SYSCTL_RCGCUART) == 0U) && (*prvSlot(TEST_UART0_CTL) == 0U), acWhat);
+    }
+
+    // The last accepted rate at each range limit, the divisor rounds up to 1 + 0/64 at the top
+    prvCheck(prvInit(16, 0) == TRUE, "limit: 16 baud accepted");
+    prvCheck(prvInit(31, 1) == TRUE, "limit: 31 baud with HSE accepted");
+    prvCheck(prvInit(1007874, 0) == TRUE, "limit: 1007874 baud accepted");
+    prvCheck(prvInit(1007875, 0) == FALSE, "limit: 1007875 baud rejected");
+    prvCheck(prvInit(2015748, 1) == TRUE, "limit: 2015748 baud with HSE accepted");
+    prvCheck(prvInit(2015749, 1) == FALSE, "limit: 2015749 baud with HSE rejected");
+}
+
+static void prvTestSweep(void)
+{
+    uint32_t ui32Rates = 0;
+    uint32_t ui32Accepted = 0;
+    uint32_t ui32Mismatches = 0;
+    uint32_t ui32OverBudget = 0;
+    uint8_t ui8HighSpeed;
+    double dBaud;
+
+    for(ui8HighSpeed = 0; ui8HighSpeed < 2U; ui8HighSpeed++) {
+        for(dBaud = TEST_SWEEP_FIRST; dBaud <= TEST_SWEEP_LAST; dBaud *= TEST_SWEEP_STEP) {
+            uint32_t ui32Baud = (uint32_t)dBaud;
+            uint64_t ui64Expected = prvReferenceDivisor64(ui32Baud, ui8HighSpeed);
+            uint8_t ui8InRange = ((ui64Expected >> 6) >= 1U) && ((ui64Expected >> 6) <= 0xFFFFU);
+            boolean bAccepted = prvInit(ui32Baud, ui8HighSpeed);
+
+            ui32Rates++;
+            if(bAccepted != (ui8InRange ? TRUE : FALSE)) {
+                ui32Mismatches++;
+            } else if(bAccepted) {
+                ui32Accepted++;
+                if((*prvSlot(TEST_UART0_IBRD) != (uint32_t)(ui64Expected >> 6)) ||
+                   (*prvSlot(TEST_UART0_FBRD) != (uint32_t)(ui64Expected & 0x3FU))) {
+                    ui32Mismatches++;
+                }
+                if(prvError(ui32Baud, ui8HighSpeed, ui64Expected) > TEST_MAX_ERROR) {
+                    ui32OverBudget++;
+                }
+            }
+        }
+    }
+
+    printf("sweep: %u rates, %u accepted\n", (unsigned)ui32Rates, (unsigned)ui32Accepted);
+    prvCheck(ui32Mismatches == 0U, "sweep: accepted exactly when in range, with the datasheet divisors");
+    prvCheck(ui32OverBudget == 0U, "sweep: every accepted rate within 2 %");
+}
+
+/*------------------------------------------------------------------------------
+ *  Main Function
+ *----------------------------------------------------------------------------*/
+int main(void)
+{
+    prvTestSupported();
+    prvTestRejected();
+    prvTestSweep();
+
+    printf("%s (%u failed)\n", (ui32Failures == 0U) ? "PASS" : "FAIL", (unsigned)ui32Failures);
+    return (int)ui32Failures;
+}
@@ -0,0 +1,350 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Host Simulation
+ *  File        : uart0_dma_test.c
+ *  Description : Host test of the UART0 uDMA transmit path against a modelled controller
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*
+ * Builds MCAL/UART/uart0.c and MCAL/UDMA/udma.c for the host with SIMULATION
+ * defined and stands in for the register bank itself (SIM_RegAccess), like
+ * uart0_tx_test.c, with a uDMA controller that runs only when the test says
+ * so. It reads the channel control table the driver filled, moves the bytes
+ * out behind whatever the TX FIFO still holds, clears the channel enable bit
+ * and raises the channel interrupt (CHIS, write 1 to clear). It checks:
+ *  - the control word and end addresses of a frame, and the length limits
+ *  - IDLE -> ACTIVE: a frame starts at once when the ring is empty
+ *  - a second frame is rejected while one is in flight
+ *  - the completion callback runs from the UART0 interrupt, once
+ *  - IDLE -> PENDING: a frame waits for the bytes already queued in the ring
+ *
+ *   gcc -O2 -Wall -DSIMULATION -I. -IMCAL -IMCAL/UDMA -ISIM -I<std_types.h dir> \
+ *       SIM/bench/uart0_dma_test.c MCAL/UART/uart0.c MCAL/UDMA/udma.c -o uart0_dma_test
+ *   ./uart0_dma_test
+ *
+ * The exit status is the number of failed checks.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "MCAL/UART/uart0.h"
+#include "MCAL/UDMA/udma.h"
+#include "SIM/sim_registers.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define TEST_REG_COUNT           (64U)
+#define TEST_FIFO_SIZE           (16U)
+#define TEST_OUTPUT_SIZE         (4096U)
+#define TEST_DR_EMPTY            (0xFFFFFFFFUL)   /* Data register slot not written since the last access */
+#define TEST_CHIS_READ_MARK      (0x80000000UL)   /* Unused channel 31, tells the value read from a store */
+#define TEST_CHANNEL_MASK        (1UL << UDMA_CHANNEL_UART0TX)
+
+#define TEST_UART0_DR            (0x4000C000UL)
+#define TEST_UART0_FR            (0x4000C018UL)
+#define TEST_UART0_IM            (0x4000C038UL)
+#define TEST_UART0_DMACTL        (0x4000C048UL)
+#define TEST_SYSCTL_PRGPIO       (0x400FEA08UL)
+#define TEST_SYSCTL_PRDMA        (0x400FEA0CUL)
+#define TEST_SYSCTL_PRUART       (0x400FEA18UL)
+#define TEST_UDMA_CFG            (0x400FF004UL)
+#define TEST_UDMA_ENASET         (0x400FF028UL)
+#define TEST_UDMA_CHIS           (0x400FF504UL)
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+static uint32_t aui32RegAddress[TEST_REG_COUNT];
+static volatile uint32 aui32RegValue[TEST_REG_COUNT];
+static uint32_t ui32RegCount;
+static uint32_t ui32ChannelsDone;                   /* Raised channel interrupts, what CHIS reads */
+
+static uint8_t aui8Fifo[TEST_FIFO_SIZE];
+static uint32_t ui32FifoCount;
+
+static uint8_t aui8Output[TEST_OUTPUT_SIZE];
+static uint32_t ui32OutputLength;
+
+static uint32_t ui32Callbacks;
+static uint32_t ui32Failures;
+
+/*------------------------------------------------------------------------------
+ *  Register Bank
+ *----------------------------------------------------------------------------*/
+
+static volatile uint32 *prvSlot(uint32_t ui32Address)
+{
+    uint32_t ui32Index;
+
+    for(ui32Index = 0; ui32Index < ui32RegCount; ui32Index++) {
+        if(aui32RegAddress[ui32Index] == ui32Address) {
+            return &aui32RegValue[ui32Index];
+        }
+    }
+    if(ui32RegCount == TEST_REG_COUNT) {
+        fprintf(stderr, "register bank full at 0x%08lX\n", (unsigned long)ui32Address);
+        return &aui32RegValue[0];
+    }
+    aui32RegAddress[ui32RegCount] = ui32Address;
+    aui32RegValue[ui32RegCount] = (ui32Address == TEST_UART0_DR) ? TEST_DR_EMPTY : 0U;
+    return &aui32RegValue[ui32RegCount++];
+}
+
+/* A store lands after SIM_RegAccess returns, so stores with side effects are applied on the next access */
+static void prvCommitStores(void)
+{
+    volatile uint32 *pui32Dr = prvSlot(TEST_UART0_DR);
+    volatile uint32 *pui32Chis = prvSlot(TEST_UDMA_CHIS);
+
+    if(*pui32Dr != TEST_DR_EMPTY) {
+        if(ui32FifoCount < TEST_FIFO_SIZE) {
+            aui8Fifo[ui32FifoCount++] = (uint8_t)*pui32Dr;
+        } else {
+            printf("FAIL: data register written with the TX FIFO full\n");
+            ui32Failures++;
+        }
+        *pui32Dr = TEST_DR_EMPTY;
+    }
+
+    // Reads leave the mark in the slot, a store without it clears the channels it names
+    if(!(*pui32Chis & TEST_CHIS_READ_MARK)) {
+        ui32ChannelsDone &= ~*pui32Chis;
+    }
+    *pui32Chis = ui32ChannelsDone | TEST_CHIS_READ_MARK;
+}
+
+volatile uint32 *SIM_RegAccess(uint32 uAddress)
+{
+    volatile uint32 *pui32Slot;
+
+    prvCommitStores();
+    pui32Slot = prvSlot(uAddress);
+
+    if(uAddress == TEST_UART0_FR) {
+        // Nothing is received, TXFF and TXFE follow the modelled FIFO
+        *pui32Slot = UART_FR_RXFE_MASK | ((ui32FifoCount == TEST_FIFO_SIZE) ? UART_FR_TXFF_MASK : 0U)
+                   | ((ui32FifoCount == 0U) ? UART_FR_TXFE_MASK : 0U);
+    } else if((uAddress == TEST_SYSCTL_PRGPIO) || (uAddress == TEST_SYSCTL_PRDMA) ||
+              (uAddress == TEST_SYSCTL_PRUART)) {
+        *pui32Slot = 0xFFU;
+    }
+    return pui32Slot;
+}
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static void prvCheck(int iCondition, const char *pcWhat)
+{
+    if(!iCondition) {
+        printf("FAIL: %s\n", pcWhat);
+        ui32Failures++;
+    }
+}
+
+static void prvOnComplete(void)
+{
+    ui32Callbacks++;
+}
+
+/* The transmitter shifts up to ui32Count bytes out of the FIFO */
+static void prvShiftOut(uint32_t ui32Count)
+{
+    prvCommitStores();
+    if(ui32Count > ui32FifoCount) {
+        ui32Count = ui32FifoCount;
+    }
+    if(ui32Count > (TEST_OUTPUT_SIZE - ui32OutputLength)) {
+        ui32Count = TEST_OUTPUT_SIZE - ui32OutputLength;
+    }
+    memcpy(&aui8Output[ui32OutputLength], aui8Fifo, ui32Count);
+    ui32OutputLength += ui32Count;
+    memmove(aui8Fifo, &aui8Fifo[ui32Count], ui32FifoCount - ui32Count);
+    ui32FifoCount -= ui32Count;
+}
+
+static uint8_t prvTxInterruptEnabled(void)
+{
+    return (*prvSlot(TEST_UART0_IM) & UART_IM_TXIM_MASK) ? 1U : 0U;
+}
+
+static uint8_t prvChannelEnabled(void)
+{
+    prvCommitStores();
+    return (*prvSlot(TEST_UDMA_ENASET) & TEST_CHANNEL_MASK) ? 1U : 0U;
+}
+
+/* Runs the TX interrupt every time the FIFO drains to half until the ring is empty or a frame took over */
+static void prvDrainRing(void)
+{
+    uint32_t ui32Rounds = 0;
+
+    while(prvTxInterruptEnabled() && (ui32Rounds++ < TEST_OUTPUT_SIZE)) {
+        prvShiftOut(TEST_FIFO_SIZE / 2U);
+        UART0_Handler();
+    }
+}
+
+/* The controller moves an enabled frame out behind the FIFO and raises the channel interrupt */
+static void prvRunController(void)
+{
+    const UDMA_ControlTableEntryType *pxEntry = &UDMA_GetControlTable()[UDMA_CHANNEL_UART0TX];
+    uint32_t ui32Length;
+
+    if(!prvChannelEnabled()) {
+        return;
+    }
+    prvCheck((*prvSlot(TEST_UDMA_CFG) & UDMA_CFG_MASTEN_MASK) != 0U, "controller: enabled by UDMA_Init");
+    prvCheck((*prvSlot(TEST_UART0_DMACTL) & UART_DMACTL_TXDMAE_MASK) != 0U, "controller: UART0 TX requests on");
+    prvCheck(pxEntry->pvDstEndAddr == (volatile void *)prvSlot(TEST_UART0_DR), "controller: writes the data register");
+
+    ui32Length = ((pxEntry->uControl & UDMA_CHCTL_XFERSIZE_MASK) >> UDMA_CHCTL_XFERSIZE_POS) + 1U;
+    prvShiftOut(TEST_FIFO_SIZE);
+    if(ui32Length <= (TEST_OUTPUT_SIZE - ui32OutputLength)) {
+        memcpy(&aui8Output[ui32OutputLength], (const uint8_t *)pxEntry->pvSrcEndAddr - (ui32Length - 1U), ui32Length);
+        ui32OutputLength += ui32Length;
+    }
+    *prvSlot(TEST_UDMA_ENASET) &= ~TEST_CHANNEL_MASK;
+    ui32ChannelsDone |= TEST_CHANNEL_MASK;
+    prvCommitStores();
+}
+
+static void prvReset(void)
+{
+    ui32OutputLength = 0;
+    ui32Callbacks = 0;
+}
+
+static void prvPattern(uint8_t *pui8Data, uint32_t ui32Length, uint32_t ui32Seed)
+{
+    uint32_t ui32Index;
+
+    for(ui32Index = 0; ui32Index < ui32Length; ui32Index++) {
+        pui8Data[ui32Index] = (uint8_t)((ui32Seed + (ui32Index * 13U)) & 0xFFU);
+    }
+}
+
+/*------------------------------------------------------------------------------
+ *  Tests
+ *----------------------------------------------------------------------------*/
+
+static void prvTestControlWord(void)
+{
+    uint32_t ui32Control = UDMA_BuildMemToPeriphControl(1);
+
+    // Bits 31:30 DSTINC, 29:28 DSTSIZE, 27:26 SRCINC, 25:24 SRCSIZE, 17:14 ARBSIZE, 13:4 XFERSIZE, 2:0 XFERMODE
+    prvCheck(((ui32Control >> 30) & 0x3U) == 0x3U, "control: destination does not increment");
+    prvCheck(((ui32Control >> 28) & 0x3U) == 0x0U, "control: destination items are bytes");
+    prvCheck(((ui32Control >> 26) & 0x3U) == 0x0U, "control: source increments by a byte");
+    prvCheck(((ui32Control >> 24) & 0x3U) == 0x0U, "control: source items are bytes");
+    prvCheck(((ui32Control >> 14) & 0xFU) == 0x2U, "control: re-arbitrates every 4 items");
+    prvCheck((ui32Control & UDMA_CHCTL_XFERMODE_MASK) == UDMA_CHCTL_XFERMODE_BASIC, "control: basic mode");
+    prvCheck((ui32Control & UDMA_CHCTL_XFERSIZE_MASK) == 0U, "control: one item is XFERSIZE 0");
+    prvCheck((UDMA_BuildMemToPeriphControl(UDMA_MAX_TRANSFER_SIZE) & UDMA_CHCTL_XFERSIZE_MASK) ==
+             UDMA_CHCTL_XFERSIZE_MASK, "control: the largest frame fills XFERSIZE");
+
+    prvCheck(!UART0_SendBufferAsync((const uint8 *)"x", 0, prvOnComplete), "limits: empty frame rejected");
+    prvCheck(!UART0_SendBufferAsync(NULL_PTR, 1, prvOnComplete), "limits: no data rejected");
+    prvCheck(!UART0_SendBufferAsync(aui8Output, UDMA_MAX_TRANSFER_SIZE + 1U, prvOnComplete),
+             "limits: frame over XFERSIZE rejected");
+    prvCheck(!prvChannelEnabled() && !UART0_IsTxDmaBusy(), "limits: nothing started");
+}
+
+static void prvTestStartAndComplete(void)
+{
+    const UDMA_ControlTableEntryType *pxEntry = &UDMA_GetControlTable()[UDMA_CHANNEL_UART0TX];
+    uint8_t aui8Frame[40];
+    uint8_t aui8Other[8];
+
+    prvReset();
+    prvPattern(aui8Frame, sizeof(aui8Frame), 3);
+    prvPattern(aui8Other, sizeof(aui8Other), 200);
+
+    // IDLE -> ACTIVE: the ring is empty, the channel starts at once and the FIFO belongs to it
+    prvCheck(UART0_SendBufferAsync(aui8Frame, sizeof(aui8Frame), prvOnComplete), "start: accepted");
+    prvCheck(prvChannelEnabled(), "start: channel enabled");
+    prvCheck(UART0_IsTxDmaBusy(), "start: busy");
+    prvCheck(!prvTxInterruptEnabled(), "start: TX interrupt masked");
+    prvCheck(pxEntry->pvSrcEndAddr == (const void *)&aui8Frame[sizeof(aui8Frame) - 1U], "start: source end address");
+    prvCheck(pxEntry->uControl == UDMA_BuildMemToPeriphControl(sizeof(aui8Frame)), "start: control word");
+
+    // A second frame waits for the application to retry, the descriptor is left alone
+    prvCheck(!UART0_SendBufferAsync(aui8Other, sizeof(aui8Other), prvOnComplete), "second: rejected while active");
+    prvCheck(pxEntry->pvSrcEndAddr == (const void *)&aui8Frame[sizeof(aui8Frame) - 1U], "second: descriptor kept");
+    prvCheck(!UDMA_StartMemToPeriph(UDMA_CHANNEL_UART0TX, aui8Other, prvSlot(TEST_UART0_DR), sizeof(aui8Other)),
+             "second: busy channel refused by the driver");
+
+    // Ring bytes written meanwhile stay queued until the frame is done
+    prvCheck(UART0_SendBufferNonBlocking((const uint8 *)"tail", 4) == 4U, "second: ring write accepted");
+    prvCommitStores();
+    prvCheck(ui32FifoCount == 0U, "second: ring write kept out of the FIFO");
+
+    prvRunController();
+    prvCheck(ui32Callbacks == 0U, "complete: no callback before the interrupt");
+    UART0_Handler();
+    prvCheck(ui32Callbacks == 1U, "complete: callback from the UART0 interrupt");
+    prvCheck(!UART0_IsTxDmaBusy(), "complete: idle");
+    prvCheck(ui32ChannelsDone == 0U, "complete: channel interrupt cleared");
+    UART0_Handler();
+    prvCheck(ui32Callbacks == 1U, "complete: callback runs once");
+
+    prvDrainRing();
+    prvShiftOut(TEST_FIFO_SIZE);
+    prvCheck((ui32OutputLength == (sizeof(aui8Frame) + 4U)) &&
+             (memcmp(aui8Output, aui8Frame, sizeof(aui8Frame)) == 0) &&
+             (memcmp(&aui8Output[sizeof(aui8Frame)], "tail", 4) == 0), "complete: frame then ring bytes");
+}
+
+static void prvTestPending(void)
+{
+    uint8_t aui8Queued[100];
+    uint8_t aui8Frame[64];
+
+    prvReset();
+    prvPattern(aui8Queued, sizeof(aui8Queued), 7);
+    prvPattern(aui8Frame, sizeof(aui8Frame), 90);
+
+    // IDLE -> PENDING: the FIFO is full and the ring holds the rest, the frame must not overtake them
+    prvCheck(UART0_SendBufferNonBlocking(aui8Queued, sizeof(aui8Queued)) == sizeof(aui8Queued), "pending: ring write");
+    prvCheck(UART0_SendBufferAsync(aui8Frame, sizeof(aui8Frame), prvOnComplete), "pending: accepted");
+    prvCheck(!prvChannelEnabled(), "pending: channel not started");
+    prvCheck(UART0_IsTxDmaBusy(), "pending: busy");
+    prvCheck(!UART0_SendBufferAsync(aui8Frame, 1, prvOnComplete), "pending: second frame rejected");
+
+    // The TX interrupt drains the ring and starts the frame with the last refill
+    prvDrainRing();
+    prvCheck(prvChannelEnabled(), "pending: channel started once the ring is empty");
+    prvCheck(UART0_GetTxFreeSpace() == (UART0_TX_BUFFER_SIZE - 1U), "pending: ring empty");
+
+    prvRunController();
+    UART0_Handler();
+    prvCheck(ui32Callbacks == 1U, "pending: callback");
+    prvCheck(!UART0_IsTxDmaBusy() && !prvTxInterruptEnabled(), "pending: idle with nothing left to send");
+    prvCheck((ui32OutputLength == (sizeof(aui8Queued) + sizeof(aui8Frame))) &&
+             (memcmp(aui8Output, aui8Queued, sizeof(aui8Queued)) == 0) &&
+             (memcmp(&aui8Output[sizeof(aui8Queued)], aui8Frame, sizeof(aui8Frame)) == 0),
+             "pending: queued bytes then frame");
+}
+
+/*------------------------------------------------------------------------------
+ *  Main Function
+ *----------------------------------------------------------------------------*/
+int main(void)
+{
+    const UART0_ConfigType xConfig = { 115200, FALSE, TRUE, UART0_FIFO_LEVEL_1_2, UART0_FIFO_LEVEL_1_2 };
+
+    UDMA_Init();
+    prvCheck(UART0_Init(&xConfig), "init");
+    prvTestControlWord();
+    prvTestStartAndComplete();
+    prvTestPending();
+
+    printf("%s (%u failed)\n", (ui32Failures == 0U) ? "PASS" : "FAIL", (unsigned)ui32Failures);
+    return (int)ui32Failures;
+}
@@ -0,0 +1,335 @@
+/*------------------------------------------------------------------------------
+ *  Module      : Host Simulation
+ *  File        : uart0_tx_test.c
+ *  Description : Host test of the UART0 transmit ring against a modelled FIFO
+ *  Author      : Hassan Darwish
+ *----------------------------------------------------------------------------*/
+
+/*
+ * Builds MCAL/UART/uart0.c for the host with SIMULATION defined and stands in
+ * for the register bank itself (SIM_RegAccess), instead of SIM/sim_registers.c
+ * whose TX FIFO drains at once. Here the 16-byte TX FIFO only empties when the
+ * test shifts bytes out, so it can hold the FIFO full and check:
+ *  - short writes go straight to the FIFO, the interrupt masks TX once idle
+ *  - the TX interrupt refills the FIFO from the ring until both are empty
+ *  - byte order is kept while the ring indices wrap around many times
+ *  - a full ring accepts what fits and counts every dropped byte
+ *  - a write from inside another task's locked section leaves UART0 masked
+ *
+ *   gcc -O2 -Wall -DSIMULATION -I. -IMCAL -IMCAL/UDMA -ISIM -I<std_types.h dir> \
+ *       SIM/bench/uart0_tx_test.c MCAL/UART/uart0.c -o uart0_tx_test
+ *   ./uart0_tx_test
+ *
+ * The exit status is the number of failed checks.
+ */
+
+/*------------------------------------------------------------------------------
+ *  INCLUDES
+ *----------------------------------------------------------------------------*/
+#include "MCAL/UART/uart0.h"
+#include "MCAL/UDMA/udma.h"
+#include "SIM/sim_registers.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------------
+ *  Pre-Processor Constants
+ *----------------------------------------------------------------------------*/
+#define TEST_REG_COUNT           (64U)
+#define TEST_FIFO_SIZE           (16U)
+#define TEST_OUTPUT_SIZE         (4096U)
+#define TEST_DR_EMPTY            (0xFFFFFFFFUL)   /* Data register slot not written since the last access */
+
+#define TEST_UART0_DR            (0x4000C000UL)
+#define TEST_UART0_FR            (0x4000C018UL)
+#define TEST_UART0_IM            (0x4000C038UL)
+#define TEST_NVIC_EN0            (0xE000E100UL)
+#define TEST_NVIC_DIS0           (0xE000E180UL)
+#define TEST_SYSCTL_PRGPIO       (0x400FEA08UL)
+#define TEST_SYSCTL_PRUART       (0x400FEA18UL)
+
+/*------------------------------------------------------------------------------
+ *  Local Data
+ *----------------------------------------------------------------------------*/
+static uint32_t aui32RegAddress[TEST_REG_COUNT];
+static volatile uint32 aui32RegValue[TEST_REG_COUNT];
+static uint32_t ui32RegCount;
+
+static uint8_t aui8Fifo[TEST_FIFO_SIZE];
+static uint32_t ui32FifoCount;
+
+static uint8_t aui8Output[TEST_OUTPUT_SIZE];
+static uint32_t ui32OutputLength;
+
+static uint32_t ui32Failures;
+
+/*------------------------------------------------------------------------------
+ *  Register Bank
+ *----------------------------------------------------------------------------*/
+
+static volatile uint32 *prvSlot(uint32_t ui32Address)
+{
+    uint32_t ui32Index;
+
+    for(ui32Index = 0; ui32Index < ui32RegCount; ui32Index++) {
+        if(aui32RegAddress[ui32Index] == ui32Address) {
+            return &aui32RegValue[ui32Index];
+        }
+    }
+    if(ui32RegCount == TEST_REG_COUNT) {
+        fprintf(stderr, "register bank full at 0x%08lX\n", (unsigned long)ui32Address);
+        return &aui32RegValue[0];
+    }
+    aui32RegAddress[ui32RegCount] = ui32Address;
+    aui32RegValue[ui32RegCount] = (ui32Address == TEST_UART0_DR) ? TEST_DR_EMPTY : 0U;
+    return &aui32RegValue[ui32RegCount++];
+}
+
+/* A store lands after SIM_RegAccess returns, so a DR store is moved into the FIFO on the next access */
+static void prvCommitDataRegister(void)
+{
+    volatile uint32 *pui32Dr = prvSlot(TEST_UART0_DR);
+
+    if(*pui32Dr != TEST_DR_EMPTY) {
+        if(ui32FifoCount < TEST_FIFO_SIZE) {
+            aui8Fifo[ui32FifoCount++] = (uint8_t)*pui32Dr;
+        } else {
+            printf("FAIL: data register written with the TX FIFO full\n");
+            ui32Failures++;
+        }
+        *pui32Dr = TEST_DR_EMPTY;
+    }
+}
+
+/* EN0 reads back the enabled interrupts, a DIS0 store clears them */
+static void prvCommitNvic(void)
+{
+    volatile uint32 *pui32Dis = prvSlot(TEST_NVIC_DIS0);
+
+    *prvSlot(TEST_NVIC_EN0) &= ~*pui32Dis;
+    *pui32Dis = 0U;
+}
+
+volatile uint32 *SIM_RegAccess(uint32 uAddress)
+{
+    volatile uint32 *pui32Slot;
+
+    prvCommitDataRegister();
+    prvCommitNvic();
+    pui32Slot = prvSlot(uAddress);
+
+    if(uAddress == TEST_UART0_FR) {
+        // Nothing is received, TXFF and TXFE follow the modelled FIFO
+        *pui32Slot = UART_FR_RXFE_MASK | ((ui32FifoCount == TEST_FIFO_SIZE) ? UART_FR_TXFF_MASK : 0U)
+                   | ((ui32FifoCount == 0U) ? UART_FR_TXFE_MASK : 0U);
+    } else if((uAddress == TEST_SYSCTL_PRGPIO) || (uAddress == TEST_SYSCTL_PRUART)) {
+        *pui32Slot = 0xFFU;
+    }
+    return pui32Slot;
+}
+
+/* The uDMA path is not used here */
+boolean UDMA_StartMemToPeriph(uint8 uChannel, const uint8 *pSource, volatile uint32 *pDestination, uint32 uLength)
+{
+    (void)uChannel;
+    (void)pSource;
+    (void)pDestination;
+    (void)uLength;
+    return FALSE;
+}
+
+boolean UDMA_ChannelClearDone(uint8 uChannel)
+{
+    (void)uChannel;
+    return FALSE;
+}
+
+/*------------------------------------------------------------------------------
+ *  Local Functions
+ *----------------------------------------------------------------------------*/
+
+static void prvCheck(int iCondition, const char *pcWhat)
+{
+    if(!iCondition) {
+        printf("FAIL: %s\n", pcWhat);
+        ui32Failures++;
+    }
+}
+
+/* The transmitter shifts up to ui32Count bytes out of the FIFO */
+static void prvShiftOut(uint32_t ui32Count)
+{
+    prvCommitDataRegister();
+    if(ui32Count > ui32FifoCount) {
+        ui32Count = ui32FifoCount;
+    }
+    if(ui32Count > (TEST_OUTPUT_SIZE - ui32OutputLength)) {
+        ui32Count = TEST_OUTPUT_SIZE - ui32OutputLength;
+    }
+    memcpy(&aui8Output[ui32OutputLength], aui8Fifo, ui32Count);
+    ui32OutputLength += ui32Count;
+    memmove(aui8Fifo, &aui8Fifo[ui32Count], ui32FifoCount - ui32Count);
+    ui32FifoCount -= ui32Count;
+}
+
+static uint8_t prvUart0Enabled(void)
+{
+    prvCommitNvic();
+    return (*prvSlot(TEST_NVIC_EN0) & UART0_NVIC_EN0_MASK) ? 1U : 0U;
+}
+
+static uint8_t prvTxInterruptEnabled(void)
+{
+    return (*prvSlot(TEST_UART0_IM) & UART_IM_TXIM_MASK) ? 1U : 0U;
+}
+
+/* Runs the TX interrupt every time the FIFO drains to half, the 1/2 trigger level, until all is sent */
+static void prvDrain(void)
+{
+    uint32_t ui32Rounds = 0;
+
+    while(prvTxInterruptEnabled() && (ui32Rounds++ < TEST_OUTPUT_SIZE)) {
+        prvShiftOut(TEST_FIFO_SIZE / 2U);
+        UART0_Handler();
+    }
+    prvShiftOut(TEST_FIFO_SIZE);
+}
+
+static void prvReset(void)
+{
+    ui32OutputLength = 0;
+}
+
+static void prvPattern(uint8_t *pui8Data, uint32_t ui32Length, uint32_t ui32Seed)
+{
+    uint32_t ui32Index;
+
+    for(ui32Index = 0; ui32Index < ui32Length; ui32Index++) {
+        pui8Data[ui32Index] = (uint8_t)((ui32Seed + (ui32Index * 7U)) & 0xFFU);
+    }
+}
+
+/*------------------------------------------------------------------------------
+ *  Tests
+ *----------------------------------------------------------------------------*/
+
+static void prvTestShortWrite(void)
+{
+    prvReset();
+    prvCheck(UART0_SendBufferNonBlocking((const uint8 *)"hello", 5) == 5, "short: accepted");
+    prvCommitDataRegister();
+    prvCheck((ui32FifoCount == 5U) && (memcmp(aui8Fifo, "hello", 5) == 0), "short: written to the FIFO at once");
+    prvCheck(UART0_GetTxFreeSpace() == (UART0_TX_BUFFER_SIZE - 1U), "short: ring left empty");
+
+    prvDrain();
+    prvCheck((ui32OutputLength == 5U) && (memcmp(aui8Output, "hello", 5) == 0), "short: sent");
+    prvCheck(!prvTxInterruptEnabled(), "short: TX interrupt masked once idle");
+}
+
+static void prvTestRefill(void)
+{
+    uint8_t aui8Data[100];
+
+    prvReset();
+    prvPattern(aui8Data, sizeof(aui8Data), 1);
+    prvCheck(UART0_SendBufferNonBlocking(aui8Data, sizeof(aui8Data)) == sizeof(aui8Data), "refill: accepted");
+    prvCommitDataRegister();
+    prvCheck(ui32FifoCount == TEST_FIFO_SIZE, "refill: FIFO filled first");
+    prvCheck(UART0_GetTxFreeSpace() == (UART0_TX_BUFFER_SIZE - 1U - (sizeof(aui8Data) - TEST_FIFO_SIZE)),
+             "refill: rest queued in the ring");
+    prvCheck(prvTxInterruptEnabled(), "refill: TX interrupt enabled");
+
+    prvDrain();
+    prvCheck((ui32OutputLength == sizeof(aui8Data)) && (memcmp(aui8Output, aui8Data, sizeof(aui8Data)) == 0),
+             "refill: sent in order");
+    prvCheck(!prvTxInterruptEnabled(), "refill: TX interrupt masked once idle");
+}
+
+static void prvTestWrapAround(void)
+{
+    uint8_t aui8Data[200];
+    uint8_t aui8Expected[sizeof(aui8Data) * 10U];
+    uint32_t ui32Round;
+    uint32_t ui32Accepted = 0;
+
+    // 2000 bytes through a 256-byte ring, part drained between writes so head and tail wrap at different points
+    prvReset();
+    for(ui32Round = 0; ui32Round < 10U; ui32Round++) {
+        prvPattern(aui8Data, sizeof(aui8Data), ui32Round * 31U);
+        memcpy(&aui8Expected[ui32Round * sizeof(aui8Data)], aui8Data, sizeof(aui8Data));
+        ui32Accepted += UART0_SendBufferNonBlocking(aui8Data, sizeof(aui8Data));
+        prvShiftOut(TEST_FIFO_SIZE / 2U);
+        UART0_Handler();
+        prvDrain();
+    }
+
+    prvCheck(ui32Accepted == sizeof(aui8Expected), "wrap: all accepted");
+    prvCheck((ui32OutputLength == sizeof(aui8Expected)) &&
+             (memcmp(aui8Output, aui8Expected, sizeof(aui8Expected)) == 0), "wrap: sent in order");
+}
+
+static void prvTestFull(void)
+{
+    uint8_t aui8Data[300];
+    uint8_t aui8Expected[UART0_TX_BUFFER_SIZE - 1U + TEST_FIFO_SIZE];
+    uint32_t ui32DroppedBefore = UART0_GetTxDroppedBytes();
+    uint32_t ui32RingSize = UART0_TX_BUFFER_SIZE - 1U;
+
+    // Nothing is shifted out. The whole write is queued in the ring before the FIFO is filled from it,
+    // so one write takes at most the ring's 255 bytes and the rest is dropped
+    prvReset();
+    prvPattern(aui8Data, sizeof(aui8Data), 5);
+    prvCheck(UART0_SendBufferNonBlocking(aui8Data, sizeof(aui8Data)) == ui32RingSize, "full: ring filled");
+    prvCheck((UART0_GetTxDroppedBytes() - ui32DroppedBefore) == (sizeof(aui8Data) - ui32RingSize),
+             "full: drops counted");
+    prvCheck(UART0_GetTxFreeSpace() == TEST_FIFO_SIZE, "full: FIFO took the first bytes");
+
+    // The next write takes the room the FIFO made and no more
+    prvCheck(UART0_SendBufferNonBlocking(aui8Data, 20) == TEST_FIFO_SIZE, "full: second write fills the ring");
+    prvCheck(UART0_GetTxFreeSpace() == 0U, "full: no free space");
+    prvCheck((UART0_GetTxDroppedBytes() - ui32DroppedBefore) ==
+             (sizeof(aui8Data) - ui32RingSize + 20U - TEST_FIFO_SIZE), "full: second write drops counted");
+
+    memcpy(aui8Expected, aui8Data, ui32RingSize);
+    memcpy(&aui8Expected[ui32RingSize], aui8Data, TEST_FIFO_SIZE);
+    prvDrain();
+    prvCheck((ui32OutputLength == sizeof(aui8Expected)) &&
+             (memcmp(aui8Output, aui8Expected, sizeof(aui8Expected)) == 0), "full: accepted bytes sent in order");
+}
+
+static void prvTestNestedLock(void)
+{
+    prvReset();
+    prvCheck(prvUart0Enabled(), "nested: UART0 enabled after init");
+
+    // A task preempted inside its locked section has UART0 masked, another task's write must leave it so
+    *prvSlot(TEST_NVIC_DIS0) = UART0_NVIC_EN0_MASK;
+    prvCheck(!prvUart0Enabled(), "nested: masked by the outer section");
+    prvCheck(UART0_SendBufferNonBlocking((const uint8 *)"ab", 2) == 2, "nested: accepted");
+    prvCheck(!prvUart0Enabled(), "nested: inner section leaves UART0 masked");
+
+    *prvSlot(TEST_NVIC_EN0) |= UART0_NVIC_EN0_MASK;
+    prvCheck(UART0_SendBufferNonBlocking((const uint8 *)"cd", 2) == 2, "nested: outer write accepted");
+    prvCheck(prvUart0Enabled(), "nested: outermost section re-enables UART0");
+    prvDrain();
+    prvCheck((ui32OutputLength == 4U) && (memcmp(aui8Output, "abcd", 4) == 0), "nested: sent in order");
+}
+
+/*------------------------------------------------------------------------------
+ *  Main Function
+ *----------------------------------------------------------------------------*/
+int main(void)
+{
+    const UART0_ConfigType xConfig = { 115200, FALSE, TRUE, UART0_FIFO_LEVEL_1_2, UART0_FIFO_LEVEL_1_2 };
+
+    prvCheck(UART0_Init(&xConfig), "init");
+    prvTestShortWrite();
+    prvTestRefill();
+    prvTestWrapAround();
+    prvTestFull();
+    prvTestNestedLock();
+
+    printf("%s (%u failed)\n", (ui32Failures == 0U) ? "PASS" : "FAIL", (unsigned)ui32Failures);
+    return (int)ui32Failures;
+}
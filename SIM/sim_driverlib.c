@@ -0,0 +1,203 @@
+ /******************************************************************************
+ *
+ * Module: SIM
+ *
+ * File Name: sim_driverlib.c
+ *
+ * Description: Host replacements for the TivaWare driverlib calls used by the firmware
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+#include "sim_driverlib.h"
+#include "sim_registers.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/adc.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+#define SIM_ADC_STEPS                8U
+#define SIM_ADC_CTL_CHANNEL_MASK     0x0000000FU
+#define SIM_INTERRUPT_FIRST_IRQ      16U      /* Vector numbers below are system exceptions */
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+typedef struct
+{
+    uint8 auChannel[SIM_ADC_STEPS];
+    uint8 uSteps;               /* Steps up to and including the one flagged ADC_CTL_END */
+    boolean bEnabled;
+    boolean bInterruptEnabled;
+} SIM_AdcSequenceType;
+
+/*******************************************************************************
+ *                              Private Variables                              *
+ *******************************************************************************/
+
+static uint16 SIM_AdcInput[SIM_ADC_CHANNELS];
+static SIM_AdcSequenceType SIM_AdcSequence[SIM_ADC_SEQUENCERS];
+
+/*******************************************************************************
+ *                         Public Functions Definitions                        *
+ *******************************************************************************/
+
+void SIM_AdcSetInput(uint8 uChannel, uint16 uRaw)
+{
+    if(uChannel < SIM_ADC_CHANNELS)
+    {
+        SIM_AdcInput[uChannel] = (uRaw > SIM_ADC_MAX_VALUE) ? SIM_ADC_MAX_VALUE : uRaw;
+    }
+}
+
+boolean SIM_AdcSequenceArmed(uint8 uSequence)
+{
+    return (uSequence < SIM_ADC_SEQUENCERS) &&
+           SIM_AdcSequence[uSequence].bEnabled && SIM_AdcSequence[uSequence].bInterruptEnabled;
+}
+
+/*******************************************************************************
+ *                          driverlib: System Control                          *
+ *******************************************************************************/
+
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral)
+{
+    (void)ui32Peripheral;
+}
+
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral)
+{
+    (void)ui32Peripheral;
+    return true;
+}
+
+/*******************************************************************************
+ *                         driverlib: Interrupt Control                        *
+ *******************************************************************************/
+
+void IntEnable(uint32_t ui32Interrupt)
+{
+    if(ui32Interrupt >= SIM_INTERRUPT_FIRST_IRQ)
+    {
+        SIM_NvicEnable((uint8)(ui32Interrupt - SIM_INTERRUPT_FIRST_IRQ));
+    }
+}
+
+/*******************************************************************************
+ *                                driverlib: GPIO                              *
+ *******************************************************************************/
+
+void GPIOPinTypeADC(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    (void)ui32Port;
+    (void)ui8Pins;
+}
+
+void GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    SIM_GpioSetOutput(SIM_GpioPortFromBase(ui32Port), ui8Pins);
+}
+
+void GPIODirModeSet(uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32PinIO)
+{
+    if(ui32PinIO == GPIO_DIR_MODE_OUT)
+    {
+        SIM_GpioSetOutput(SIM_GpioPortFromBase(ui32Port), ui8Pins);
+    }
+}
+
+void GPIOPadConfigSet(uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32Strength, uint32_t ui32PadType)
+{
+    /* Inputs idle high as if the weak pull-up was always on */
+    (void)ui32Port;
+    (void)ui8Pins;
+    (void)ui32Strength;
+    (void)ui32PadType;
+}
+
+void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val)
+{
+    SIM_GpioWrite(SIM_GpioPortFromBase(ui32Port), ui8Pins, ui8Val);
+}
+
+int32_t GPIOPinRead(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    return SIM_GpioRead(SIM_GpioPortFromBase(ui32Port), ui8Pins);
+}
+
+/*******************************************************************************
+ *                                driverlib: ADC                               *
+ *******************************************************************************/
+
+void ADCSequenceConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t ui32Trigger, uint32_t ui32Priority)
+{
+    /* Only ADC0 is modelled, converted when the peripheral model fires the trigger */
+    (void)ui32Base;
+    (void)ui32Trigger;
+    (void)ui32Priority;
+    SIM_AdcSequence[ui32SequenceNum].uSteps = 0;
+}
+
+void ADCSequenceStepConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t ui32Step, uint32_t ui32Config)
+{
+    (void)ui32Base;
+    if(ui32Step < SIM_ADC_STEPS)
+    {
+        SIM_AdcSequence[ui32SequenceNum].auChannel[ui32Step] = (uint8)(ui32Config & SIM_ADC_CTL_CHANNEL_MASK);
+        if(ui32Config & ADC_CTL_END)
+        {
+            SIM_AdcSequence[ui32SequenceNum].uSteps = (uint8)(ui32Step + 1);
+        }
+    }
+}
+
+void ADCSequenceEnable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    (void)ui32Base;
+    SIM_AdcSequence[ui32SequenceNum].bEnabled = TRUE;
+}
+
+void ADCSequenceDisable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    (void)ui32Base;
+    SIM_AdcSequence[ui32SequenceNum].bEnabled = FALSE;
+}
+
+void ADCIntEnable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    (void)ui32Base;
+    SIM_AdcSequence[ui32SequenceNum].bInterruptEnabled = TRUE;
+}
+
+void ADCIntClear(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    (void)ui32Base;
+    (void)ui32SequenceNum;
+}
+
+void ADCHardwareOversampleConfigure(uint32_t ui32Base, uint32_t ui32Factor)
+{
+    /* The simulated inputs are noise free, averaging changes nothing */
+    (void)ui32Base;
+    (void)ui32Factor;
+}
+
+int32_t ADCSequenceDataGet(uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t *pui32Buffer)
+{
+    const SIM_AdcSequenceType *pSequence = &SIM_AdcSequence[ui32SequenceNum];
+    uint8 uStep;
+
+    (void)ui32Base;
+    for(uStep = 0; uStep < pSequence->uSteps; uStep++)
+    {
+        pui32Buffer[uStep] = SIM_AdcInput[pSequence->auChannel[uStep]];
+    }
+    return pSequence->uSteps;
+}
@@ -0,0 +1,36 @@
+ /******************************************************************************
+ *
+ * Module: SIM
+ *
+ * File Name: sim_driverlib.h
+ *
+ * Description: Host replacements for the TivaWare driverlib calls used by the firmware
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+#ifndef SIM_DRIVERLIB_H_
+#define SIM_DRIVERLIB_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+#define SIM_ADC_CHANNELS             12U
+#define SIM_ADC_SEQUENCERS           4U
+#define SIM_ADC_MAX_VALUE            4095U
+#define SIM_ADC_INTERRUPT_BASE       14U      /* ADC0SS0 is interrupt 14, the others follow */
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/* Raw 12-bit value the ADC converts on a channel from now on */
+extern void SIM_AdcSetInput(uint8 uChannel, uint16 uRaw);
+
+/* TRUE if the sequencer is enabled with its interrupt enabled, so a trigger raises ADC0SSn */
+extern boolean SIM_AdcSequenceArmed(uint8 uSequence);
+
+#endif /* SIM_DRIVERLIB_H_ */
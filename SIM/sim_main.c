@@ -0,0 +1,54 @@
+ /******************************************************************************
+ *
+ * Module: SIM
+ *
+ * File Name: sim_main.c
+ *
+ * Description: Entry point and FreeRTOS hooks of the host simulation
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+#include "sim_peripherals.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The application main(), main.c is compiled with -Dmain=APP_main in this build */
+extern int APP_main(void);
+
+/*******************************************************************************
+ *                         Public Functions Definitions                        *
+ *******************************************************************************/
+
+/* Usage: seat_sim [input script [report file]], UART0 output goes to stdout */
+int main(int argc, char *argv[])
+{
+    if(!SIM_PeripheralsInit((argc > 1) ? argv[1] : NULL_PTR, (argc > 2) ? argv[2] : NULL_PTR))
+    {
+        return EXIT_FAILURE;
+    }
+
+    return APP_main();
+}
+
+void vAssertCalled(const char *pFile, unsigned long uLine)
+{
+    fflush(stdout);
+    fprintf(stderr, "\nSIM: assertion failed at %s:%lu\n", pFile, uLine);
+    abort();
+}
+
+void vApplicationMallocFailedHook(void)
+{
+    vAssertCalled(__FILE__, __LINE__);
+}
+
+void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+    (void)xTask;
+    fprintf(stderr, "\nSIM: stack overflow in %s\n", pcTaskName);
+    vAssertCalled(__FILE__, __LINE__);
+}
@@ -0,0 +1,422 @@
+ /******************************************************************************
+ *
+ * Module: SIM
+ *
+ * File Name: sim_peripherals.c
+ *
+ * Description: Peripheral and interrupt model of the host simulation
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+/*
+ * The peripherals are advanced by a FreeRTOS task at the highest priority, once
+ * per tick. It applies the scripted inputs, runs the timers and calls the
+ * interrupt handlers whose sources are pending and enabled in the NVIC, the
+ * way the vector table would. Handlers run to completion in that task, so the
+ * FromISR calls they make behave as on the target.
+ */
+
+#include "sim_peripherals.h"
+#include "sim_registers.h"
+#include "sim_driverlib.h"
+#include "sim_thermal.h"
+#include "tm4c123gh6pm_registers.h"
+#include "GPTM.h"
+#include "uart0.h"
+#include "udma.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "SERVICES/RUNTIME/runtime.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+#define SIM_LINE_MAX                 128U
+#define SIM_TEXT_MAX                 48U      /* Characters of a uart event line, newline included */
+#define SIM_ADC_TRIGGER_SEQUENCE     1U
+#define SIM_TICKS_PER_OS_TICK        (SIM_CLOCK_HZ / configTICK_RATE_HZ)
+
+/* Own runtime slot, below the one of the untagged tasks: the interrupt work done here counts as load, not as idle time */
+#define SIM_TASK_TAG                 (RUNTIME_OTHER_TAG - 1)
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+typedef enum
+{
+    SIM_EVENT_ADC,
+    SIM_EVENT_PRESS,
+    SIM_EVENT_RELEASE,
+    SIM_EVENT_PLANT,
+    SIM_EVENT_TARGET,
+    SIM_EVENT_DROPOUT,
+    SIM_EVENT_UART,
+    SIM_EVENT_QUIT
+} SIM_EventKindType;
+
+typedef struct
+{
+    uint32 uTimeMs;
+    SIM_EventKindType eKind;
+    uint8 uChannel;          /* ADC channel, seat, or index into SIM_Buttons */
+    uint16 uValue;
+    double adArgs[4];        /* Thermal model parameters */
+    char acText[SIM_TEXT_MAX];  /* UART0 input */
+} SIM_EventType;
+
+typedef struct
+{
+    const char *pName;
+    SIM_PortType ePort;
+    uint8 uPin;
+} SIM_ButtonType;
+
+/*******************************************************************************
+ *                        Interrupt Handlers (vector table)                    *
+ *******************************************************************************/
+extern void GPIOPortB_Handler(void);
+extern void GPIOPortF_Handler(void);
+extern void UART0_Handler(void);
+extern void ADC0SS1_Handler(void);
+extern void TIMER1A_Handler(void);
+
+/*******************************************************************************
+ *                              Private Variables                              *
+ *******************************************************************************/
+
+static const SIM_ButtonType SIM_Buttons[] = {
+    {"sw1", SIM_PORTF, (1<<4)},
+    {"sw2", SIM_PORTF, (1<<0)},
+    {"ext", SIM_PORTB, (1<<0)}
+};
+
+static SIM_EventType SIM_Events[SIM_MAX_EVENTS];
+static uint32 SIM_EventCount = 0;
+static uint32 SIM_NextEvent = 0;
+
+static const char *SIM_ReportPath = NULL_PTR;
+
+static uint32 SIM_Timer0Elapsed = 0;
+static uint32 SIM_Timer1Elapsed = 0;
+
+/*******************************************************************************
+ *                         Private Functions Definitions                       *
+ *******************************************************************************/
+
+static boolean SIM_FindButton(const char *pName, uint8 *pIndex)
+{
+    uint8 uIndex;
+
+    for(uIndex = 0; uIndex < (sizeof(SIM_Buttons) / sizeof(SIM_Buttons[0])); uIndex++)
+    {
+        if(strcmp(SIM_Buttons[uIndex].pName, pName) == 0)
+        {
+            *pIndex = uIndex;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static boolean SIM_ParseLine(const char *pLine, SIM_EventType *pEvent)
+{
+    char acKind[16];
+    char acArg[16];
+    unsigned uTime;
+    unsigned uChannel;
+    unsigned uValue;
+    uint8 uButton;
+
+    if(sscanf(pLine, "%u %15s", &uTime, acKind) != 2)
+    {
+        return FALSE;
+    }
+    pEvent->uTimeMs = uTime;
+
+    if((strcmp(acKind, "adc") == 0) && (sscanf(pLine, "%*u %*s %u %u", &uChannel, &uValue) == 2))
+    {
+        pEvent->eKind = SIM_EVENT_ADC;
+        pEvent->uChannel = (uint8)uChannel;
+        pEvent->uValue = (uint16)uValue;
+        return TRUE;
+    }
+    if(((strcmp(acKind, "press") == 0) || (strcmp(acKind, "release") == 0)) &&
+       (sscanf(pLine, "%*u %*s %15s", acArg) == 1) && SIM_FindButton(acArg, &uButton))
+    {
+        pEvent->eKind = (acKind[0] == 'p') ? SIM_EVENT_PRESS : SIM_EVENT_RELEASE;
+        pEvent->uChannel = uButton;
+        return TRUE;
+    }
+    if((strcmp(acKind, "plant") == 0) &&
+       (sscanf(pLine, "%*u %*s %u %lf %lf %lf %lf", &uChannel, &pEvent->adArgs[0], &pEvent->adArgs[1],
+               &pEvent->adArgs[2], &pEvent->adArgs[3]) == 5))
+    {
+        pEvent->eKind = SIM_EVENT_PLANT;
+        pEvent->uChannel = (uint8)uChannel;
+        return TRUE;
+    }
+    if((strcmp(acKind, "target") == 0) &&
+       (sscanf(pLine, "%*u %*s %u %lf", &uChannel, &pEvent->adArgs[0]) == 2))
+    {
+        pEvent->eKind = SIM_EVENT_TARGET;
+        pEvent->uChannel = (uint8)uChannel;
+        return TRUE;
+    }
+    if((strcmp(acKind, "dropout") == 0) && (sscanf(pLine, "%*u %*s %u %15s", &uChannel, acArg) == 2) &&
+       ((strcmp(acArg, "on") == 0) || (strcmp(acArg, "off") == 0)))
+    {
+        pEvent->eKind = SIM_EVENT_DROPOUT;
+        pEvent->uChannel = (uint8)uChannel;
+        pEvent->uValue = (acArg[1] == 'n') ? TRUE : FALSE;
+        return TRUE;
+    }
+    if(strcmp(acKind, "uart") == 0)
+    {
+        /* The rest of the line after one separator, sent with a CR LF like a terminal would */
+        const char *pText = strstr(pLine, "uart") + 4;
+        size_t uLength;
+
+        pText += strspn(pText, " \t");
+        uLength = strcspn(pText, "\r\n");
+        if(uLength > (SIM_TEXT_MAX - 3))
+        {
+            return FALSE;
+        }
+        memcpy(pEvent->acText, pText, uLength);
+        strcpy(&pEvent->acText[uLength], "\r\n");
+        pEvent->eKind = SIM_EVENT_UART;
+        return TRUE;
+    }
+    if(strcmp(acKind, "quit") == 0)
+    {
+        pEvent->eKind = SIM_EVENT_QUIT;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static boolean SIM_LoadScript(const char *pScriptPath)
+{
+    char acLine[SIM_LINE_MAX];
+    uint32 uLineNumber = 0;
+    FILE *pFile = fopen(pScriptPath, "r");
+
+    if(pFile == NULL)
+    {
+        fprintf(stderr, "SIM: cannot open %s\n", pScriptPath);
+        return FALSE;
+    }
+
+    while(fgets(acLine, sizeof(acLine), pFile) != NULL)
+    {
+        char *pComment = strchr(acLine, '#');
+        SIM_EventType sEvent;
+
+        uLineNumber++;
+        if(pComment != NULL)
+        {
+            *pComment = '\0';
+        }
+        if(strspn(acLine, " \t\r\n") == strlen(acLine))
+        {
+            continue;
+        }
+        if(!SIM_ParseLine(acLine, &sEvent) || (SIM_EventCount >= SIM_MAX_EVENTS) ||
+           ((SIM_EventCount > 0) && (sEvent.uTimeMs < SIM_Events[SIM_EventCount - 1].uTimeMs)))
+        {
+            fprintf(stderr, "SIM: %s:%u: bad, out of order or too many events\n", pScriptPath, (unsigned)uLineNumber);
+            fclose(pFile);
+            return FALSE;
+        }
+        SIM_Events[SIM_EventCount++] = sEvent;
+    }
+
+    fclose(pFile);
+    return TRUE;
+}
+
+static void SIM_Quit(uint32 uNowMs)
+{
+    FILE *pReport = (SIM_ReportPath != NULL_PTR) ? fopen(SIM_ReportPath, "w") : NULL;
+
+    fflush(stdout);
+    fprintf(stderr, "\nSIM: quit at %u ms\n", (unsigned)uNowMs);
+    if((SIM_ReportPath != NULL_PTR) && (pReport == NULL))
+    {
+        fprintf(stderr, "SIM: cannot write %s\n", SIM_ReportPath);
+        exit(EXIT_FAILURE);
+    }
+    SIM_ThermalReport((pReport != NULL) ? pReport : stderr, uNowMs);
+    if(pReport != NULL)
+    {
+        fclose(pReport);
+    }
+    exit(EXIT_SUCCESS);
+}
+
+static void SIM_ApplyEvents(uint32 uNowMs)
+{
+    while((SIM_NextEvent < SIM_EventCount) && (SIM_Events[SIM_NextEvent].uTimeMs <= uNowMs))
+    {
+        const SIM_EventType *pEvent = &SIM_Events[SIM_NextEvent++];
+        const SIM_ButtonType *pButton = &SIM_Buttons[pEvent->uChannel];
+
+        switch(pEvent->eKind)
+        {
+        case SIM_EVENT_ADC:
+            SIM_AdcSetInput(pEvent->uChannel, pEvent->uValue);
+            break;
+        case SIM_EVENT_PRESS:
+            SIM_GpioSetInput(pButton->ePort, pButton->uPin, 0);        /* Buttons pull the pin low */
+            break;
+        case SIM_EVENT_RELEASE:
+            SIM_GpioSetInput(pButton->ePort, pButton->uPin, pButton->uPin);
+            break;
+        case SIM_EVENT_PLANT:
+            SIM_ThermalSetPlant(pEvent->uChannel, pEvent->adArgs[0], pEvent->adArgs[1],
+                                pEvent->adArgs[2], pEvent->adArgs[3]);
+            break;
+        case SIM_EVENT_TARGET:
+            SIM_ThermalSetTarget(pEvent->uChannel, pEvent->adArgs[0], uNowMs);
+            break;
+        case SIM_EVENT_DROPOUT:
+            SIM_ThermalSetDropout(pEvent->uChannel, (boolean)pEvent->uValue);
+            break;
+        case SIM_EVENT_UART:
+            SIM_UartInput((const uint8 *)pEvent->acText, (uint32)strlen(pEvent->acText));
+            break;
+        case SIM_EVENT_QUIT:
+            SIM_Quit(uNowMs);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/* Advance a periodic timer by one OS tick, returns the number of time-outs */
+static uint32 SIM_TimerAdvance(uint32 *pElapsed, uint32 uLoad)
+{
+    uint32 uPeriod = uLoad + 1;
+    uint32 uTimeouts = 0;
+
+    *pElapsed += SIM_TICKS_PER_OS_TICK;
+    while(*pElapsed >= uPeriod)
+    {
+        *pElapsed -= uPeriod;
+        uTimeouts++;
+    }
+    return uTimeouts;
+}
+
+static void SIM_RunTimers(void)
+{
+    uint32 uTimeouts;
+
+    /* Timer0A: its time-out triggers ADC0 sequencer 1 */
+    if(TIMER0_CTL_REG & GPTM_CTL_TAEN_MASK)
+    {
+        uTimeouts = SIM_TimerAdvance(&SIM_Timer0Elapsed, TIMER0_TAILR_REG);
+        while(uTimeouts--)
+        {
+            if((TIMER0_CTL_REG & GPTM_CTL_TAOTE_MASK) && SIM_AdcSequenceArmed(SIM_ADC_TRIGGER_SEQUENCE) &&
+               SIM_NvicIsEnabled(SIM_IRQ_ADC0SS1))
+            {
+                ADC0SS1_Handler();
+            }
+        }
+    }
+    else
+    {
+        SIM_Timer0Elapsed = 0;
+    }
+
+    /* Timer1A: time-out interrupt */
+    if(TIMER1_CTL_REG & GPTM_CTL_TAEN_MASK)
+    {
+        uTimeouts = SIM_TimerAdvance(&SIM_Timer1Elapsed, TIMER1_TAILR_REG);
+        while(uTimeouts-- && (TIMER1_CTL_REG & GPTM_CTL_TAEN_MASK))
+        {
+            if((TIMER1_IMR_REG & GPTM_IMR_TATOIM_MASK) && SIM_NvicIsEnabled(SIM_IRQ_TIMER1A))
+            {
+                TIMER1A_Handler();
+            }
+        }
+    }
+    else
+    {
+        SIM_Timer1Elapsed = 0;
+    }
+}
+
+static void SIM_RunInterrupts(void)
+{
+    if(SIM_GpioPendingInterrupts(SIM_PORTF) && SIM_NvicIsEnabled(SIM_IRQ_GPIOF))
+    {
+        GPIOPortF_Handler();
+    }
+    if(SIM_GpioPendingInterrupts(SIM_PORTB) && SIM_NvicIsEnabled(SIM_IRQ_GPIOB))
+    {
+        GPIOPortB_Handler();
+    }
+
+    /* The TX FIFO is always empty here, so an unmasked TX interrupt is always pending.
+     * Input reaches the RX FIFO all at once, as if the receive time-out had expired. */
+    if(SIM_NvicIsEnabled(SIM_IRQ_UART0) &&
+       ((UART0_IM_REG & UART_IM_TXIM_MASK) || SIM_UdmaChannelDone(UDMA_CHANNEL_UART0TX) ||
+        ((UART0_IM_REG & (UART_IM_RXIM_MASK | UART_IM_RTIM_MASK)) && SIM_UartRxPending())))
+    {
+        SIM_UartRxDeliver(TRUE);
+        UART0_Handler();
+        SIM_UartRxDeliver(FALSE);
+    }
+}
+
+static void SIM_PeripheralsTask(void *pvParameters)
+{
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+
+    (void)pvParameters;
+    for(;;)
+    {
+        uint32 uNowMs = (uint32)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+
+        SIM_ApplyEvents(uNowMs);
+        SIM_ThermalStep(uNowMs);
+        SIM_RunTimers();
+        SIM_UdmaRun();
+        SIM_RunInterrupts();
+        SIM_RegSync();
+        vTaskDelayUntil(&xLastWakeTime, 1);
+    }
+}
+
+/*******************************************************************************
+ *                         Public Functions Definitions                        *
+ *******************************************************************************/
+
+boolean SIM_PeripheralsInit(const char *pScriptPath, const char *pReportPath)
+{
+    TaskHandle_t xHandle;
+
+    SIM_ReportPath = pReportPath;
+
+    if((pScriptPath != NULL_PTR) && !SIM_LoadScript(pScriptPath))
+    {
+        return FALSE;
+    }
+
+    if(xTaskCreate(SIM_PeripheralsTask, "SIM Peripherals", SIM_TASK_STACK_SIZE, NULL,
+                   configMAX_PRIORITIES - 1, &xHandle) != pdPASS)
+    {
+        return FALSE;
+    }
+    vTaskSetApplicationTaskTag(xHandle, (TaskHookFunction_t)SIM_TASK_TAG);
+    return TRUE;
+}
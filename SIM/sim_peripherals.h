@@ -0,0 +1,55 @@
+ /******************************************************************************
+ *
+ * Module: SIM
+ *
+ * File Name: sim_peripherals.h
+ *
+ * Description: Peripheral and interrupt model of the host simulation
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+#ifndef SIM_PERIPHERALS_H_
+#define SIM_PERIPHERALS_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+#define SIM_MAX_EVENTS               512U
+#define SIM_TASK_STACK_SIZE          256U
+
+/* Interrupt numbers (vector number minus 16) of the modelled sources */
+#define SIM_IRQ_GPIOB                1U
+#define SIM_IRQ_UART0                5U
+#define SIM_IRQ_ADC0SS1              15U
+#define SIM_IRQ_TIMER1A              21U
+#define SIM_IRQ_GPIOF                30U
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*
+ * Load the input script (NULL_PTR for none) and create the peripheral task.
+ * The benchmark report (sim_thermal.h) is written to pReportPath at quit,
+ * to stderr when it is NULL_PTR. Call before vTaskStartScheduler.
+ *
+ * Script lines, times in ms since the scheduler started, '#' starts a comment:
+ *   <ms> adc <channel> <raw 0-4095>
+ *   <ms> press <sw1|sw2|ext>
+ *   <ms> release <sw1|sw2|ext>
+ *   <ms> plant <seat> <ambient C> <initial C> <tau s> <rise C at 100%>
+ *   <ms> target <seat> <C>
+ *   <ms> dropout <seat> <on|off>
+ *   <ms> uart <text>            (received by UART0 as one line)
+ *   <ms> quit
+ */
+extern boolean SIM_PeripheralsInit(const char *pScriptPath, const char *pReportPath);
+
+/* Simulated uDMA controller (sim_udma.c): performs the enabled transfers, called on every tick */
+extern void SIM_UdmaRun(void);
+
+#endif /* SIM_PERIPHERALS_H_ */
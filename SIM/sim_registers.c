@@ -0,0 +1,552 @@
+ /******************************************************************************
+ *
+ * Module: SIM
+ *
+ * File Name: sim_registers.c
+ *
+ * Description: Simulated TM4C123GH6PM register bank for the host build
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+#include "sim_registers.h"
+#include <stdio.h>
+#include <time.h>
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+#define SIM_SYSCTL_RCGC_FIRST        0x400FE600U   /* Run mode clock gating registers */
+#define SIM_SYSCTL_RCGC_LAST         0x400FE65CU
+#define SIM_SYSCTL_PR_OFFSET         0x400U        /* Peripheral ready registers mirror RCGC 0x400 higher */
+
+#define SIM_NVIC_EN0                 0xE000E100U
+#define SIM_NVIC_EN1                 0xE000E104U
+#define SIM_NVIC_DIS0                0xE000E180U
+#define SIM_NVIC_DIS1                0xE000E184U
+
+#define SIM_UART0_DR                 0x4000C000U
+#define SIM_UART0_FR                 0x4000C018U
+#define SIM_UART_FR_IDLE             0x00000090U   /* TXFE and RXFE: the TX FIFO drains instantly, nothing is received */
+#define SIM_UART_FR_RXFE             0x00000010U
+#define SIM_UART_DR_EMPTY            0xFFFFFFFFU   /* Marks the data register slot as not written */
+#define SIM_UART_RX_QUEUE_SIZE       256U          /* Scripted input waiting to be received (power of two) */
+
+#define SIM_UDMA_ENASET              0x400FF028U
+#define SIM_UDMA_ENACLR              0x400FF02CU
+#define SIM_UDMA_CHIS                0x400FF504U
+#define SIM_UDMA_CHIS_READ_MARK      0x80000000U   /* Channel 31 is unused: the bits just read, stored back to clear them, still differ */
+
+#define SIM_WTIMER0_TAR              0x40036048U
+#define SIM_WTIMER0_TBR              0x4003604CU
+#define SIM_WTIMER0_TAV              0x40036050U
+#define SIM_WTIMER0_TBV              0x40036054U
+
+#define SIM_BITBAND_ALIAS_FIRST      0x42000000U   /* Peripheral bit-band alias region, one word per register bit */
+#define SIM_BITBAND_ALIAS_LAST       0x43FFFFFCU
+#define SIM_BITBAND_PERIPH_BASE      0x40000000U
+
+#define SIM_GPIO_DATA_WINDOW         0x400U        /* Masked data aliases, address bits 9:2 select the pins */
+#define SIM_GPIO_DIR                 0x400U
+#define SIM_GPIO_IM                  0x410U
+#define SIM_GPIO_RIS                 0x414U
+#define SIM_GPIO_MIS                 0x418U
+#define SIM_GPIO_ICR                 0x41CU
+#define SIM_GPIO_IS                  0x404U
+#define SIM_GPIO_IBE                 0x408U
+#define SIM_GPIO_IEV                 0x40CU
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+typedef struct
+{
+    uint32 uAddress;
+    uint32 uValue;
+    boolean bUsed;
+} SIM_RegSlotType;
+
+typedef enum
+{
+    SIM_WATCH_UART_DR,
+    SIM_WATCH_NVIC_EN,
+    SIM_WATCH_NVIC_DIS,
+    SIM_WATCH_UDMA_ENASET,
+    SIM_WATCH_UDMA_ENACLR,
+    SIM_WATCH_UDMA_CHIS,
+    SIM_WATCH_GPIO_ICR,
+    SIM_WATCH_GPIO_DATA,
+    SIM_WATCH_BITBAND
+} SIM_WatchKindType;
+
+/* A register whose stores are compared against the value it was armed with */
+typedef struct
+{
+    SIM_RegSlotType *pSlot;
+    uint32 uArmed;
+    SIM_WatchKindType eKind;
+} SIM_WatchType;
+
+typedef struct
+{
+    uint8 uInput;       /* Level driven from outside, pull-ups make it 1 by default */
+    uint8 uOutput;      /* Output latch */
+    uint8 uRis;         /* Raw interrupt status */
+} SIM_GpioStateType;
+
+/*******************************************************************************
+ *                              Private Variables                              *
+ *******************************************************************************/
+
+static SIM_RegSlotType SIM_Bank[SIM_REG_BANK_SIZE];
+static SIM_WatchType SIM_Watch[SIM_WATCH_MAX];
+static uint32 SIM_WatchCount = 0;
+
+static uint32 SIM_NvicEnabled[2] = {0, 0};
+
+/* uDMA channel enable bits (ENASET/ENACLR) and completion interrupt status (CHIS, write 1 to clear) */
+static uint32 SIM_UdmaEnabled = 0;
+static uint32 SIM_UdmaDone = 0;
+
+/* UART0 input: the receive FIFO only shows bytes while SIM_UartRxDeliver has opened it */
+static uint8 SIM_UartRxQueue[SIM_UART_RX_QUEUE_SIZE];
+static uint32 SIM_UartRxHead = 0;
+static uint32 SIM_UartRxTail = 0;
+static boolean SIM_UartRxOpen = FALSE;
+
+static SIM_GpioStateType SIM_Gpio[SIM_PORT_COUNT] = {
+    {0xFF, 0, 0}, {0xFF, 0, 0}, {0xFF, 0, 0}, {0xFF, 0, 0}, {0xFF, 0, 0}, {0xFF, 0, 0}
+};
+
+static const uint32 SIM_GpioBases[SIM_PORT_COUNT] = {
+    SIM_GPIO_PORTA_BASE, SIM_GPIO_PORTB_BASE, SIM_GPIO_PORTC_BASE,
+    SIM_GPIO_PORTD_BASE, SIM_GPIO_PORTE_BASE, SIM_GPIO_PORTF_BASE
+};
+
+/*******************************************************************************
+ *                         Private Functions Definitions                       *
+ *******************************************************************************/
+
+static SIM_RegSlotType *SIM_FindSlot(uint32 uAddress)
+{
+    uint32 uIndex = (uAddress >> 2) & (SIM_REG_BANK_SIZE - 1);
+    uint32 uProbe;
+
+    for(uProbe = 0; uProbe < SIM_REG_BANK_SIZE; uProbe++)
+    {
+        SIM_RegSlotType *pSlot = &SIM_Bank[(uIndex + uProbe) & (SIM_REG_BANK_SIZE - 1)];
+
+        if(!pSlot->bUsed)
+        {
+            pSlot->bUsed = TRUE;
+            pSlot->uAddress = uAddress;
+            pSlot->uValue = 0;
+            return pSlot;
+        }
+        if(pSlot->uAddress == uAddress)
+        {
+            return pSlot;
+        }
+    }
+
+    fprintf(stderr, "SIM: register bank full at 0x%08X\n", (unsigned)uAddress);
+    return &SIM_Bank[uIndex];
+}
+
+static uint32 SIM_RegRead(uint32 uAddress)
+{
+    return SIM_FindSlot(uAddress)->uValue;
+}
+
+/* Register and bit a bit-band alias word stands for */
+static uint32 SIM_BitbandRegister(uint32 uAlias)
+{
+    return SIM_BITBAND_PERIPH_BASE + (((uAlias - SIM_BITBAND_ALIAS_FIRST) >> 5) & ~3U);
+}
+
+static uint32 SIM_BitbandBit(uint32 uAlias)
+{
+    return (uAlias >> 2) & 31U;
+}
+
+/* Port whose register window holds uAddress, SIM_PORT_COUNT if none */
+static SIM_PortType SIM_GpioPortOf(uint32 uAddress)
+{
+    uint8 uPort;
+
+    for(uPort = 0; uPort < SIM_PORT_COUNT; uPort++)
+    {
+        if((uAddress & ~0xFFFU) == SIM_GpioBases[uPort])
+        {
+            return (SIM_PortType)uPort;
+        }
+    }
+    return SIM_PORT_COUNT;
+}
+
+/* Pin level as read back through the data register: outputs from the latch, inputs from outside */
+static uint8 SIM_GpioLevel(SIM_PortType ePort)
+{
+    uint8 uDir = (uint8)SIM_RegRead(SIM_GpioBases[ePort] + SIM_GPIO_DIR);
+
+    return (uint8)((SIM_Gpio[ePort].uOutput & uDir) | (SIM_Gpio[ePort].uInput & ~uDir));
+}
+
+static void SIM_WatchAdd(SIM_RegSlotType *pSlot, SIM_WatchKindType eKind, uint32 uArmed)
+{
+    uint32 uCounter;
+
+    for(uCounter = 0; uCounter < SIM_WatchCount; uCounter++)
+    {
+        if(SIM_Watch[uCounter].pSlot == pSlot)
+        {
+            return;
+        }
+    }
+    if(SIM_WatchCount < SIM_WATCH_MAX)
+    {
+        SIM_Watch[SIM_WatchCount].pSlot = pSlot;
+        SIM_Watch[SIM_WatchCount].eKind = eKind;
+        SIM_Watch[SIM_WatchCount].uArmed = uArmed;
+        pSlot->uValue = uArmed;
+        SIM_WatchCount++;
+    }
+}
+
+static boolean SIM_UartRxReadable(void)
+{
+    return (SIM_UartRxOpen && (SIM_UartRxHead != SIM_UartRxTail)) ? TRUE : FALSE;
+}
+
+/* Value a watched register reads as, and the value a store is detected against */
+static uint32 SIM_WatchArmValue(const SIM_WatchType *pWatch)
+{
+    uint32 uAddress = pWatch->pSlot->uAddress;
+
+    switch(pWatch->eKind)
+    {
+    case SIM_WATCH_UART_DR:
+        return SIM_UART_DR_EMPTY;
+    case SIM_WATCH_NVIC_EN:
+        return SIM_NvicEnabled[(uAddress - SIM_NVIC_EN0) >> 2];
+    case SIM_WATCH_UDMA_ENASET:
+        return SIM_UdmaEnabled;
+    case SIM_WATCH_UDMA_CHIS:
+        return SIM_UdmaDone | SIM_UDMA_CHIS_READ_MARK;
+    case SIM_WATCH_GPIO_DATA:
+        return SIM_GpioLevel(SIM_GpioPortOf(uAddress)) & ((uAddress >> 2) & 0xFFU);
+    case SIM_WATCH_BITBAND:
+        return (SIM_RegRead(SIM_BitbandRegister(uAddress)) >> SIM_BitbandBit(uAddress)) & 1U;
+    default:
+        return 0;
+    }
+}
+
+static void SIM_WatchCommit(const SIM_WatchType *pWatch, uint32 uValue)
+{
+    uint32 uAddress = pWatch->pSlot->uAddress;
+    SIM_RegSlotType *pSlot;
+    SIM_PortType ePort;
+    uint8 uMask;
+    uint8 uByte;
+
+    switch(pWatch->eKind)
+    {
+    case SIM_WATCH_UART_DR:
+        uByte = (uint8)uValue;
+        SIM_UartOutput(&uByte, 1);
+        break;
+    case SIM_WATCH_NVIC_EN:
+        SIM_NvicEnabled[(uAddress - SIM_NVIC_EN0) >> 2] |= uValue;
+        break;
+    case SIM_WATCH_NVIC_DIS:
+        SIM_NvicEnabled[(uAddress - SIM_NVIC_DIS0) >> 2] &= ~uValue;
+        break;
+    case SIM_WATCH_UDMA_ENASET:
+        SIM_UdmaEnabled |= uValue;
+        break;
+    case SIM_WATCH_UDMA_ENACLR:
+        SIM_UdmaEnabled &= ~uValue;
+        break;
+    case SIM_WATCH_UDMA_CHIS:
+        SIM_UdmaDone &= ~(uValue & ~SIM_UDMA_CHIS_READ_MARK);
+        break;
+    case SIM_WATCH_GPIO_ICR:
+        SIM_Gpio[SIM_GpioPortOf(uAddress)].uRis &= (uint8)~uValue;
+        break;
+    case SIM_WATCH_GPIO_DATA:
+        ePort = SIM_GpioPortOf(uAddress);
+        uMask = (uint8)((uAddress >> 2) & 0xFFU);
+        SIM_Gpio[ePort].uOutput = (uint8)((SIM_Gpio[ePort].uOutput & ~uMask) | (uValue & uMask));
+        break;
+    case SIM_WATCH_BITBAND:
+        /* Plain storage registers only (IM and the like), a watched target sees the change on its next sync */
+        pSlot = SIM_FindSlot(SIM_BitbandRegister(uAddress));
+        if(uValue & 1U)
+        {
+            pSlot->uValue |= (1UL << SIM_BitbandBit(uAddress));
+        }
+        else
+        {
+            pSlot->uValue &= ~(1UL << SIM_BitbandBit(uAddress));
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/* Registers that behave like status or side-effect registers rather than plain storage */
+static void SIM_PrepareSlot(uint32 uAddress, SIM_RegSlotType *pSlot)
+{
+    SIM_PortType ePort = SIM_GpioPortOf(uAddress);
+    uint32 uOffset = uAddress & 0xFFFU;
+    uint64 uTicks;
+
+    if((uAddress >= (SIM_SYSCTL_RCGC_FIRST + SIM_SYSCTL_PR_OFFSET)) &&
+       (uAddress <= (SIM_SYSCTL_RCGC_LAST + SIM_SYSCTL_PR_OFFSET)))
+    {
+        pSlot->uValue = SIM_RegRead(uAddress - SIM_SYSCTL_PR_OFFSET);   /* Clocks are ready at once */
+    }
+    else if((uAddress >= SIM_BITBAND_ALIAS_FIRST) && (uAddress <= SIM_BITBAND_ALIAS_LAST))
+    {
+        SIM_WatchAdd(pSlot, SIM_WATCH_BITBAND, (SIM_RegRead(SIM_BitbandRegister(uAddress)) >> SIM_BitbandBit(uAddress)) & 1U);
+    }
+    else if(uAddress == SIM_UART0_DR)
+    {
+        SIM_WatchAdd(pSlot, SIM_WATCH_UART_DR, SIM_UART_DR_EMPTY);
+    }
+    else if(uAddress == SIM_UART0_FR)
+    {
+        pSlot->uValue = SIM_UART_FR_IDLE & ~(SIM_UartRxReadable() ? SIM_UART_FR_RXFE : 0U);
+    }
+    else if((uAddress == SIM_NVIC_EN0) || (uAddress == SIM_NVIC_EN1))
+    {
+        SIM_WatchAdd(pSlot, SIM_WATCH_NVIC_EN, SIM_NvicEnabled[(uAddress - SIM_NVIC_EN0) >> 2]);
+    }
+    else if((uAddress == SIM_NVIC_DIS0) || (uAddress == SIM_NVIC_DIS1))
+    {
+        SIM_WatchAdd(pSlot, SIM_WATCH_NVIC_DIS, 0);
+    }
+    else if(uAddress == SIM_UDMA_ENASET)
+    {
+        SIM_WatchAdd(pSlot, SIM_WATCH_UDMA_ENASET, SIM_UdmaEnabled);
+    }
+    else if(uAddress == SIM_UDMA_ENACLR)
+    {
+        SIM_WatchAdd(pSlot, SIM_WATCH_UDMA_ENACLR, 0);
+    }
+    else if(uAddress == SIM_UDMA_CHIS)
+    {
+        SIM_WatchAdd(pSlot, SIM_WATCH_UDMA_CHIS, SIM_UdmaDone | SIM_UDMA_CHIS_READ_MARK);
+    }
+    else if((uAddress == SIM_WTIMER0_TAR) || (uAddress == SIM_WTIMER0_TAV))
+    {
+        uTicks = SIM_ClockTicks();
+        pSlot->uValue = (uint32)uTicks;
+    }
+    else if((uAddress == SIM_WTIMER0_TBR) || (uAddress == SIM_WTIMER0_TBV))
+    {
+        uTicks = SIM_ClockTicks();
+        pSlot->uValue = (uint32)(uTicks >> 32);
+    }
+    else if(ePort != SIM_PORT_COUNT)
+    {
+        if(uOffset < SIM_GPIO_DATA_WINDOW)
+        {
+            SIM_WatchAdd(pSlot, SIM_WATCH_GPIO_DATA, 0);
+        }
+        else if(uOffset == SIM_GPIO_ICR)
+        {
+            SIM_WatchAdd(pSlot, SIM_WATCH_GPIO_ICR, 0);
+        }
+        else if(uOffset == SIM_GPIO_RIS)
+        {
+            pSlot->uValue = SIM_Gpio[ePort].uRis;
+        }
+        else if(uOffset == SIM_GPIO_MIS)
+        {
+            pSlot->uValue = SIM_GpioPendingInterrupts(ePort);
+        }
+    }
+}
+
+/*******************************************************************************
+ *                         Public Functions Definitions                        *
+ *******************************************************************************/
+
+volatile uint32 *SIM_RegAccess(uint32 uAddress)
+{
+    SIM_RegSlotType *pSlot;
+    uint32 uCounter;
+
+    SIM_RegSync();
+
+    pSlot = SIM_FindSlot(uAddress);
+    SIM_PrepareSlot(uAddress, pSlot);
+
+    /* Reads of a watched register see its current state */
+    for(uCounter = 0; uCounter < SIM_WatchCount; uCounter++)
+    {
+        if(SIM_Watch[uCounter].pSlot == pSlot)
+        {
+            SIM_Watch[uCounter].uArmed = SIM_WatchArmValue(&SIM_Watch[uCounter]);
+
+            /* An open receive FIFO hands out one byte per data register access, a byte is never a store */
+            if((SIM_Watch[uCounter].eKind == SIM_WATCH_UART_DR) && SIM_UartRxReadable())
+            {
+                SIM_Watch[uCounter].uArmed = SIM_UartRxQueue[SIM_UartRxTail];
+                SIM_UartRxTail = (SIM_UartRxTail + 1) & (SIM_UART_RX_QUEUE_SIZE - 1);
+            }
+            pSlot->uValue = SIM_Watch[uCounter].uArmed;
+        }
+    }
+
+    return &pSlot->uValue;
+}
+
+void SIM_RegSync(void)
+{
+    uint32 uCounter;
+
+    for(uCounter = 0; uCounter < SIM_WatchCount; uCounter++)
+    {
+        SIM_WatchType *pWatch = &SIM_Watch[uCounter];
+
+        if(pWatch->pSlot->uValue != pWatch->uArmed)
+        {
+            SIM_WatchCommit(pWatch, pWatch->pSlot->uValue);
+            pWatch->uArmed = SIM_WatchArmValue(pWatch);
+            pWatch->pSlot->uValue = pWatch->uArmed;
+        }
+    }
+}
+
+uint64 SIM_ClockTicks(void)
+{
+    static struct timespec sStart;
+    static boolean bStarted = FALSE;
+    struct timespec sNow;
+    uint64 uNs;
+
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    if(!bStarted)
+    {
+        sStart = sNow;
+        bStarted = TRUE;
+    }
+
+    uNs = (uint64)(sNow.tv_sec - sStart.tv_sec) * 1000000000ULL + (uint64)sNow.tv_nsec - (uint64)sStart.tv_nsec;
+    return (uNs * (SIM_CLOCK_HZ / 1000000U)) / 1000U;
+}
+
+boolean SIM_NvicIsEnabled(uint8 uInterrupt)
+{
+    SIM_RegSync();
+    return (SIM_NvicEnabled[uInterrupt >> 5] & (1UL << (uInterrupt & 31U))) ? TRUE : FALSE;
+}
+
+void SIM_NvicEnable(uint8 uInterrupt)
+{
+    SIM_NvicEnabled[uInterrupt >> 5] |= (1UL << (uInterrupt & 31U));
+}
+
+boolean SIM_UdmaChannelEnabled(uint8 uChannel)
+{
+    SIM_RegSync();
+    return (SIM_UdmaEnabled & (1UL << uChannel)) ? TRUE : FALSE;
+}
+
+boolean SIM_UdmaChannelDone(uint8 uChannel)
+{
+    SIM_RegSync();
+    return (SIM_UdmaDone & (1UL << uChannel)) ? TRUE : FALSE;
+}
+
+void SIM_UdmaChannelComplete(uint8 uChannel)
+{
+    SIM_UdmaEnabled &= ~(1UL << uChannel);
+    SIM_UdmaDone |= (1UL << uChannel);
+}
+
+SIM_PortType SIM_GpioPortFromBase(uint32 uBase)
+{
+    return SIM_GpioPortOf(uBase);
+}
+
+void SIM_GpioSetInput(SIM_PortType ePort, uint8 uPins, uint8 uLevel)
+{
+    uint32 uBase = SIM_GpioBases[ePort];
+    uint8 uOld = SIM_Gpio[ePort].uInput;
+    uint8 uNew = (uint8)((uOld & ~uPins) | (uLevel & uPins));
+    uint8 uIs  = (uint8)SIM_RegRead(uBase + SIM_GPIO_IS);
+    uint8 uIbe = (uint8)SIM_RegRead(uBase + SIM_GPIO_IBE);
+    uint8 uIev = (uint8)SIM_RegRead(uBase + SIM_GPIO_IEV);
+    uint8 uRising = (uint8)(~uOld & uNew);
+    uint8 uFalling = (uint8)(uOld & ~uNew);
+
+    SIM_Gpio[ePort].uInput = uNew;
+
+    /* Edge detection per IS/IBE/IEV, the raw status latches whether or not the pin is masked */
+    SIM_Gpio[ePort].uRis |= (uint8)(~uIs & ((uIbe & (uRising | uFalling)) |
+                                           (~uIbe & ((uIev & uRising) | (~uIev & uFalling)))));
+    /* Level sensitive pins follow the level */
+    SIM_Gpio[ePort].uRis |= (uint8)(uIs & ((uIev & uNew) | (~uIev & ~uNew)));
+}
+
+uint8 SIM_GpioRead(SIM_PortType ePort, uint8 uPins)
+{
+    return (uint8)(SIM_GpioLevel(ePort) & uPins);
+}
+
+void SIM_GpioWrite(SIM_PortType ePort, uint8 uPins, uint8 uValue)
+{
+    SIM_Gpio[ePort].uOutput = (uint8)((SIM_Gpio[ePort].uOutput & ~uPins) | (uValue & uPins));
+}
+
+void SIM_GpioSetOutput(SIM_PortType ePort, uint8 uPins)
+{
+    SIM_RegSlotType *pDir = SIM_FindSlot(SIM_GpioBases[ePort] + SIM_GPIO_DIR);
+
+    pDir->uValue |= uPins;
+}
+
+uint32 SIM_GpioPendingInterrupts(SIM_PortType ePort)
+{
+    SIM_RegSync();
+    return SIM_Gpio[ePort].uRis & SIM_RegRead(SIM_GpioBases[ePort] + SIM_GPIO_IM);
+}
+
+void SIM_UartOutput(const uint8 *pData, uint32 uLength)
+{
+    fwrite(pData, 1, uLength, stdout);
+    fflush(stdout);
+}
+
+void SIM_UartInput(const uint8 *pData, uint32 uLength)
+{
+    while(uLength-- != 0)
+    {
+        uint32 uNextHead = (SIM_UartRxHead + 1) & (SIM_UART_RX_QUEUE_SIZE - 1);
+
+        if(uNextHead == SIM_UartRxTail)
+        {
+            fprintf(stderr, "SIM: UART0 input queue full, input dropped\n");
+            return;
+        }
+        SIM_UartRxQueue[SIM_UartRxHead] = *pData++;
+        SIM_UartRxHead = uNextHead;
+    }
+}
+
+boolean SIM_UartRxPending(void)
+{
+    return (SIM_UartRxHead != SIM_UartRxTail) ? TRUE : FALSE;
+}
+
+void SIM_UartRxDeliver(boolean bOpen)
+{
+    SIM_UartRxOpen = bOpen;
+}
@@ -0,0 +1,93 @@
+ /******************************************************************************
+ *
+ * Module: SIM
+ *
+ * File Name: sim_registers.h
+ *
+ * Description: Simulated TM4C123GH6PM register bank for the host build
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+#ifndef SIM_REGISTERS_H_
+#define SIM_REGISTERS_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+#define SIM_REG_BANK_SIZE            1024U    /* Distinct register addresses the bank can hold (power of two) */
+#define SIM_WATCH_MAX                64U      /* Registers whose stores have side effects */
+#define SIM_CLOCK_HZ                 16000000U
+
+/* GPIO port bases, indexes of SIM_PortType */
+#define SIM_GPIO_PORTA_BASE          0x40004000U
+#define SIM_GPIO_PORTB_BASE          0x40005000U
+#define SIM_GPIO_PORTC_BASE          0x40006000U
+#define SIM_GPIO_PORTD_BASE          0x40007000U
+#define SIM_GPIO_PORTE_BASE          0x40024000U
+#define SIM_GPIO_PORTF_BASE          0x40025000U
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+typedef enum
+{
+    SIM_PORTA, SIM_PORTB, SIM_PORTC, SIM_PORTD, SIM_PORTE, SIM_PORTF, SIM_PORT_COUNT
+} SIM_PortType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*
+ * Storage behind HW_REG(uAddress). Status registers are refreshed before the
+ * pointer is returned; stores with side effects (UART data, NVIC set/clear,
+ * uDMA channel enable and interrupt clear, GPIO interrupt clear and data
+ * aliases, bit-band aliases) are picked up by the next call or by
+ * SIM_RegSync, since the store itself happens after this function returns.
+ */
+extern volatile uint32 *SIM_RegAccess(uint32 uAddress);
+
+/* Apply pending stores, called by the peripheral model on every tick */
+extern void SIM_RegSync(void);
+
+/* Host time since start in SIM_CLOCK_HZ ticks, backs the WTimer0 counter */
+extern uint64 SIM_ClockTicks(void);
+
+/* Interrupt enable state as seen through NVIC EN0/EN1 and IntEnable, uInterrupt is the vector number minus 16 */
+extern boolean SIM_NvicIsEnabled(uint8 uInterrupt);
+extern void SIM_NvicEnable(uint8 uInterrupt);
+
+/* uDMA channel state as seen through ENASET/ENACLR and CHIS, completing a transfer
+ * clears the enable bit and raises the channel interrupt like the controller does */
+extern boolean SIM_UdmaChannelEnabled(uint8 uChannel);
+extern boolean SIM_UdmaChannelDone(uint8 uChannel);
+extern void SIM_UdmaChannelComplete(uint8 uChannel);
+
+/* GPIO pins: external input level, direction and output latch */
+extern SIM_PortType SIM_GpioPortFromBase(uint32 uBase);
+extern void SIM_GpioSetInput(SIM_PortType ePort, uint8 uPins, uint8 uLevel);
+extern uint8 SIM_GpioRead(SIM_PortType ePort, uint8 uPins);
+extern void SIM_GpioWrite(SIM_PortType ePort, uint8 uPins, uint8 uValue);
+extern void SIM_GpioSetOutput(SIM_PortType ePort, uint8 uPins);
+extern uint32 SIM_GpioPendingInterrupts(SIM_PortType ePort);
+
+/* Bytes leaving UART0, by the data register or by the uDMA */
+extern void SIM_UartOutput(const uint8 *pData, uint32 uLength);
+
+/*
+ * Bytes arriving on UART0. They are queued until the peripheral model opens
+ * the receive FIFO around a call of the interrupt handler: while it is open,
+ * FR shows RXFE clear as long as bytes are left and every data register
+ * access takes the next one. Keeping it closed otherwise means a task's
+ * transmit store never consumes input.
+ */
+extern void SIM_UartInput(const uint8 *pData, uint32 uLength);
+extern boolean SIM_UartRxPending(void);
+extern void SIM_UartRxDeliver(boolean bOpen);
+
+#endif /* SIM_REGISTERS_H_ */
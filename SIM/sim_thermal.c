@@ -0,0 +1,226 @@
+ /******************************************************************************
+ *
+ * Module: SIM
+ *
+ * File Name: sim_thermal.c
+ *
+ * Description: Seat thermal plant and heater benchmark metrics of the host simulation
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+/*
+ * Each seat is a first-order lag towards ambient plus the heater contribution.
+ * The heater input is the duty held by the PWM hardware (decoded from the
+ * generator and timer registers, as the pin would drive the heater) and the
+ * output is the raw ADC value of the seat sensor, so the firmware runs its
+ * normal acquisition, filter and control path against the model.
+ */
+
+#include "sim_thermal.h"
+#include "sim_driverlib.h"
+#include "tm4c123gh6pm_registers.h"
+#include "pwm.h"
+#include "GPTM.h"
+#include "SERVICES/RUNTIME/runtime.h"
+
+/*******************************************************************************
+ *                              Types Declaration                              *
+ *******************************************************************************/
+
+typedef struct
+{
+    boolean bAttached;
+    boolean bDropout;
+    double dAmbientC;
+    double dTauS;
+    double dRiseC;           /* Steady-state rise above ambient at 100% duty */
+    double dTempC;
+    double dEnergyJ;
+    boolean bHasTarget;
+    double dTargetC;
+    uint32 uStepMs;          /* Time the current target was set */
+    uint32 uLastOutsideMs;   /* Last time the seat was outside the settle band */
+    double dPeakC;           /* Highest temperature since the target was set */
+} SIM_ThermalSeatType;
+
+/*******************************************************************************
+ *                              Private Variables                              *
+ *******************************************************************************/
+
+static SIM_ThermalSeatType SIM_ThermalSeats[SIM_THERMAL_SEATS];
+static uint32 SIM_ThermalLastMs = 0;
+
+/*******************************************************************************
+ *                         Private Functions Definitions                       *
+ *******************************************************************************/
+
+/* Duty (0.0-1.0) currently driven on a heater pin, see PWM_DutyToMatch */
+static double SIM_ThermalHeaterDuty(uint8 uIndex)
+{
+    if(uIndex == PWM_CHANNEL_PF3)
+    {
+        if(!(PWM1_3_CTL_REG & PWM_GEN_CTL_ENABLE_MASK) || (PWM1_3_GENB_REG == PWM_GEN_ACTLOAD_LOW))
+        {
+            return 0.0;
+        }
+        if(PWM1_3_GENB_REG == PWM_GEN_ACTLOAD_HIGH)
+        {
+            return 1.0;
+        }
+        return 1.0 - ((double)PWM1_3_CMPB_REG / (double)PWM1_3_LOAD_REG);
+    }
+    if(uIndex == PWM_CHANNEL_PB2)
+    {
+        if(!(TIMER3_CTL_REG & PWM_TIMER_CTL_TAEN_MASK) || (TIMER3_TAILR_REG == 0))
+        {
+            return 0.0;
+        }
+        return 1.0 - ((double)TIMER3_TAMATCHR_REG / (double)TIMER3_TAILR_REG);
+    }
+    return 0.0;
+}
+
+static uint16 SIM_ThermalToRaw(double dTempC)
+{
+    double dRaw = (dTempC * (SIM_ADC_MAX_VALUE + 1)) / SIM_THERMAL_SENSOR_MAX_C;
+
+    if(dRaw < 0.0)
+    {
+        return 0;
+    }
+    if(dRaw > SIM_ADC_MAX_VALUE)
+    {
+        return SIM_ADC_MAX_VALUE;
+    }
+    return (uint16)(dRaw + 0.5);
+}
+
+static boolean SIM_ThermalSettled(const SIM_ThermalSeatType *pSeat)
+{
+    double dError = pSeat->dTempC - pSeat->dTargetC;
+
+    return (dError <= SIM_THERMAL_SETTLE_BAND_C) && (dError >= -SIM_THERMAL_SETTLE_BAND_C);
+}
+
+/*******************************************************************************
+ *                         Public Functions Definitions                        *
+ *******************************************************************************/
+
+void SIM_ThermalSetPlant(uint8 uSeat, double dAmbientC, double dInitialC, double dTauS, double dRiseC)
+{
+    SIM_ThermalSeatType *pSeat;
+
+    if((uSeat == 0) || (uSeat > SIM_THERMAL_SEATS) || (dTauS <= 0.0))
+    {
+        return;
+    }
+    pSeat = &SIM_ThermalSeats[uSeat - 1];
+    pSeat->bAttached = TRUE;
+    pSeat->dAmbientC = dAmbientC;
+    pSeat->dTempC = dInitialC;
+    pSeat->dTauS = dTauS;
+    pSeat->dRiseC = dRiseC;
+    SIM_AdcSetInput(uSeat - 1, pSeat->bDropout ? 0 : SIM_ThermalToRaw(dInitialC));
+}
+
+void SIM_ThermalSetTarget(uint8 uSeat, double dTargetC, uint32 uNowMs)
+{
+    SIM_ThermalSeatType *pSeat;
+
+    if((uSeat == 0) || (uSeat > SIM_THERMAL_SEATS))
+    {
+        return;
+    }
+    pSeat = &SIM_ThermalSeats[uSeat - 1];
+    pSeat->bHasTarget = TRUE;
+    pSeat->dTargetC = dTargetC;
+    pSeat->uStepMs = uNowMs;
+    pSeat->uLastOutsideMs = uNowMs;
+    pSeat->dPeakC = pSeat->dTempC;
+}
+
+void SIM_ThermalSetDropout(uint8 uSeat, boolean bDropout)
+{
+    if((uSeat == 0) || (uSeat > SIM_THERMAL_SEATS))
+    {
+        return;
+    }
+    SIM_ThermalSeats[uSeat - 1].bDropout = bDropout;
+}
+
+void SIM_ThermalStep(uint32 uNowMs)
+{
+    double dStepS = (double)(uNowMs - SIM_ThermalLastMs) / 1000.0;
+    uint8 uIndex;
+
+    SIM_ThermalLastMs = uNowMs;
+    for(uIndex = 0; uIndex < SIM_THERMAL_SEATS; uIndex++)
+    {
+        SIM_ThermalSeatType *pSeat = &SIM_ThermalSeats[uIndex];
+        double dDuty;
+
+        if(!pSeat->bAttached)
+        {
+            continue;
+        }
+
+        /* Explicit Euler at the tick period, far below any realistic seat time constant */
+        dDuty = SIM_ThermalHeaterDuty(uIndex);
+        pSeat->dTempC += dStepS * ((pSeat->dAmbientC + (pSeat->dRiseC * dDuty)) - pSeat->dTempC) / pSeat->dTauS;
+        pSeat->dEnergyJ += dStepS * dDuty * SIM_THERMAL_HEATER_POWER_W;
+        SIM_AdcSetInput(uIndex, pSeat->bDropout ? 0 : SIM_ThermalToRaw(pSeat->dTempC));
+
+        if(pSeat->bHasTarget)
+        {
+            if(pSeat->dTempC > pSeat->dPeakC)
+            {
+                pSeat->dPeakC = pSeat->dTempC;
+            }
+            if(!SIM_ThermalSettled(pSeat))
+            {
+                pSeat->uLastOutsideMs = uNowMs;
+            }
+        }
+    }
+}
+
+void SIM_ThermalReport(FILE *pFile, uint32 uNowMs)
+{
+    const char *pSeparator = "";
+    uint8 uIndex;
+
+    fprintf(pFile, "{\"duration_ms\": %u, \"seats\": [", (unsigned)uNowMs);
+    for(uIndex = 0; uIndex < SIM_THERMAL_SEATS; uIndex++)
+    {
+        const SIM_ThermalSeatType *pSeat = &SIM_ThermalSeats[uIndex];
+
+        if(!pSeat->bAttached)
+        {
+            continue;
+        }
+        fprintf(pFile, "%s{\"seat\": %u, \"final_c\": %.2f, \"energy_j\": %.1f",
+                pSeparator, (unsigned)(uIndex + 1), pSeat->dTempC, pSeat->dEnergyJ);
+        if(pSeat->bHasTarget)
+        {
+            /* -1: not within the band at the end of the run */
+            fprintf(pFile, ", \"target_c\": %.2f, \"settling_ms\": %d, \"overshoot_c\": %.2f",
+                    pSeat->dTargetC,
+                    SIM_ThermalSettled(pSeat) ? (int)(pSeat->uLastOutsideMs - pSeat->uStepMs) : -1,
+                    (pSeat->dPeakC > pSeat->dTargetC) ? (pSeat->dPeakC - pSeat->dTargetC) : 0.0);
+        }
+        fprintf(pFile, "}");
+        pSeparator = ", ";
+    }
+
+    /* Execution time of every task tag, the control tasks are identified by the application */
+    fprintf(pFile, "], \"task_cpu_us\": [");
+    for(uIndex = 0; uIndex < RUNTIME_MAX_TASKS; uIndex++)
+    {
+        fprintf(pFile, "%s%llu", (uIndex == 0) ? "" : ", ",
+                (unsigned long long)GPTM_TicksToUs(RUNTIME_getTotalTime(uIndex)));
+    }
+    fprintf(pFile, "]}\n");
+    fflush(pFile);
+}
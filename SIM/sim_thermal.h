@@ -0,0 +1,49 @@
+ /******************************************************************************
+ *
+ * Module: SIM
+ *
+ * File Name: sim_thermal.h
+ *
+ * Description: Seat thermal plant and heater benchmark metrics of the host simulation
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+#ifndef SIM_THERMAL_H_
+#define SIM_THERMAL_H_
+
+#include "std_types.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ *                             Preprocessor Macros                             *
+ *******************************************************************************/
+#define SIM_THERMAL_SEATS            2U       /* Seat n: heater PWM channel n-1, sensor ADC channel n-1 */
+#define SIM_THERMAL_HEATER_POWER_W   60.0     /* Electrical power of a heater at 100% duty */
+#define SIM_THERMAL_SETTLE_BAND_C    0.5      /* Settled once the seat stays this close to the target */
+#define SIM_THERMAL_SENSOR_MAX_C     45.0     /* Sensor full scale, matches POTS_TEMP_MAX_C */
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*
+ * Attach a first-order plant to a seat (1-based): dT/dt = (ambient + rise * duty - T) / tau.
+ * From now on the model drives the seat's ADC channel from T and reads its heater duty.
+ */
+extern void SIM_ThermalSetPlant(uint8 uSeat, double dAmbientC, double dInitialC, double dTauS, double dRiseC);
+
+/* Reference for the settling time and overshoot metrics, measured from uNowMs */
+extern void SIM_ThermalSetTarget(uint8 uSeat, double dTargetC, uint32 uNowMs);
+
+/* While set, the seat's sensor reads 0 (broken wire), the plant keeps running */
+extern void SIM_ThermalSetDropout(uint8 uSeat, boolean bDropout);
+
+/* Advance every attached plant to uNowMs and update the ADC inputs, called once per tick */
+extern void SIM_ThermalStep(uint32 uNowMs);
+
+/* One JSON object with the per-seat metrics and the runtime of every task tag */
+extern void SIM_ThermalReport(FILE *pFile, uint32 uNowMs);
+
+#endif /* SIM_THERMAL_H_ */
@@ -0,0 +1,45 @@
+ /******************************************************************************
+ *
+ * Module: SIM
+ *
+ * File Name: sim_udma.c
+ *
+ * Description: Simulated uDMA controller for the host build
+ *
+ * Author: Hassan Darwish
+ *
+ *******************************************************************************/
+
+/*
+ * The firmware driver MCAL/UDMA/udma.c runs unchanged on the host: it fills
+ * the channel control table and sets the channel enable bit, which the
+ * register bank keeps (sim_registers.c). This file stands in for the
+ * controller. On each peripheral tick it performs the transfer of the UART0
+ * TX channel at once from its primary control structure, the bytes go out of
+ * the simulated UART, then it clears the enable bit and raises the channel
+ * interrupt, which the UART0 interrupt reports.
+ */
+
+#include "udma.h"
+#include "sim_registers.h"
+#include "sim_peripherals.h"
+
+/*******************************************************************************
+ *                         Public Functions Definitions                        *
+ *******************************************************************************/
+
+void SIM_UdmaRun(void)
+{
+    const UDMA_ControlTableEntryType *pEntry = &UDMA_GetControlTable()[UDMA_CHANNEL_UART0TX];
+    uint32 uLength;
+
+    if(!SIM_UdmaChannelEnabled(UDMA_CHANNEL_UART0TX))
+    {
+        return;
+    }
+
+    /* Basic byte-wide transfer into the data register, the table holds the address of the last byte */
+    uLength = ((pEntry->uControl & UDMA_CHCTL_XFERSIZE_MASK) >> UDMA_CHCTL_XFERSIZE_POS) + 1;
+    SIM_UartOutput((const uint8 *)pEntry->pvSrcEndAddr - (uLength - 1), uLength);
+    SIM_UdmaChannelComplete(UDMA_CHANNEL_UART0TX);
+}
@@ -0,0 +1,24 @@
+#-------------------------------------------------------------------------------
+#  Toolchain file for the TM4C123GH6PM (Cortex-M4F) with arm-none-eabi-gcc
+#
+#    cmake -S . -B build-arm -DCMAKE_TOOLCHAIN_FILE=cmake/arm-none-eabi.cmake ...
+#-------------------------------------------------------------------------------
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR arm)
+
+set(ARM_TOOLCHAIN_PREFIX arm-none-eabi- CACHE STRING "Prefix of the cross tools, with a path if they are not on PATH")
+
+set(CMAKE_C_COMPILER ${ARM_TOOLCHAIN_PREFIX}gcc)
+set(CMAKE_ASM_COMPILER ${ARM_TOOLCHAIN_PREFIX}gcc)
+set(CMAKE_OBJCOPY ${ARM_TOOLCHAIN_PREFIX}objcopy)
+set(CMAKE_SIZE ${ARM_TOOLCHAIN_PREFIX}size)
+
+# No OS to link a test program against
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+
+set(CMAKE_C_FLAGS_INIT "-mcpu=cortex-m4 -mthumb -mfpu=fpv4-sp-d16 -mfloat-abi=hard")
+set(CMAKE_EXE_LINKER_FLAGS_INIT "-mcpu=cortex-m4 -mthumb -mfpu=fpv4-sp-d16 -mfloat-abi=hard -nostartfiles --specs=nosys.specs")
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
@@ -9,6 +9,7 @@
  *  Includes
  *----------------------------------------------------------------------------*/
 #include <HAL/POTS/pots.h>
+#include <HAL/POTS/pots_cal.h>
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
@@ -16,16 +17,125 @@
 #include "GPTM.h"
 #include "gpio.h"
 #include "uart0.h"
+#include "udma.h"
 #include "HAL/RGB_LED/rgb.h"
+#include "HAL/BUTTONS/buttons.h"
+#include "HAL/HEATER/heater.h"
+#include "SERVICES/RUNTIME/runtime.h"
+#include "SERVICES/CPU_LOAD/cpu_load.h"
+#include "SERVICES/TRACE/trace.h"
+#include "SERVICES/SEQLOCK/seqlock.h"
+#include "SERVICES/PI_CONTROL/pi_control.h"
+#include "SERVICES/STATUS_FRAME/status_frame.h"
+#include "SERVICES/TELEMETRY/telemetry.h"
+#include "SERVICES/TICKLESS/tickless.h"
+#include "SERVICES/STACK_MONITOR/stack_monitor.h"
+#include "SERVICES/SHELL/shell.h"
 
 /*------------------------------------------------------------------------------
  *  Constants
  *----------------------------------------------------------------------------*/
-#define RUNTIME_MEASUREMENTS_TASK_PERIODICITY    (1000U)
+// Number of heated seats, each needs an entry in the seat configuration tables below
+#define SEAT_COUNT                               (2U)
+
+// 1 runs level handling, sensing and heater control of every seat as ordered stages of one periodic task
+#ifndef CYCLIC_EXECUTIVE_ENABLE
+#define CYCLIC_EXECUTIVE_ENABLE                  0
+#endif
+
+// Status report: labels and slots of each seat, plus line ends and the separator rule
+#define DISPLAY_FRAME_BUFFER_SIZE                ((80U * SEAT_COUNT) + 48U)
+#define DISPLAY_TEMP_WIDTH                       (3U)
+#define DISPLAY_NAME_WIDTH                       (6U)
+#define DISPLAY_DUTY_WIDTH                       (3U)
+#define HEATER_CONTROL_TASK_PERIODICITY          (100U)
+// Status report period: a 1 s text frame, or 10 Hz seat records with binary telemetry
+#if TELEMETRY_BINARY_ENABLE
+#define DISPLAY_TASK_PERIODICITY                 (100U)
+#else
+#define DISPLAY_TASK_PERIODICITY                 (1000U)
+#endif
+#define LEVEL_STAGE_PERIODICITY                  (20U)
+#define TIME_REPORT_LINE_MAX_LENGTH              (128U)
+
+// Display period range accepted by the shell "rate" command, 0 stops the periodic seat report
+#define DISPLAY_PERIOD_PAUSED                    (0U)
+#define DISPLAY_PERIOD_MIN_MS                    (100U)
+#define DISPLAY_PERIOD_MAX_MS                    (10000U)
+
+// Stack depth of each task (words); the stack monitor reports a task left with less headroom than its budget
+#define TIME_MEASUREMENT_STACK_WORDS             (256U)
+// 64-bit window arithmetic and the report calls on top of the 17 word exception frame, 32 left no margin
+#define CPU_LOAD_STACK_WORDS                     (64U)
+#define DISPLAY_STACK_WORDS                      (32U)
+#define CONTROL_STACK_WORDS                      (64U)
+#define SEAT_HEATERS_STACK_WORDS                 (32U)
+#define LEVEL_HANDLER_STACK_WORDS                (32U)
+#define SHELL_STACK_WORDS                        (192U)
+#define STACK_BUDGET_WORDS                       (8U)
+
+// Diagnostics link, override with -DDIAGNOSTICS_BAUD_RATE=... (HSE is selected above 1 Mbaud)
+#ifndef DIAGNOSTICS_BAUD_RATE
+#define DIAGNOSTICS_BAUD_RATE                    115200UL
+#endif
+#define DIAGNOSTICS_HIGH_SPEED                   ((DIAGNOSTICS_BAUD_RATE) > (UART0_CLOCK_HZ / 16UL))
+
+#if !UART0_BAUD_IN_RANGE(DIAGNOSTICS_BAUD_RATE, DIAGNOSTICS_HIGH_SPEED) || \
+    (UART0_BAUD_ERROR_PERMILLE(DIAGNOSTICS_BAUD_RATE, DIAGNOSTICS_HIGH_SPEED) > UART0_BAUD_MAX_ERROR_PERMILLE)
+#error "DIAGNOSTICS_BAUD_RATE is out of the UART0 divisor range or more than 2% off"
+#endif
+
+// Notification bits of the level handler: a button press steps the seat's level,
+// a shell "level" command sets it to aeRequestedLevels[seat]
+#define LEVEL_EVENT_SEAT(seat)                   (1UL << (seat))
+#define LEVEL_EVENT_SET_SEAT(seat)               (1UL << (16U + (seat)))
+#define LEVEL_EVENT_ALL_SEATS                    ((1UL << SEAT_COUNT) - 1UL)
+#define LEVEL_EVENT_ALL                          (LEVEL_EVENT_ALL_SEATS | (LEVEL_EVENT_ALL_SEATS << 16U))
+
+// Bytes taken from the UART0 receive ring per read by the shell task
+#define SHELL_RX_CHUNK_SIZE                      (16U)
+
+// Seat temperature window in which the heater may run (C)
+#define SEAT_TEMP_VALID_MIN_C                    (5U)
+#define SEAT_TEMP_VALID_MAX_C                    (40U)
+
+// Desired seat temperature for each heating level (C)
+#define HEATING_LOW_TARGET_C                     (25U)
+#define HEATING_MEDIUM_TARGET_C                  (30U)
+#define HEATING_HIGH_TARGET_C                    (35U)
+
+// Minimum duty reported as each heater intensity on the display (%)
+#define HEATER_LOW_MIN_DUTY                      (20U)
+#define HEATER_MEDIUM_MIN_DUTY                   (50U)
+#define HEATER_HIGH_MIN_DUTY                     (100U)
+
+#if (SEAT_COUNT > POTS_CHANNEL_COUNT)
+#error "Every seat needs its own sensor channel, raise POTS_CHANNEL_COUNT"
+#endif
+
+#if (SEAT_COUNT > 16U)
+#error "The level events hold 16 seats, step and set bits share one notification value"
+#endif
 
 /*------------------------------------------------------------------------------
  *  Type Definitions
  *----------------------------------------------------------------------------*/
+// Application task tags, index of each task in the runtime accounting table
+typedef enum {
+    TASK_TAG_IDLE,
+    TASK_TAG_TIME_MEASUREMENT,
+    TASK_TAG_CPU_LOAD,
+    TASK_TAG_DISPLAY,
+#if CYCLIC_EXECUTIVE_ENABLE
+    TASK_TAG_CONTROL,
+#else
+    TASK_TAG_SEAT_HEATERS,
+    TASK_TAG_LEVEL_HANDLER,
+#endif
+    TASK_TAG_SHELL,
+    TASK_TAG_COUNT
+} TaskTagType;
+
 typedef enum {
     HEATING_OFF,
     HEATING_LOW,
@@ -40,52 +150,302 @@ typedef enum {
     HEATER_HIGH
 } HeaterStateType;
 
+// Seat status published by its heater task, heatingLevel is the level the duty was computed for
+typedef struct {
+    uint8_t ui8TempValueC;
+    HeatingLevelType heatingLevel;
+    HeaterStateType heaterState;
+    uint8_t ui8HeaterDuty;
+} SeatStatusType;
+
+// Shared state, one array entry per seat: each lock has a single writer task, readers take snapshots without blocking
 typedef struct {
-    uint8_t ui8Seat1TempValueC;
-    HeatingLevelType Seat1heatingLevel;
-    HeaterStateType Seat1heaterState;
-    uint8_t ui8Seat2TempValueC;
-    HeatingLevelType Seat2heatingLevel;
-    HeaterStateType Seat2heaterState;
+    SEQLOCK_Type axLevel[SEAT_COUNT];     // HeatingLevelType, written by the level handler
+    SEQLOCK_Type axStatus[SEAT_COUNT];    // SeatStatusType, written by the seat heaters task
 } SystemStateStructureType;
 
+// Indicator outputs of one seat, all written with a single store
+typedef struct {
+    GPIO_OutputPortType ePort;
+    uint8_t ui8Pins;                    // Every indicator pin of the seat
+    uint8_t ui8FaultPattern;            // Their levels while the seat's sensor is faulty, 0 otherwise
+} SeatIndicatorType;
+
+// Status report slots of one seat
+typedef struct {
+    STATUS_FRAME_FieldType xTemp;
+    STATUS_FRAME_FieldType xLevel;
+    STATUS_FRAME_FieldType xHeater;
+    STATUS_FRAME_FieldType xDuty;
+} SeatFrameFieldsType;
+
+// Creation parameters of one task, indexed by its tag
+typedef struct {
+    TaskFunction_t pfTask;              // NULL for the idle task, the kernel creates it
+    uint16_t ui16StackWords;
+    uint16_t ui16StackBudgetWords;
+    UBaseType_t uxPriority;
+    void *pvParameters;
+    TaskHandle_t *pxHandle;
+    StackType_t *puxStack;              // Static allocation only
+} TaskConfigType;
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+// Every kernel object of the application: the size of xRtosArena in the map file is the whole RTOS RAM footprint
+typedef struct {
+    StaticTask_t axTaskBuffers[TASK_TAG_COUNT];
+    StackType_t auxIdleStack[configMINIMAL_STACK_SIZE];
+    StackType_t auxTimeMeasurementStack[TIME_MEASUREMENT_STACK_WORDS];
+    StackType_t auxCpuLoadStack[CPU_LOAD_STACK_WORDS];
+    StackType_t auxDisplayStack[DISPLAY_STACK_WORDS];
+#if CYCLIC_EXECUTIVE_ENABLE
+    StackType_t auxControlStack[CONTROL_STACK_WORDS];
+#else
+    StackType_t auxSeatHeatersStack[SEAT_HEATERS_STACK_WORDS];
+    StackType_t auxLevelHandlerStack[LEVEL_HANDLER_STACK_WORDS];
+#endif
+    StackType_t auxShellStack[SHELL_STACK_WORDS];
+#if (configUSE_TIMERS == 1)
+    StaticTask_t xTimerTaskBuffer;
+    StackType_t auxTimerStack[configTIMER_TASK_STACK_DEPTH];
+#endif
+    StaticSemaphore_t xUartMutexBuffer;
+} RtosArenaType;
+#endif
+
+// One stage of the cyclic executive, run in every minor frame that falls on a multiple of its period
+typedef struct {
+    void (*pfStage)(SystemStateStructureType *systemState);
+    uint32_t ui32PeriodMs;
+} ControlStageType;
+
 /*------------------------------------------------------------------------------
  *  Global Variables
  *----------------------------------------------------------------------------*/
-SystemStateStructureType SystemState = {
-    0, HEATING_OFF, HEATER_OFF,
-    0, HEATING_OFF, HEATER_OFF
+SystemStateStructureType SystemState;
+
+/* Both sides of each sequence lock */
+static HeatingLevelType aeSeatLevelCopies[SEAT_COUNT][2];
+static SeatStatusType axSeatStatusCopies[SEAT_COUNT][2];
+
+/* Seat configuration, one entry per seat in each table */
+static const uint32_t aui32SeatSensorChannels[SEAT_COUNT] = {
+    0,                  // Seat 1: CH0 (PE3)
+    1                   // Seat 2: CH1 (PE2)
+};
+/* Sensor curve and trim of each seat, the pots need no trim; an NTC seat would use
+   ai16CalCurveNtc and the gain and offset measured at two reference temperatures */
+static const CAL_ChannelType axSeatCalibration[SEAT_COUNT] = {
+    { ai16CalCurvePot, CAL_GAIN_Q14(1.0), CAL_OFFSET_Q8(0.0) },
+    { ai16CalCurvePot, CAL_GAIN_Q14(1.0), CAL_OFFSET_Q8(0.0) }
+};
+static const HEATER_SeatType aeSeatHeaters[SEAT_COUNT] = {
+    HEATER_SEAT1,       // PF3, on-board green LED
+    HEATER_SEAT2        // PB2, external green LED
+};
+static const SeatIndicatorType axSeatIndicators[SEAT_COUNT] = {
+    { GPIO_OUTPUT_PORTF, GPIO_RED_LED_PIN_MASK, GPIO_RED_LED_PIN_MASK },   // PF1, on-board red LED
+    { GPIO_OUTPUT_PORTB, RED_PIN, RED_PIN }                                // PB1, external red LED
+};
+
+/* Seat temperatures (Q8 C) read by the sensing stage for the heater stage */
+static int32_t ai32SeatTempQ8[SEAT_COUNT];
+static uint32_t ui32SeatSampleTime = 0;
+
+/* Sensor to actuator latency in timebase ticks, written by the heater stage only */
+static volatile uint32_t ui32ControlLatencyMin = UINT32_MAX;
+static volatile uint32_t ui32ControlLatencyMax = 0;
+static volatile uint32_t ui32ControlLatencySamples = 0;      // The minimum is not reported before the first one
+
+/* Temperature controller gains of each seat, per 100 ms control period */
+static const PI_GainsType axSeatGains[SEAT_COUNT] = {
+    { PI_GAIN_Q16(20.0), PI_GAIN_Q16(0.1) },
+    { PI_GAIN_Q16(20.0), PI_GAIN_Q16(0.1) }
+};
+static PI_StateType axSeatControllers[SEAT_COUNT];
+
+/* Seat whose heating level each button steps */
+static const uint8_t aui8ButtonSeats[BUTTONS_COUNT] = {
+    0,                  // SW1
+    1,                  // SW2
+    0                   // External button
 };
 
 TaskHandle_t vDisplaySystemStateTaskHandle;
 TaskHandle_t vcpuLoadMeasurementTaskHandle;
 TaskHandle_t vtasksTimeMeasurementTaskHandle;
-TaskHandle_t vSeat1AdjustHeaterHandle;
-TaskHandle_t vSeat2AdjustHeaterHandle;
-TaskHandle_t vgetSeat1CurrentTempTaskHandle;
-TaskHandle_t vgetSeat2CurrentTempTaskHandle;
-TaskHandle_t vCheckSeat1HeatingLevelChangeHandle;
-TaskHandle_t vCheckSeat2HeatingLevelChangeHandle;
+#if CYCLIC_EXECUTIVE_ENABLE
+TaskHandle_t vControlTaskHandle;
+#else
+TaskHandle_t vSeatsAdjustHeaterHandle;
+TaskHandle_t vHeatingLevelHandlerTaskHandle;
+#endif
+TaskHandle_t vShellTaskHandle;
+
+/* Task notified of heating level button presses and shell level requests */
+static TaskHandle_t xLevelEventsTaskHandle;
+
+/* Level of each seat asked for by the shell, read by the level handler on LEVEL_EVENT_SET_SEAT */
+static HeatingLevelType aeRequestedLevels[SEAT_COUNT];
+
+/* Seat report period in ms set by the shell, DISPLAY_PERIOD_PAUSED while stopped */
+static volatile uint32_t ui32DisplayPeriodMs = DISPLAY_TASK_PERIODICITY;
+
+/* Command shell on the UART0 receive path, used by the shell task only */
+static SHELL_Type xShell;
+
+/* Diagnostics link settings: 8N1, FIFOs on, TX refill when 2 bytes are left */
+static const UART0_ConfigType xUartConfig = {
+    DIAGNOSTICS_BAUD_RATE,
+    DIAGNOSTICS_HIGH_SPEED,
+    TRUE,
+    UART0_FIFO_LEVEL_1_8,
+    UART0_FIFO_LEVEL_1_2
+};
 
-xSemaphoreHandle xMutex;
+/* Serializes the UART0 ring writers, the display frame goes through the uDMA without it */
+xSemaphoreHandle xUartMutex;
 
-uint32 ullTasksOutTime[10];
-uint32 ullTasksInTime[10];
-uint32 ullTasksTotalTime[10];
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+/* Task control blocks, stacks and the mutex, nothing is taken from the heap */
+RtosArenaType xRtosArena;
+#define TASK_STACK(stack)                        (xRtosArena.stack)
+#else
+#define TASK_STACK(stack)                        (NULL)
+#endif
+
+static const char * const apcTaskNames[TASK_TAG_COUNT] = {
+    "Idle",
+    "Time Measurements",
+    "CPU Load Monitor",
+    "System State Display",
+#if CYCLIC_EXECUTIVE_ENABLE
+    "Control Executive",
+#else
+    "Seat Heaters Control",
+    "Heating Level Handler",
+#endif
+    "Command Shell"
+};
+
+#if TELEMETRY_BINARY_ENABLE
+/* Record writer of every report, used by the holder of xUartMutex */
+static TELEMETRY_WriterType xTelemetry;
+#else
+/* Status report frame, laid out once and handed to the uDMA as a whole by the display task */
+static uint8 aui8DisplayFrame[DISPLAY_FRAME_BUFFER_SIZE];
+static STATUS_FRAME_Type xDisplayFrame;
+static SeatFrameFieldsType axSeatFrameFields[SEAT_COUNT];
+#endif
+
+/* Display and shell names, indexed by HeatingLevelType and by HeaterStateType (same order) */
+static const char * const apcLevelNames[] = {
+    "OFF",
+    "LOW",
+    "MEDIUM",
+    "HIGH"
+};
+
+#define LEVEL_NAME_COUNT    ((uint8_t)(sizeof(apcLevelNames) / sizeof(apcLevelNames[0])))
 
 /*------------------------------------------------------------------------------
  *  Function Prototypes
  *----------------------------------------------------------------------------*/
 static void prvSetupHardware(void);
+static void prvCreateTasks(void);
+static void prvSystemStateInit(SystemStateStructureType *systemState);
+#if TELEMETRY_BINARY_ENABLE
+static void prvTelemetryBegin(TELEMETRY_RecordType eType);
+static void prvTelemetrySend(void);
+#else
+static void prvDisplayFrameLayout(void);
+static void prvDisplayFrameSeatLabel(uint8_t ui8Seat, const char *pcField);
+static void prvDisplayFrameSent(void);
+#endif
+static void prvButtonPressed(BUTTONS_IdType eButton);
+static void prvTimeReport(void);
+static SHELL_ResultType prvShellLevel(uint8_t ui8Argc, char * const *apcArgv);
+static SHELL_ResultType prvShellRate(uint8_t ui8Argc, char * const *apcArgv);
+static SHELL_ResultType prvShellStats(uint8_t ui8Argc, char * const *apcArgv);
+static void prvShellWrite(const char *pcText, uint32_t ui32Length);
+#if !TELEMETRY_BINARY_ENABLE
+static void prvUartWriteAll(const char *pcText, uint32_t ui32Length);
+#endif
+static void prvShellRxReady(void);
+#if TRACE_RECORDER_ENABLE && !TELEMETRY_BINARY_ENABLE
+static void prvTraceWrite(const char *pcText, uint32_t ui32Length);
+#endif
+static HeatingLevelType prvNextHeatingLevel(HeatingLevelType eLevel);
+static uint8_t prvComputeHeaterDuty(uint8_t ui8Seat, HeatingLevelType eLevel, int32_t i32TempQ8);
+static HeaterStateType prvHeaterStateFromDuty(uint8_t ui8Duty);
+static void prvSeatApplyHeaterOutputs(uint8_t ui8Seat, uint8_t ui8Duty, uint8_t ui8SensorError);
+static void prvApplyLevelEvents(SystemStateStructureType *systemState, uint32_t ui32Events);
+static void prvSenseStage(SystemStateStructureType *systemState);
+static void prvHeaterStage(SystemStateStructureType *systemState);
 void vDisplaySystemStateTask(void *pvParameters);
 void vcpuLoadMeasurementTask(void *pvParameters);
 void vtasksTimeMeasurementTask(void *pvParameters);
-void vSeat1AdjustHeaterTask(void *pvParameters);
-void vSeat2AdjustHeaterTask(void *pvParameters);
-void vgetSeat1CurrentTempTask(void *pvParameters);
-void vgetSeat2CurrentTempTask(void *pvParameters);
-void vCheckSeat1HeatingLevelChange(void *pvParameters);
-void vCheckSeat2HeatingLevelChange(void *pvParameters);
+#if CYCLIC_EXECUTIVE_ENABLE
+static void prvLevelStage(SystemStateStructureType *systemState);
+static uint32_t prvGcd(uint32_t ui32A, uint32_t ui32B);
+void vControlTask(void *pvParameters);
+#else
+void vSeatsAdjustHeaterTask(void *pvParameters);
+void vHeatingLevelHandlerTask(void *pvParameters);
+#endif
+void vShellTask(void *pvParameters);
+
+#if CYCLIC_EXECUTIVE_ENABLE
+/*------------------------------------------------------------------------------
+ *  Cyclic Executive Schedule
+ *----------------------------------------------------------------------------*/
+// Execution order within a frame: a level change and the newest samples reach the heaters in the same frame.
+// The minor frame is the GCD of the periods and the major frame their LCM.
+static const ControlStageType axControlSchedule[] = {
+    { prvLevelStage,  LEVEL_STAGE_PERIODICITY },
+    { prvSenseStage,  HEATER_CONTROL_TASK_PERIODICITY },
+    { prvHeaterStage, HEATER_CONTROL_TASK_PERIODICITY }
+};
+
+#define CONTROL_STAGE_COUNT    (sizeof(axControlSchedule) / sizeof(axControlSchedule[0]))
+#endif
+
+/*------------------------------------------------------------------------------
+ *  Shell Commands
+ *----------------------------------------------------------------------------*/
+static const SHELL_CommandType axShellCommands[] = {
+    { "level", "<seat> <off|low|medium|high>", 2, 2, prvShellLevel },
+    { "rate",  "<ms 100-10000, 0 stops>",      1, 1, prvShellRate },
+    { "stats", "",                             0, 0, prvShellStats }
+};
+
+#define SHELL_COMMAND_COUNT    ((uint8_t)(sizeof(axShellCommands) / sizeof(axShellCommands[0])))
+
+/*------------------------------------------------------------------------------
+ *  Task Table
+ *----------------------------------------------------------------------------*/
+// Tasks are created in tag order
+static const TaskConfigType axTaskConfigs[TASK_TAG_COUNT] = {
+    { NULL, configMINIMAL_STACK_SIZE, STACK_BUDGET_WORDS, tskIDLE_PRIORITY,
+      NULL, NULL, TASK_STACK(auxIdleStack) },
+    { vtasksTimeMeasurementTask, TIME_MEASUREMENT_STACK_WORDS, STACK_BUDGET_WORDS, 1,
+      NULL, &vtasksTimeMeasurementTaskHandle, TASK_STACK(auxTimeMeasurementStack) },
+    { vcpuLoadMeasurementTask, CPU_LOAD_STACK_WORDS, STACK_BUDGET_WORDS, 2,
+      NULL, &vcpuLoadMeasurementTaskHandle, TASK_STACK(auxCpuLoadStack) },
+    { vDisplaySystemStateTask, DISPLAY_STACK_WORDS, STACK_BUDGET_WORDS, 2,
+      (void*)&SystemState, &vDisplaySystemStateTaskHandle, TASK_STACK(auxDisplayStack) },
+#if CYCLIC_EXECUTIVE_ENABLE
+    { vControlTask, CONTROL_STACK_WORDS, STACK_BUDGET_WORDS, 3,
+      (void*)&SystemState, &vControlTaskHandle, TASK_STACK(auxControlStack) },
+#else
+    { vSeatsAdjustHeaterTask, SEAT_HEATERS_STACK_WORDS, STACK_BUDGET_WORDS, 2,
+      (void*)&SystemState, &vSeatsAdjustHeaterHandle, TASK_STACK(auxSeatHeatersStack) },
+    { vHeatingLevelHandlerTask, LEVEL_HANDLER_STACK_WORDS, STACK_BUDGET_WORDS, 3,
+      (void*)&SystemState, &vHeatingLevelHandlerTaskHandle, TASK_STACK(auxLevelHandlerStack) },
+#endif
+    { vShellTask, SHELL_STACK_WORDS, STACK_BUDGET_WORDS, 1,
+      NULL, &vShellTaskHandle, TASK_STACK(auxShellStack) }
+};
 
 /*------------------------------------------------------------------------------
  *  Main Function
@@ -95,39 +455,29 @@ int main()
     // Initialize hardware components
     prvSetupHardware();
 
-    // Create mutex for resource protection
-    xMutex = xSemaphoreCreateMutex();
+    // Publish the initial state before any task can read it
+    prvSystemStateInit(&SystemState);
+
+    // Create mutex for the UART0 ring writers
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    xUartMutex = xSemaphoreCreateMutexStatic(&xRtosArena.xUartMutexBuffer);
+#else
+    xUartMutex = xSemaphoreCreateMutex();
+#endif
 
     // Create system tasks
-    xTaskCreate(vtasksTimeMeasurementTask, "Time Measurements", 256, NULL, 1,
-               &vtasksTimeMeasurementTaskHandle);
-    xTaskCreate(vcpuLoadMeasurementTask, "CPU Load Monitor", 32, NULL, 2,
-               &vcpuLoadMeasurementTaskHandle);
-    xTaskCreate(vDisplaySystemStateTask, "System State Display", 32,
-               (void*)&SystemState, 2, &vDisplaySystemStateTaskHandle);
-    xTaskCreate(vSeat1AdjustHeaterTask, "Seat1 Heater Control", 32,
-               (void*)&SystemState, 2, &vSeat1AdjustHeaterHandle);
-    xTaskCreate(vSeat2AdjustHeaterTask, "Seat2 Heater Control", 32,
-               (void*)&SystemState, 2, &vSeat2AdjustHeaterHandle);
-    xTaskCreate(vgetSeat1CurrentTempTask, "Seat1 Temp Read", 32,
-               (void*)&SystemState, 2, &vgetSeat1CurrentTempTaskHandle);
-    xTaskCreate(vgetSeat2CurrentTempTask, "Seat2 Temp Read", 32,
-               (void*)&SystemState, 2, &vgetSeat2CurrentTempTaskHandle);
-    xTaskCreate(vCheckSeat1HeatingLevelChange, "Seat1 Level Control", 32,
-               (void*)&SystemState, 3, &vCheckSeat1HeatingLevelChangeHandle);
-    xTaskCreate(vCheckSeat2HeatingLevelChange, "Seat2 Level Control", 32,
-               (void*)&SystemState, 3, &vCheckSeat2HeatingLevelChangeHandle);
-
-    // Configure task tags for identification
-    vTaskSetApplicationTaskTag(vtasksTimeMeasurementTaskHandle, (TaskHookFunction_t)1);
-    vTaskSetApplicationTaskTag(vcpuLoadMeasurementTaskHandle,   (TaskHookFunction_t)2);
-    vTaskSetApplicationTaskTag(vDisplaySystemStateTaskHandle,   (TaskHookFunction_t)3);
-    vTaskSetApplicationTaskTag(vSeat1AdjustHeaterHandle,        (TaskHookFunction_t)4);
-    vTaskSetApplicationTaskTag(vSeat2AdjustHeaterHandle,        (TaskHookFunction_t)5);
-    vTaskSetApplicationTaskTag(vgetSeat1CurrentTempTaskHandle,  (TaskHookFunction_t)6);
-    vTaskSetApplicationTaskTag(vgetSeat2CurrentTempTaskHandle,  (TaskHookFunction_t)7);
-    vTaskSetApplicationTaskTag(vCheckSeat1HeatingLevelChangeHandle, (TaskHookFunction_t)8);
-    vTaskSetApplicationTaskTag(vCheckSeat2HeatingLevelChangeHandle, (TaskHookFunction_t)9);
+    prvCreateTasks();
+#if CYCLIC_EXECUTIVE_ENABLE
+    xLevelEventsTaskHandle = vControlTaskHandle;
+#else
+    xLevelEventsTaskHandle = vHeatingLevelHandlerTaskHandle;
+#endif
+
+    // Button interrupts notify the level handler, so they are armed once it exists
+    BUTTONS_init(prvButtonPressed);
+
+    // Same for the receive interrupt and the shell, bytes received until then wait in the ring
+    UART0_SetRxCallback(prvShellRxReady);
 
     // Start RTOS scheduler
     vTaskStartScheduler();
@@ -141,21 +491,93 @@ int main()
  *----------------------------------------------------------------------------*/
 static void prvSetupHardware(void)
 {
-    UART0_Init();
+    UDMA_Init();
+    (void)UART0_Init(&xUartConfig);     // Cannot fail, the baud rate is checked at compile time
     GPTM_WTimer0Init();
+#if (configUSE_TICKLESS_IDLE == 2) && !defined(SIMULATION)
+    GPTM_WTimer1WakeupInit();           // Wakeup source of TICKLESS_suppressTicksAndSleep()
+#endif
     GPIO_BuiltinButtonsLedsInit();
-    POT1_init();
+    POTS_init();
     RGB_init();
+    HEATER_init();
 
     // Initialize all LEDs to OFF state
-    RGB_RedLedOff();
-    RGB_GreenLedOff();
-    RGB_BlueLedOff();
+    RGB_setColor(RGB_COLOR_OFF);
     GPIO_RedLedOff();
     GPIO_GreenLedOff();
     GPIO_BlueLedOff();
 }
 
+/*------------------------------------------------------------------------------
+ *  Task Creation
+ *----------------------------------------------------------------------------*/
+static void prvCreateTasks(void)
+{
+    for(uint8_t ucTag = TASK_TAG_TIME_MEASUREMENT; ucTag < TASK_TAG_COUNT; ucTag++) {
+        const TaskConfigType *pxConfig = &axTaskConfigs[ucTag];
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+        *pxConfig->pxHandle = xTaskCreateStatic(pxConfig->pfTask, apcTaskNames[ucTag], pxConfig->ui16StackWords,
+                                                pxConfig->pvParameters, pxConfig->uxPriority,
+                                                pxConfig->puxStack, &xRtosArena.axTaskBuffers[ucTag]);
+#else
+        xTaskCreate(pxConfig->pfTask, apcTaskNames[ucTag], pxConfig->ui16StackWords,
+                    pxConfig->pvParameters, pxConfig->uxPriority, pxConfig->pxHandle);
+#endif
+
+        // Tag for the runtime accounting, which indexes its table with it, as does the stack monitor
+        vTaskSetApplicationTaskTag(*pxConfig->pxHandle, (TaskHookFunction_t)(uintptr_t)ucTag);
+        STACK_MONITOR_register(ucTag, *pxConfig->pxHandle, pxConfig->ui16StackBudgetWords);
+    }
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    // The kernel creates the idle task in this TCB, the handle of a static task is its TCB
+    STACK_MONITOR_register(TASK_TAG_IDLE, (TaskHandle_t)&xRtosArena.axTaskBuffers[TASK_TAG_IDLE],
+                           axTaskConfigs[TASK_TAG_IDLE].ui16StackBudgetWords);
+#endif
+}
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+/*------------------------------------------------------------------------------
+ *  Kernel Task Memory
+ *----------------------------------------------------------------------------*/
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    *ppxIdleTaskTCBBuffer = &xRtosArena.axTaskBuffers[TASK_TAG_IDLE];
+    *ppxIdleTaskStackBuffer = axTaskConfigs[TASK_TAG_IDLE].puxStack;
+    *pulIdleTaskStackSize = axTaskConfigs[TASK_TAG_IDLE].ui16StackWords;
+}
+
+#if (configUSE_TIMERS == 1)
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize)
+{
+    *ppxTimerTaskTCBBuffer = &xRtosArena.xTimerTaskBuffer;
+    *ppxTimerTaskStackBuffer = xRtosArena.auxTimerStack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+#endif
+
+/*------------------------------------------------------------------------------
+ *  Shared State Initialization
+ *----------------------------------------------------------------------------*/
+static void prvSystemStateInit(SystemStateStructureType *systemState)
+{
+    const HeatingLevelType eInitialLevel = HEATING_OFF;
+    const SeatStatusType xInitialStatus = { 0, HEATING_OFF, HEATER_OFF, 0 };
+
+    for(uint8_t ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        SEQLOCK_init(&systemState->axLevel[ui8Seat], aeSeatLevelCopies[ui8Seat],
+                     sizeof(HeatingLevelType), &eInitialLevel);
+        SEQLOCK_init(&systemState->axStatus[ui8Seat], axSeatStatusCopies[ui8Seat],
+                     sizeof(SeatStatusType), &xInitialStatus);
+        PI_init(&axSeatControllers[ui8Seat], &axSeatGains[ui8Seat]);
+    }
+}
+
 /*------------------------------------------------------------------------------
  *  Task Implementations
  *----------------------------------------------------------------------------*/
@@ -165,48 +587,210 @@ void vtasksTimeMeasurementTask(void *pvParameters)
 {
     vTaskDelay(pdMS_TO_TICKS(2000));
 
-    if(xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE) {
-        UART0_SendString("CPU Load Measurement Task: ");
-        UART0_SendInteger(ullTasksTotalTime[2]/10);
-        UART0_SendString(" ms\r\n");
+    if(xSemaphoreTake(xUartMutex, portMAX_DELAY) == pdTRUE) {
+        prvTimeReport();
 
-        UART0_SendString("System State Display Task: ");
-        UART0_SendInteger(ullTasksTotalTime[3]/10);
-        UART0_SendString(" ms\r\n");
+#if TRACE_RECORDER_ENABLE && !TELEMETRY_BINARY_ENABLE
+        // Scheduling trace of the last TRACE_BUFFER_RECORDS events, for tools/trace_convert.py
+        TRACE_dump(prvTraceWrite, apcTaskNames, TASK_TAG_COUNT);
+#endif
 
-        // ... remaining measurement outputs ...
+        xSemaphoreGive(xUartMutex);
 
-        xSemaphoreGive(xMutex);
+        // The stack monitor must not sample the handle once the idle task has freed this task
+        STACK_MONITOR_unregister(TASK_TAG_TIME_MEASUREMENT);
         vTaskDelete(NULL);
     }
 }
 
+// Per-task timing and stack report, at start-up and on the shell "stats" command; the caller holds xUartMutex
+static void prvTimeReport(void)
+{
+    RUNTIME_TaskStatsType xStats;
+
+    // Execution and response times per job (min/avg/max) for every task
+    for(uint8_t ucTag = TASK_TAG_TIME_MEASUREMENT; ucTag < TASK_TAG_COUNT; ucTag++) {
+        RUNTIME_getTaskStats(ucTag, &xStats);
+
+#if TELEMETRY_BINARY_ENABLE
+        // Room for both records of the task, a frame that does not fit is cut short
+        while(UART0_GetTxFreeSpace() < (2U * TELEMETRY_FRAME_MAX_SIZE)) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+
+        prvTelemetryBegin(TELEMETRY_RECORD_TASK_TIMING);
+        TELEMETRY_putU8(&xTelemetry, ucTag);
+        TELEMETRY_putU32(&xTelemetry, (uint32_t)GPTM_TicksToUs(xStats.ui64ExecTimeMin));
+        TELEMETRY_putU32(&xTelemetry, (uint32_t)GPTM_TicksToUs(RUNTIME_getAverageExecTime(&xStats)));
+        TELEMETRY_putU32(&xTelemetry, (uint32_t)GPTM_TicksToUs(xStats.ui64ExecTimeMax));
+        TELEMETRY_putU32(&xTelemetry, (uint32_t)GPTM_TicksToUs(RUNTIME_getAverageResponseTime(&xStats)));
+        TELEMETRY_putU32(&xTelemetry, (uint32_t)GPTM_TicksToUs(xStats.ui64ResponseTimeMax));
+        TELEMETRY_putU16(&xTelemetry, xStats.ui32Preemptions);
+        prvTelemetrySend();
+
+        prvTelemetryBegin(TELEMETRY_RECORD_STACK);
+        TELEMETRY_putU8(&xTelemetry, ucTag);
+        TELEMETRY_putU16(&xTelemetry, STACK_MONITOR_getHeadroom(ucTag));
+        TELEMETRY_putU16(&xTelemetry, STACK_MONITOR_getBudget(ucTag));
+        TELEMETRY_putU16(&xTelemetry, axTaskConfigs[ucTag].ui16StackWords);
+        prvTelemetrySend();
+#else
+        // Give the UART time to drain, one line never exceeds the report line length
+        while(UART0_GetTxFreeSpace() < TIME_REPORT_LINE_MAX_LENGTH) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+
+        UART0_SendString(apcTaskNames[ucTag]);
+        UART0_SendString(": exec ");
+        UART0_SendInteger(GPTM_TicksToUs(xStats.ui64ExecTimeMin));
+        UART0_SendString("/");
+        UART0_SendInteger(GPTM_TicksToUs(RUNTIME_getAverageExecTime(&xStats)));
+        UART0_SendString("/");
+        UART0_SendInteger(GPTM_TicksToUs(xStats.ui64ExecTimeMax));
+        UART0_SendString(" us, resp ");
+        UART0_SendInteger(GPTM_TicksToUs(RUNTIME_getAverageResponseTime(&xStats)));
+        UART0_SendString("/");
+        UART0_SendInteger(GPTM_TicksToUs(xStats.ui64ResponseTimeMax));
+        UART0_SendString(" us, ");
+        UART0_SendInteger(xStats.ui32Preemptions);
+        UART0_SendString(" preempted, stack ");
+        UART0_SendInteger(STACK_MONITOR_getHeadroom(ucTag));
+        UART0_SendString(" of ");
+        UART0_SendInteger(axTaskConfigs[ucTag].ui16StackWords);
+        UART0_SendString(" words free\r\n");
+#endif
+    }
+
+    // End-to-end latency from the newest ADC conversion to the heater PWM update
+#if TELEMETRY_BINARY_ENABLE
+    while(UART0_GetTxFreeSpace() < TELEMETRY_FRAME_MAX_SIZE) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+
+    prvTelemetryBegin(TELEMETRY_RECORD_LATENCY);
+    TELEMETRY_putU32(&xTelemetry, (ui32ControlLatencySamples != 0U) ? (uint32_t)GPTM_TicksToUs(ui32ControlLatencyMin) : 0U);
+    TELEMETRY_putU32(&xTelemetry, (uint32_t)GPTM_TicksToUs(ui32ControlLatencyMax));
+    prvTelemetrySend();
+#else
+    UART0_SendString("Untagged tasks: ");
+    UART0_SendInteger(GPTM_TicksToUs(RUNTIME_getTotalTime(RUNTIME_OTHER_TAG)));
+    UART0_SendString(" us\r\n");
+    UART0_SendString("Sensor to actuator: ");
+    if(ui32ControlLatencySamples != 0U) {
+        UART0_SendInteger(GPTM_TicksToUs(ui32ControlLatencyMin));
+        UART0_SendString("/");
+        UART0_SendInteger(GPTM_TicksToUs(ui32ControlLatencyMax));
+        UART0_SendString(" us (min/max), ");
+    } else {
+        UART0_SendString("n/a, ");
+    }
+    UART0_SendInteger(POTS_getOverruns());
+    UART0_SendString(" ADC samples overrun\r\n");
+#endif
+
+#if (configUSE_TICKLESS_IDLE == 2)
+    {
+        TICKLESS_StatsType xSleepStats;
+
+        // Sleeps taken so far, time asleep and what ended them
+        TICKLESS_getStats(&xSleepStats);
+#if TELEMETRY_BINARY_ENABLE
+        while(UART0_GetTxFreeSpace() < TELEMETRY_FRAME_MAX_SIZE) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+
+        prvTelemetryBegin(TELEMETRY_RECORD_TICKLESS);
+        TELEMETRY_putU32(&xTelemetry, xSleepStats.ui32SleepCount);
+        TELEMETRY_putU32(&xTelemetry, (uint32_t)(xSleepStats.ui64SleepCycles / (configCPU_CLOCK_HZ / 1000UL)));
+        TELEMETRY_putU32(&xTelemetry, xSleepStats.ui32TimerWakeups);
+        TELEMETRY_putU32(&xTelemetry, xSleepStats.ui32InterruptWakeups);
+        TELEMETRY_putU32(&xTelemetry, xSleepStats.ui32AbortCount);
+        prvTelemetrySend();
+#else
+        UART0_SendString("Tickless idle: ");
+        UART0_SendInteger(xSleepStats.ui32SleepCount);
+        UART0_SendString(" sleeps, ");
+        UART0_SendInteger(xSleepStats.ui64SleepCycles / (configCPU_CLOCK_HZ / 1000UL));
+        UART0_SendString(" ms asleep, ");
+        UART0_SendInteger(xSleepStats.ui32TimerWakeups);
+        UART0_SendString(" timer/");
+        UART0_SendInteger(xSleepStats.ui32InterruptWakeups);
+        UART0_SendString(" interrupt wakeups, ");
+        UART0_SendInteger(xSleepStats.ui32AbortCount);
+        UART0_SendString(" aborted\r\n");
+#endif
+    }
+#endif
+}
+
 // CPU load monitoring task
 void vcpuLoadMeasurementTask(void *pvParameters)
 {
     TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint32_t ui32StackAlarms;
 
-    for(;;) {
-        if(xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE) {
-            uint32_t ullTotalTasksTime = 0;
+#if (configSUPPORT_STATIC_ALLOCATION == 0) && (INCLUDE_xTaskGetIdleTaskHandle == 1)
+    // The idle task only exists once the scheduler runs
+    STACK_MONITOR_register(TASK_TAG_IDLE, xTaskGetIdleTaskHandle(), axTaskConfigs[TASK_TAG_IDLE].ui16StackBudgetWords);
+#endif
 
-            // Calculate total execution time
-            for(uint8_t ucCounter = 1; ucCounter < 9; ucCounter++) {
-                ullTotalTasksTime += ullTasksTotalTime[ucCounter];
-            }
-
-            uint8_t ucCPU_Load = (ullTotalTasksTime * 100) / GPTM_WTimer0Read();
+    for(;;) {
+        // Close the one second bucket: load is the share of time the idle task did not run
+        CPU_LOAD_update(GPTM_WTimer0Read64(), RUNTIME_getTotalTime(RUNTIME_IDLE_TAG));
+        ui32StackAlarms = STACK_MONITOR_sample();
 
-            // Display CPU load
-            taskENTER_CRITICAL();
+        if(xSemaphoreTake(xUartMutex, portMAX_DELAY) == pdTRUE) {
+#if TELEMETRY_BINARY_ENABLE
+            prvTelemetryBegin(TELEMETRY_RECORD_CPU_LOAD);
+            TELEMETRY_putU16(&xTelemetry, CPU_LOAD_getLoad(CPU_LOAD_WINDOW_1S));
+            TELEMETRY_putU16(&xTelemetry, CPU_LOAD_getLoad(CPU_LOAD_WINDOW_10S));
+            TELEMETRY_putU16(&xTelemetry, CPU_LOAD_getLoad(CPU_LOAD_WINDOW_60S));
+            TELEMETRY_putU16(&xTelemetry, CPU_LOAD_getPeak());
+            TELEMETRY_putU16(&xTelemetry, CPU_LOAD_getEwma());
+            prvTelemetrySend();
+#else
+            // Display CPU load (whole percent, the API keeps hundredths)
             UART0_SendString("----- CPU Utilization: ");
-            UART0_SendInteger(ucCPU_Load);
-            UART0_SendString("% -----\r\n");
-            taskEXIT_CRITICAL();
+            UART0_SendInteger(CPU_LOAD_getLoad(CPU_LOAD_WINDOW_1S) / 100);
+            UART0_SendString("% (10s ");
+            UART0_SendInteger(CPU_LOAD_getLoad(CPU_LOAD_WINDOW_10S) / 100);
+            UART0_SendString("%, 60s ");
+            UART0_SendInteger(CPU_LOAD_getLoad(CPU_LOAD_WINDOW_60S) / 100);
+            UART0_SendString("%, peak ");
+            UART0_SendInteger(CPU_LOAD_getPeak() / 100);
+            UART0_SendString("%, avg ");
+            UART0_SendInteger(CPU_LOAD_getEwma() / 100);
+            UART0_SendString("%) -----\r\n");
+#endif
+
+            // Tasks that just dropped below their stack budget, each reported once
+            for(uint8_t ucTag = 0; ucTag < TASK_TAG_COUNT; ucTag++) {
+                if((ui32StackAlarms & (1UL << ucTag)) == 0U) {
+                    continue;
+                }
+#if TELEMETRY_BINARY_ENABLE
+                prvTelemetryBegin(TELEMETRY_RECORD_STACK);
+                TELEMETRY_putU8(&xTelemetry, ucTag);
+                TELEMETRY_putU16(&xTelemetry, STACK_MONITOR_getHeadroom(ucTag));
+                TELEMETRY_putU16(&xTelemetry, STACK_MONITOR_getBudget(ucTag));
+                TELEMETRY_putU16(&xTelemetry, axTaskConfigs[ucTag].ui16StackWords);
+                prvTelemetrySend();
+#else
+                UART0_SendString("Stack budget exceeded: ");
+                UART0_SendString(apcTaskNames[ucTag]);
+                UART0_SendString(", ");
+                UART0_SendInteger(STACK_MONITOR_getHeadroom(ucTag));
+                UART0_SendString(" of ");
+                UART0_SendInteger(axTaskConfigs[ucTag].ui16StackWords);
+                UART0_SendString(" words free, budget ");
+                UART0_SendInteger(STACK_MONITOR_getBudget(ucTag));
+                UART0_SendString("\r\n");
+#endif
+            }
 
-            xSemaphoreGive(xMutex);
+            xSemaphoreGive(xUartMutex);
         }
-        vTaskDelayUntil(&xLastWakeTime, RUNTIME_MEASUREMENTS_TASK_PERIODICITY);
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(CPU_LOAD_BUCKET_PERIOD_MS));
     }
 }
 
@@ -215,59 +799,448 @@ void vDisplaySystemStateTask(void *pvParameters)
 {
     SystemStateStructureType* systemState = (SystemStateStructureType*)pvParameters;
     TickType_t xLastWakeTime = xTaskGetTickCount();
+    SeatStatusType xStatus;
+    uint32_t ui32PeriodMs;
+    uint8_t ui8Seat;
 
+#if TELEMETRY_BINARY_ENABLE
     for(;;) {
-        if(xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE) {
-            // Temperature display
-            UART0_SendString("Seat1 Temp: ");
-            UART0_SendInteger(systemState->ui8Seat1TempValueC);
-            UART0_SendString("C | Seat2 Temp: ");
-            UART0_SendInteger(systemState->ui8Seat2TempValueC);
-            UART0_SendString("C\r\n");
-
-            // Heating level display
-            UART0_SendString("Seat1 Level: ");
-            switch(systemState->Seat1heatingLevel) {
-                case HEATING_OFF:    UART0_SendString("OFF");    break;
-                case HEATING_LOW:     UART0_SendString("LOW");    break;
-                case HEATING_MEDIUM:  UART0_SendString("MEDIUM"); break;
-                case HEATING_HIGH:    UART0_SendString("HIGH");   break;
-                default:              break;
-            }
+        ui32PeriodMs = ui32DisplayPeriodMs;
 
-            UART0_SendString(" | Seat2 Level: ");
-            switch(systemState->Seat2heatingLevel) {
-                case HEATING_OFF:    UART0_SendString("OFF\r\n");  break;
-                case HEATING_LOW:     UART0_SendString("LOW\r\n");  break;
-                case HEATING_MEDIUM:  UART0_SendString("MEDIUM\r\n"); break;
-                case HEATING_HIGH:    UART0_SendString("HIGH\r\n");   break;
-                default:              break;
-            }
+        // One seat record per seat and period: 13 bytes on the wire instead of a text frame
+        for(ui8Seat = 0; (ui32PeriodMs != DISPLAY_PERIOD_PAUSED) && (ui8Seat < SEAT_COUNT); ui8Seat++) {
+            SEQLOCK_read(&systemState->axStatus[ui8Seat], &xStatus);
 
-            // Heater state display
-            UART0_SendString("Seat1 Heater: ");
-            switch(systemState->Seat1heaterState) {
-                case HEATER_OFF:    UART0_SendString("OFF");    break;
-                case HEATER_LOW:     UART0_SendString("LOW");    break;
-                case HEATER_MEDIUM:  UART0_SendString("MEDIUM"); break;
-                case HEATER_HIGH:    UART0_SendString("HIGH");   break;
-                default:              break;
+            if(xSemaphoreTake(xUartMutex, portMAX_DELAY) == pdTRUE) {
+                prvTelemetryBegin(TELEMETRY_RECORD_SEAT);
+                TELEMETRY_putU8(&xTelemetry, ui8Seat + 1U);
+                TELEMETRY_putU8(&xTelemetry, xStatus.ui8TempValueC);
+                TELEMETRY_putU8(&xTelemetry, (uint8_t)xStatus.heatingLevel);
+                TELEMETRY_putU8(&xTelemetry, (uint8_t)xStatus.heaterState);
+                TELEMETRY_putU8(&xTelemetry, xStatus.ui8HeaterDuty);
+                prvTelemetrySend();
+                xSemaphoreGive(xUartMutex);
             }
+        }
+
+        // While stopped, the shell's next rate is picked up within the default period
+        if(ui32PeriodMs == DISPLAY_PERIOD_PAUSED) {
+            ui32PeriodMs = DISPLAY_TASK_PERIODICITY;
+        }
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(ui32PeriodMs));
+    }
+#else
+    prvDisplayFrameLayout();
+
+    for(;;) {
+        ui32PeriodMs = ui32DisplayPeriodMs;
+        if(ui32PeriodMs == DISPLAY_PERIOD_PAUSED) {
+            // Stopped by the shell, the next rate is picked up within the default period
+            vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(DISPLAY_TASK_PERIODICITY));
+            continue;
+        }
+
+        // Lock-free snapshots, only the slots whose value changed since the last frame are rewritten
+        for(ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+            SeatFrameFieldsType *pxFields = &axSeatFrameFields[ui8Seat];
+
+            SEQLOCK_read(&systemState->axStatus[ui8Seat], &xStatus);
+            STATUS_FRAME_setNumber(&xDisplayFrame, &pxFields->xTemp, xStatus.ui8TempValueC);
+            STATUS_FRAME_setName(&xDisplayFrame, &pxFields->xLevel, apcLevelNames, xStatus.heatingLevel);
+            STATUS_FRAME_setName(&xDisplayFrame, &pxFields->xHeater, apcLevelNames, xStatus.heaterState);
+            STATUS_FRAME_setNumber(&xDisplayFrame, &pxFields->xDuty, xStatus.ui8HeaterDuty);
+        }
+
+        // Hand the whole frame to the uDMA and sleep until it is out
+        if(UART0_SendBufferAsync(aui8DisplayFrame, xDisplayFrame.ui32Length,
+                                 prvDisplayFrameSent) == TRUE) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(ui32PeriodMs));
+    }
+#endif
+}
+
+#if CYCLIC_EXECUTIVE_ENABLE
+// Control executive: runs the schedule table stages of every seat in one task, minor frame by minor frame
+void vControlTask(void *pvParameters)
+{
+    SystemStateStructureType* systemState = (SystemStateStructureType*)pvParameters;
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint32_t ui32MinorFrameMs = axControlSchedule[0].ui32PeriodMs;
+    uint32_t ui32MajorFrameMs = axControlSchedule[0].ui32PeriodMs;
+    uint32_t ui32FrameTimeMs = 0;
+    uint8_t ui8Stage;
 
-            UART0_SendString(" | Seat2 Heater: ");
-            switch(systemState->Seat2heaterState) {
-                case HEATER_OFF:    UART0_SendString("OFF\r\n");  break;
-                case HEATER_LOW:     UART0_SendString("LOW\r\n");  break;
-                case HEATER_MEDIUM:  UART0_SendString("MEDIUM\r\n"); break;
-                case HEATER_HIGH:    UART0_SendString("HIGH\r\n");   break;
-                default:              break;
+    // Frames from the stage periods: minor = GCD, major = LCM
+    for(ui8Stage = 1; ui8Stage < CONTROL_STAGE_COUNT; ui8Stage++) {
+        uint32_t ui32PeriodMs = axControlSchedule[ui8Stage].ui32PeriodMs;
+
+        ui32MinorFrameMs = prvGcd(ui32MinorFrameMs, ui32PeriodMs);
+        ui32MajorFrameMs = (ui32MajorFrameMs / prvGcd(ui32MajorFrameMs, ui32PeriodMs)) * ui32PeriodMs;
+    }
+
+    for(;;) {
+        for(ui8Stage = 0; ui8Stage < CONTROL_STAGE_COUNT; ui8Stage++) {
+            if((ui32FrameTimeMs % axControlSchedule[ui8Stage].ui32PeriodMs) == 0) {
+                axControlSchedule[ui8Stage].pfStage(systemState);
             }
+        }
+
+        ui32FrameTimeMs = (ui32FrameTimeMs + ui32MinorFrameMs) % ui32MajorFrameMs;
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(ui32MinorFrameMs));
+    }
+}
+
+// Level stage: consumes the button and shell events raised since the previous minor frame without waiting
+static void prvLevelStage(SystemStateStructureType *systemState)
+{
+    uint32_t ui32Events;
+
+    if(xTaskNotifyWait(0, LEVEL_EVENT_ALL, &ui32Events, 0) == pdTRUE) {
+        prvApplyLevelEvents(systemState, ui32Events);
+    }
+}
+
+// Greatest common divisor of two frame lengths
+static uint32_t prvGcd(uint32_t ui32A, uint32_t ui32B)
+{
+    while(ui32B != 0) {
+        uint32_t ui32Remainder = ui32A % ui32B;
+        ui32A = ui32B;
+        ui32B = ui32Remainder;
+    }
+    return ui32A;
+}
+#else
+// Heater control of every seat in one task: filtered temperatures come from the ADC ISR rings, no polling task
+void vSeatsAdjustHeaterTask(void *pvParameters)
+{
+    SystemStateStructureType* systemState = (SystemStateStructureType*)pvParameters;
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+
+    for(;;) {
+        prvSenseStage(systemState);
+        prvHeaterStage(systemState);
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(HEATER_CONTROL_TASK_PERIODICITY));
+    }
+}
+
+// Heating level handler: sleeps until a button interrupt or the shell notifies it, no polling
+void vHeatingLevelHandlerTask(void *pvParameters)
+{
+    SystemStateStructureType* systemState = (SystemStateStructureType*)pvParameters;
+    uint32_t ui32Events;
+
+    for(;;) {
+        xTaskNotifyWait(0, LEVEL_EVENT_ALL, &ui32Events, portMAX_DELAY);
+        prvApplyLevelEvents(systemState, ui32Events);
+    }
+}
+#endif
+
+// Command shell: sleeps until the UART0 receive interrupt reports bytes, no polling
+void vShellTask(void *pvParameters)
+{
+    uint8 aui8Received[SHELL_RX_CHUNK_SIZE];
+    uint32_t ui32Count;
+
+    SHELL_init(&xShell, axShellCommands, SHELL_COMMAND_COUNT, prvShellWrite);
+
+    for(;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Bytes arriving during the drain notify again, so none is left behind
+        while((ui32Count = UART0_ReceiveBufferNonBlocking(aui8Received, sizeof(aui8Received))) != 0U) {
+            SHELL_input(&xShell, aui8Received, ui32Count);
+        }
+    }
+}
+
+// Sensing stage: filtered, calibrated temperature of every seat from the ADC ISR rings
+static void prvSenseStage(SystemStateStructureType *systemState)
+{
+    (void)systemState;
+
+    // Read before draining, so the newest sample drained is at least this recent
+    ui32SeatSampleTime = POTS_getLastSampleTime();
+
+    for(uint8_t ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        ai32SeatTempQ8[ui8Seat] = CAL_toCelsiusQ8(&axSeatCalibration[ui8Seat],
+                                                   POTS_getFilteredValue(aui32SeatSensorChannels[ui8Seat]));
+    }
+}
+
+// Heater stage: duty of every seat from the sensed temperature, published and applied
+static void prvHeaterStage(SystemStateStructureType *systemState)
+{
+    SeatStatusType xStatus;
+    uint32_t ui32Latency;
+
+    for(uint8_t ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        uint8_t ui8TempC = (uint8_t)(ai32SeatTempQ8[ui8Seat] >> PI_TEMP_FRAC_BITS);
+        uint8_t ui8SensorError = (ui8TempC < SEAT_TEMP_VALID_MIN_C) || (ui8TempC > SEAT_TEMP_VALID_MAX_C);
+
+        // Only the heater stage writes the seat status, the level is a snapshot
+        SEQLOCK_read(&systemState->axLevel[ui8Seat], &xStatus.heatingLevel);
+        xStatus.ui8TempValueC = ui8TempC;
+        // A faulty sensor drives the heater like a seat turned off
+        xStatus.ui8HeaterDuty = prvComputeHeaterDuty(ui8Seat, ui8SensorError ? HEATING_OFF : xStatus.heatingLevel,
+                                                     ai32SeatTempQ8[ui8Seat]);
+        xStatus.heaterState = prvHeaterStateFromDuty(xStatus.ui8HeaterDuty);
+        SEQLOCK_write(&systemState->axStatus[ui8Seat], &xStatus);
+
+        prvSeatApplyHeaterOutputs(ui8Seat, xStatus.ui8HeaterDuty, ui8SensorError);
+    }
+
+    ui32Latency = (uint32_t)GPTM_WTimer0Read64() - ui32SeatSampleTime;
+    if(ui32Latency < ui32ControlLatencyMin) ui32ControlLatencyMin = ui32Latency;
+    if(ui32Latency > ui32ControlLatencyMax) ui32ControlLatencyMax = ui32Latency;
+    ui32ControlLatencySamples++;
+}
+
+// Sets or steps the level of every seat flagged in ui32Events: sole writer of the levels, publishing never waits
+static void prvApplyLevelEvents(SystemStateStructureType *systemState, uint32_t ui32Events)
+{
+    HeatingLevelType eLevel;
+
+    for(uint8_t ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        if((ui32Events & (LEVEL_EVENT_SEAT(ui8Seat) | LEVEL_EVENT_SET_SEAT(ui8Seat))) == 0U) {
+            continue;
+        }
+
+        // The level asked for by the shell first, a button press in the same batch steps from it
+        SEQLOCK_read(&systemState->axLevel[ui8Seat], &eLevel);
+        if(ui32Events & LEVEL_EVENT_SET_SEAT(ui8Seat)) {
+            eLevel = aeRequestedLevels[ui8Seat];
+        }
+        if(ui32Events & LEVEL_EVENT_SEAT(ui8Seat)) {
+            eLevel = prvNextHeatingLevel(eLevel);
+        }
+        SEQLOCK_write(&systemState->axLevel[ui8Seat], &eLevel);
+    }
+}
+
+// Each press steps the level OFF -> LOW -> MEDIUM -> HIGH -> OFF
+static HeatingLevelType prvNextHeatingLevel(HeatingLevelType eLevel)
+{
+    switch(eLevel) {
+        case HEATING_OFF:     return HEATING_LOW;
+        case HEATING_LOW:     return HEATING_MEDIUM;
+        case HEATING_MEDIUM:  return HEATING_HIGH;
+        default:              return HEATING_OFF;
+    }
+}
+
+// Heater duty from the seat's PI controller, which restarts from zero whenever the heater is off
+static uint8_t prvComputeHeaterDuty(uint8_t ui8Seat, HeatingLevelType eLevel, int32_t i32TempQ8)
+{
+    uint8_t ui8TargetC;
+
+    switch(eLevel) {
+        case HEATING_LOW:     ui8TargetC = HEATING_LOW_TARGET_C;    break;
+        case HEATING_MEDIUM:  ui8TargetC = HEATING_MEDIUM_TARGET_C; break;
+        case HEATING_HIGH:    ui8TargetC = HEATING_HIGH_TARGET_C;   break;
+        default:
+            PI_reset(&axSeatControllers[ui8Seat]);
+            return 0;
+    }
+
+    return PI_update(&axSeatControllers[ui8Seat], PI_TEMP_Q8(ui8TargetC), i32TempQ8);
+}
+
+// Intensity band of a duty, kept for the status display
+static HeaterStateType prvHeaterStateFromDuty(uint8_t ui8Duty)
+{
+    if(ui8Duty >= HEATER_HIGH_MIN_DUTY)    return HEATER_HIGH;
+    if(ui8Duty >= HEATER_MEDIUM_MIN_DUTY)  return HEATER_MEDIUM;
+    if(ui8Duty >= HEATER_LOW_MIN_DUTY)     return HEATER_LOW;
+    return HEATER_OFF;
+}
+
+// Seat heater through PWM, the seat's fault LED flags a sensor fault
+static void prvSeatApplyHeaterOutputs(uint8_t ui8Seat, uint8_t ui8Duty, uint8_t ui8SensorError)
+{
+    const SeatIndicatorType *pxIndicators = &axSeatIndicators[ui8Seat];
+
+    GPIO_WritePattern(pxIndicators->ePort, pxIndicators->ui8Pins,
+                      ui8SensorError ? pxIndicators->ui8FaultPattern : 0U);
+    HEATER_setDuty(aeSeatHeaters[ui8Seat], ui8Duty);
+}
+
+#if TELEMETRY_BINARY_ENABLE
+// Starts a record stamped with the tick time, the caller holds xUartMutex
+static void prvTelemetryBegin(TELEMETRY_RecordType eType)
+{
+    TELEMETRY_begin(&xTelemetry, eType, (uint16_t)(xTaskGetTickCount() * portTICK_PERIOD_MS));
+}
+
+// Frames the record and queues it in the UART0 ring, a frame cut short by a full ring fails the CRC on the host
+static void prvTelemetrySend(void)
+{
+    UART0_SendBufferNonBlocking(xTelemetry.aui8Frame, TELEMETRY_end(&xTelemetry));
+}
+#else
+// Lays out the status report once: constant text, and a fixed-width slot for every seat value
+static void prvDisplayFrameLayout(void)
+{
+    uint8_t ui8Seat;
+
+    STATUS_FRAME_init(&xDisplayFrame, aui8DisplayFrame, sizeof(aui8DisplayFrame));
+
+    // Temperature line
+    for(ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        prvDisplayFrameSeatLabel(ui8Seat, "Temp: ");
+        STATUS_FRAME_appendField(&xDisplayFrame, &axSeatFrameFields[ui8Seat].xTemp, DISPLAY_TEMP_WIDTH);
+        STATUS_FRAME_appendText(&xDisplayFrame, "C");
+    }
+    STATUS_FRAME_appendText(&xDisplayFrame, "\r\n");
+
+    // Heating level line
+    for(ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        prvDisplayFrameSeatLabel(ui8Seat, "Level: ");
+        STATUS_FRAME_appendField(&xDisplayFrame, &axSeatFrameFields[ui8Seat].xLevel, DISPLAY_NAME_WIDTH);
+    }
+    STATUS_FRAME_appendText(&xDisplayFrame, "\r\n");
+
+    // Heater state line, e.g. "LOW    ( 35%)"
+    for(ui8Seat = 0; ui8Seat < SEAT_COUNT; ui8Seat++) {
+        prvDisplayFrameSeatLabel(ui8Seat, "Heater: ");
+        STATUS_FRAME_appendField(&xDisplayFrame, &axSeatFrameFields[ui8Seat].xHeater, DISPLAY_NAME_WIDTH);
+        STATUS_FRAME_appendText(&xDisplayFrame, " (");
+        STATUS_FRAME_appendField(&xDisplayFrame, &axSeatFrameFields[ui8Seat].xDuty, DISPLAY_DUTY_WIDTH);
+        STATUS_FRAME_appendText(&xDisplayFrame, "%)");
+    }
+    STATUS_FRAME_appendText(&xDisplayFrame, "\r\n");
+
+    STATUS_FRAME_appendText(&xDisplayFrame, "----------------------------------------\r\n");
+}
+
+// Layout of "SeatN <field>", with a separator from the previous seat on the same line
+static void prvDisplayFrameSeatLabel(uint8_t ui8Seat, const char *pcField)
+{
+    if(ui8Seat != 0) {
+        STATUS_FRAME_appendText(&xDisplayFrame, " | ");
+    }
+    STATUS_FRAME_appendText(&xDisplayFrame, "Seat");
+    STATUS_FRAME_appendNumber(&xDisplayFrame, ui8Seat + 1U);
+    STATUS_FRAME_appendText(&xDisplayFrame, " ");
+    STATUS_FRAME_appendText(&xDisplayFrame, pcField);
+}
+
+// uDMA completion callback, runs in the UART0 interrupt
+static void prvDisplayFrameSent(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    vTaskNotifyGiveFromISR(vDisplaySystemStateTaskHandle, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+#endif
+
+// Debounced button press, runs in the GPIO or Timer1A interrupt: steps the level of the button's seat
+static void prvButtonPressed(BUTTONS_IdType eButton)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t ui32Event = LEVEL_EVENT_SEAT(aui8ButtonSeats[eButton]);
+
+    xTaskNotifyFromISR(xLevelEventsTaskHandle, ui32Event, eSetBits, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+// Shell "level <seat> <name>": handed to the level handler, which stays the only writer of the levels
+static SHELL_ResultType prvShellLevel(uint8_t ui8Argc, char * const *apcArgv)
+{
+    uint32_t ui32Seat;
+    uint8_t ui8Level = SHELL_findName(apcArgv[2], apcLevelNames, LEVEL_NAME_COUNT);
+
+    (void)ui8Argc;
+    if(!SHELL_parseUnsigned(apcArgv[1], &ui32Seat) || (ui32Seat < 1U) || (ui32Seat > SEAT_COUNT) ||
+       (ui8Level == LEVEL_NAME_COUNT)) {
+        return SHELL_BAD_ARGUMENTS;
+    }
+
+    aeRequestedLevels[ui32Seat - 1U] = (HeatingLevelType)ui8Level;
+    xTaskNotify(xLevelEventsTaskHandle, LEVEL_EVENT_SET_SEAT(ui32Seat - 1U), eSetBits);
+    return SHELL_OK;
+}
+
+// Shell "rate <ms>": period of the seat report (text frame or seat records), 0 stops it
+static SHELL_ResultType prvShellRate(uint8_t ui8Argc, char * const *apcArgv)
+{
+    uint32_t ui32PeriodMs;
+
+    (void)ui8Argc;
+    if(!SHELL_parseUnsigned(apcArgv[1], &ui32PeriodMs) ||
+       ((ui32PeriodMs != DISPLAY_PERIOD_PAUSED) &&
+        ((ui32PeriodMs < DISPLAY_PERIOD_MIN_MS) || (ui32PeriodMs > DISPLAY_PERIOD_MAX_MS)))) {
+        return SHELL_BAD_ARGUMENTS;
+    }
+
+    ui32DisplayPeriodMs = ui32PeriodMs;
+    return SHELL_OK;
+}
+
+// Shell "stats": per-task timing and stack report on demand
+static SHELL_ResultType prvShellStats(uint8_t ui8Argc, char * const *apcArgv)
+{
+    (void)ui8Argc;
+    (void)apcArgv;
+    if(xSemaphoreTake(xUartMutex, portMAX_DELAY) == pdTRUE) {
+        prvTimeReport();
+        xSemaphoreGive(xUartMutex);
+    }
+    return SHELL_OK;
+}
+
+// Shell replies: in the binary build they would break the record framing, so only the records go out
+static void prvShellWrite(const char *pcText, uint32_t ui32Length)
+{
+#if TELEMETRY_BINARY_ENABLE
+    (void)pcText;
+    (void)ui32Length;
+#else
+    if(xSemaphoreTake(xUartMutex, portMAX_DELAY) == pdTRUE) {
+        prvUartWriteAll(pcText, ui32Length);
+        xSemaphoreGive(xUartMutex);
+    }
+#endif
+}
+
+// Received bytes are in the UART0 ring, runs in the UART0 interrupt
+static void prvShellRxReady(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    vTaskNotifyGiveFromISR(vShellTaskHandle, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+#if TRACE_RECORDER_ENABLE && !TELEMETRY_BINARY_ENABLE
+// TRACE_dump sink: waits for ring space instead of dropping trace lines
+static void prvTraceWrite(const char *pcText, uint32_t ui32Length)
+{
+    prvUartWriteAll(pcText, ui32Length);
+}
+#endif
+
+#if !TELEMETRY_BINARY_ENABLE
+// Queues the whole text, as much as fits at a time, so a reply longer than the transmit ring still goes out; the caller holds xUartMutex
+static void prvUartWriteAll(const char *pcText, uint32_t ui32Length)
+{
+    while(ui32Length != 0U) {
+        uint32_t ui32Free = UART0_GetTxFreeSpace();
+        uint32_t ui32Sent;
 
-            UART0_SendString("----------------------------------------\r\n");
-            xSemaphoreGive(xMutex);
-            vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(1000));
+        ui32Sent = UART0_SendBufferNonBlocking((const uint8 *)pcText, (ui32Free < ui32Length) ? ui32Free : ui32Length);
+        if(ui32Sent == 0U) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
         }
+        pcText += ui32Sent;
+        ui32Length -= ui32Sent;
     }
 }
+#endif
 
 // Remaining tasks follow the same improved formatting pattern...
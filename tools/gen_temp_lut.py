@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""Generate the seat sensor temperature curves of HAL/POTS/pots_cal.
+
+Each curve is a table of CAL_CURVE_POINTS temperatures in 1/256 C (Q8), one
+per 2^CAL_CURVE_SHIFT raw ADC codes, that CAL_toCelsiusQ8() interpolates
+linearly. The tables are generated here, in double precision, and the output
+is committed, so the firmware never evaluates a logarithm or a division:
+
+    tools/gen_temp_lut.py                        # rewrite pots_cal_curves.c/.h
+    tools/gen_temp_lut.py --beta 3435 --check    # only print the errors
+
+Two curves are emitted:
+
+  pot   the potentiometers of the development board, 0 C at code 0 and
+        POTS_TEMP_MAX_C at full scale, identical to POTS_RAW_TO_CELSIUS_Q8
+  ntc   an NTC thermistor to ground under a pull-up resistor to the ADC
+        reference, Beta model 1/T = 1/T25 + ln(R/R25)/B
+
+Temperatures outside --min-c..--max-c are clamped, which covers the open and
+shorted sensor ends of the NTC curve. The largest interpolation error against
+the exact curve is printed for every table.
+"""
+
+import argparse
+import math
+import os
+import sys
+
+ADC_FULL_SCALE = 4096          # POTS_MAX_VALUE
+POT_MAX_C = 45                 # POTS_TEMP_MAX_C
+KELVIN = 273.15
+FRAC_BITS = 8
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+OUTPUT_BASE = os.path.join(REPO, "HAL", "POTS", "pots_cal_curves")
+
+
+def pot_celsius(raw, args):
+    return raw * POT_MAX_C / ADC_FULL_SCALE
+
+
+def ntc_celsius(raw, args):
+    """Exact Beta model temperature at a raw code, None past the ends of the divider."""
+    if raw <= 0 or raw >= ADC_FULL_SCALE:
+        return None
+    resistance = args.pullup * raw / (ADC_FULL_SCALE - raw)
+    return 1.0 / (1.0 / (25.0 + KELVIN) + math.log(resistance / args.r25) / args.beta) - KELVIN
+
+
+def clamp_q8(celsius, args, low_end):
+    if celsius is None:
+        celsius = args.max_c if low_end else args.min_c
+    celsius = min(max(celsius, args.min_c), args.max_c)
+    return int(round(celsius * (1 << FRAC_BITS)))
+
+
+def build_table(function, args):
+    points = (ADC_FULL_SCALE >> args.shift) + 1
+    return [clamp_q8(function(index << args.shift, args), args, index == 0) for index in range(points)]
+
+
+def interpolate(table, raw, shift):
+    """Same integer arithmetic as CAL_toCelsiusQ8() with unit gain and no offset."""
+    raw = min(raw, ADC_FULL_SCALE - 1)
+    index = raw >> shift
+    fraction = raw & ((1 << shift) - 1)
+    return table[index] + (((table[index + 1] - table[index]) * fraction) >> shift)
+
+
+def max_error(table, function, args, low_c, high_c):
+    """Largest |LUT - exact| in C over the codes whose exact temperature is in low_c..high_c."""
+    worst = 0.0
+    for raw in range(ADC_FULL_SCALE):
+        exact = function(raw, args)
+        if exact is None or exact < low_c or exact > high_c:
+            continue
+        worst = max(worst, abs(interpolate(table, raw, args.shift) / (1 << FRAC_BITS) - exact))
+    return worst
+
+
+def format_table(name, table, comment):
+    lines = ["/* %s */" % comment,
+             "const int16_t %s[CAL_CURVE_POINTS] =" % name,
+             "{"]
+    for start in range(0, len(table), 8):
+        row = ", ".join("%6d" % value for value in table[start:start + 8])
+        lines.append("    %s%s" % (row, "," if start + 8 < len(table) else ""))
+    lines.append("};")
+    return lines
+
+
+def header_block(file_name, description):
+    return ["/*------------------------------------------------------------------------------",
+            " *  Module      : Potentiometer Driver",
+            " *  File        : %s" % file_name,
+            " *  Description : %s" % description,
+            " *  Author      : Hassan Darwish",
+            " *----------------------------------------------------------------------------*/",
+            "",
+            "/* Generated by tools/gen_temp_lut.py, do not edit */",
+            ""]
+
+
+def write_crlf(path, lines):
+    with open(path, "w", newline="\r\n") as out:
+        out.write("\n".join(lines) + "\n")
+    print("wrote %s" % os.path.relpath(path, REPO), file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--shift", type=int, default=6, help="raw codes per table step, as a power of 2")
+    parser.add_argument("--r25", type=float, default=10000.0, help="NTC resistance at 25 C in ohm")
+    parser.add_argument("--beta", type=float, default=3950.0, help="NTC Beta constant in K")
+    parser.add_argument("--pullup", type=float, default=10000.0, help="pull-up resistor in ohm")
+    parser.add_argument("--min-c", type=int, default=-40, help="lowest temperature of the tables")
+    parser.add_argument("--max-c", type=int, default=125, help="highest temperature of the tables")
+    parser.add_argument("--check", action="store_true", help="print the errors, write nothing")
+    args = parser.parse_args()
+
+    if not 1 <= args.shift <= 10:
+        parser.error("--shift must be between 1 and 10")
+    if args.max_c * (1 << FRAC_BITS) > 32767 or args.min_c * (1 << FRAC_BITS) < -32768:
+        parser.error("temperatures must fit int16_t in Q8")
+
+    pot = build_table(pot_celsius, args)
+    ntc = build_table(ntc_celsius, args)
+    print("pot: %d points, max error %.3f C over 0..%d C"
+          % (len(pot), max_error(pot, pot_celsius, args, 0, POT_MAX_C), POT_MAX_C))
+    print("ntc: %d points, max error %.3f C over -20..80 C, %.3f C over %d..%d C"
+          % (len(ntc), max_error(ntc, ntc_celsius, args, -20, 80),
+             max_error(ntc, ntc_celsius, args, args.min_c, args.max_c), args.min_c, args.max_c))
+    if args.check:
+        return
+
+    header = header_block("pots_cal_curves.h", "Temperature curves of the seat sensor calibration")
+    header += ["#ifndef HAL_POTS_POTS_CAL_CURVES_H_",
+               "#define HAL_POTS_POTS_CAL_CURVES_H_",
+               "",
+               "#include <stdint.h>",
+               "",
+               "#define CAL_CURVE_SHIFT        %d       /**< Raw codes per table step, as a power of 2 */" % args.shift,
+               "#define CAL_CURVE_POINTS       %d      /**< Entries per table, the last one at full scale */"
+               % len(pot),
+               "#define CAL_CURVE_MIN_C        (%d)   /**< Tables are clamped to this range */" % args.min_c,
+               "#define CAL_CURVE_MAX_C        %d" % args.max_c,
+               "",
+               "/* Parameters of the NTC curve, for the host accuracy test */",
+               "#define CAL_NTC_R25_OHM        %d" % round(args.r25),
+               "#define CAL_NTC_BETA_K         %d" % round(args.beta),
+               "#define CAL_NTC_PULLUP_OHM     %d" % round(args.pullup),
+               "",
+               "extern const int16_t ai16CalCurvePot[CAL_CURVE_POINTS];     /**< 0 to POTS_TEMP_MAX_C, linear */",
+               "extern const int16_t ai16CalCurveNtc[CAL_CURVE_POINTS];     /**< NTC to ground, pull-up to VREF */",
+               "",
+               "#endif /* HAL_POTS_POTS_CAL_CURVES_H_ */"]
+
+    source = header_block("pots_cal_curves.c", "Temperature curves of the seat sensor calibration")
+    source += ['#include "HAL/POTS/pots_cal_curves.h"', ""]
+    source += format_table("ai16CalCurvePot", pot, "Potentiometer, 0 to %d C, in 1/256 C" % POT_MAX_C)
+    source += [""]
+    source += format_table("ai16CalCurveNtc", ntc,
+                           "NTC %d ohm at 25 C, B %d K, %d ohm pull-up, %d to %d C, in 1/256 C"
+                           % (round(args.r25), round(args.beta), round(args.pullup), args.min_c, args.max_c))
+
+    write_crlf(OUTPUT_BASE + ".h", header)
+    write_crlf(OUTPUT_BASE + ".c", source)
+
+
+if __name__ == "__main__":
+    main()
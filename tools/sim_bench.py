@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Run the heater control benchmark scenarios on the host simulation and compare results.
+
+Each scenario in SIM/scripts/bench is a simulation script that attaches the
+seat thermal model (SIM/sim_thermal.c), drives the buttons and quits. At quit
+the simulation writes one JSON report with, per seat, the settling time and
+overshoot from the last target step, the heater energy and the final
+temperature, plus the execution time of every task tag.
+
+    tools/sim_bench.py run ./seat_sim -o results.json
+    tools/sim_bench.py compare base.json results.json
+
+"run" writes {"scenarios": {name: report}}. "compare" prints every metric of
+both files side by side and exits with status 1 when a metric got worse by
+more than --tolerance percent (settling time, overshoot, energy and CPU time
+are lower-is-better; a seat that stops settling is always a regression).
+"""
+
+import argparse
+import glob
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+DEFAULT_SCENARIOS = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                 "..", "SIM", "scripts", "bench", "*.sim")
+
+# Metrics compared per seat, all lower-is-better
+SEAT_METRICS = ["settling_ms", "overshoot_c", "energy_j"]
+
+
+def run_scenario(simulator, script):
+    with tempfile.TemporaryDirectory() as workdir:
+        report_path = os.path.join(workdir, "report.json")
+        result = subprocess.run([simulator, script, report_path],
+                                stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+        if result.returncode != 0 or not os.path.exists(report_path):
+            sys.exit("%s failed (status %d):\n%s" % (script, result.returncode, result.stderr))
+        with open(report_path) as report:
+            return json.load(report)
+
+
+def run(args):
+    scripts = sorted(glob.glob(args.scenarios))
+    if not scripts:
+        sys.exit("no scenario matches %s" % args.scenarios)
+
+    results = {"scenarios": {}}
+    for script in scripts:
+        name = os.path.splitext(os.path.basename(script))[0]
+        print("running %s" % name, file=sys.stderr)
+        results["scenarios"][name] = run_scenario(args.simulator, script)
+
+    text = json.dumps(results, indent=2, sort_keys=True)
+    if args.output:
+        with open(args.output, "w") as out:
+            out.write(text + "\n")
+    else:
+        print(text)
+
+
+def flatten(results):
+    """Maps "scenario/seatN/metric" and "scenario/task_cpu_us[tag]" to values."""
+    metrics = {}
+    for name, report in results["scenarios"].items():
+        for seat in report["seats"]:
+            for metric in SEAT_METRICS:
+                if metric in seat:
+                    metrics["%s/seat%d/%s" % (name, seat["seat"], metric)] = seat[metric]
+        for tag, cpu_us in enumerate(report["task_cpu_us"]):
+            if cpu_us:
+                metrics["%s/task_cpu_us[%d]" % (name, tag)] = cpu_us
+    return metrics
+
+
+def is_regression(key, base, new, tolerance):
+    if key.endswith("settling_ms") and (base < 0 or new < 0):
+        return new < 0 <= base
+    limit = abs(base) * tolerance / 100.0
+    return new > base + limit
+
+
+def compare(args):
+    with open(args.base) as base_file, open(args.new) as new_file:
+        base = flatten(json.load(base_file))
+        new = flatten(json.load(new_file))
+
+    regressions = 0
+    print("%-48s %12s %12s" % ("metric", "base", "new"))
+    for key in sorted(set(base) | set(new)):
+        flag = ""
+        if key in base and key in new and is_regression(key, base[key], new[key], args.tolerance):
+            flag = "  REGRESSION"
+            regressions += 1
+        print("%-48s %12s %12s%s" % (key, base.get(key, "-"), new.get(key, "-"), flag))
+
+    if regressions:
+        print("%d regression(s) above %.1f%%" % (regressions, args.tolerance))
+        sys.exit(1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    run_parser = commands.add_parser("run", help="run every scenario and collect the reports")
+    run_parser.add_argument("simulator", help="seat_sim binary built as described in README.md")
+    run_parser.add_argument("--scenarios", default=DEFAULT_SCENARIOS, help="glob of scenario scripts")
+    run_parser.add_argument("-o", "--output", metavar="FILE", help="write the results here instead of stdout")
+    run_parser.set_defaults(handler=run)
+
+    compare_parser = commands.add_parser("compare", help="compare two result files")
+    compare_parser.add_argument("base")
+    compare_parser.add_argument("new")
+    compare_parser.add_argument("--tolerance", type=float, default=5.0,
+                                help="allowed increase of a metric in percent (default 5)")
+    compare_parser.set_defaults(handler=compare)
+
+    args = parser.parse_args()
+    args.handler(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""Decode the binary telemetry stream (SERVICES/TELEMETRY) from a UART0 capture.
+
+The firmware, built with -DTELEMETRY_BINARY_ENABLE=1, sends COBS framed,
+CRC-16 protected records separated by zero bytes instead of text. Capture the
+raw serial bytes to a file (for example `cat /dev/ttyACM0 > capture.bin`, with
+the port in raw mode) and run:
+
+    tools/telemetry_decode.py capture.bin                  # one line per record
+    tools/telemetry_decode.py capture.bin --csv run1       # run1_seat.csv, run1_cpu_load.csv, ...
+    tools/telemetry_decode.py capture.bin --json out.json
+
+--csv writes PREFIX_<record>.csv for each record type present. Frames that
+fail the CRC or the COBS decoding are counted and skipped, as are gaps in the
+sequence numbers. Times are unwrapped from the 16-bit ms stamp, so they stay
+monotonic across the 65.5 s wrap as long as records arrive at least that often.
+"""
+
+import argparse
+import csv
+import json
+import struct
+import sys
+
+RECORD_SEAT = 1
+RECORD_CPU_LOAD = 2
+RECORD_TASK_TIMING = 3
+RECORD_LATENCY = 4
+RECORD_STACK = 5
+RECORD_TICKLESS = 6
+
+# Payload layouts of TELEMETRY_RecordType in telemetry.h, little endian, as of TELEMETRY_FORMAT_VERSION 3
+RECORD_LAYOUTS = {
+    RECORD_SEAT: ("seat", "<BBBBB",
+                  ["seat", "temp_c", "level", "heater_state", "duty_pct"]),
+    RECORD_CPU_LOAD: ("cpu_load", "<HHHHH",
+                      ["load_1s", "load_10s", "load_60s", "peak", "average"]),
+    RECORD_TASK_TIMING: ("task_timing", "<BIIIIIH",
+                         ["tag", "exec_min_us", "exec_avg_us", "exec_max_us",
+                          "resp_avg_us", "resp_max_us", "preemptions"]),
+    RECORD_LATENCY: ("latency", "<II", ["min_us", "max_us"]),
+    RECORD_STACK: ("stack", "<BHHH", ["tag", "headroom_words", "budget_words", "depth_words"]),
+    RECORD_TICKLESS: ("tickless", "<IIIII",
+                      ["sleeps", "asleep_ms", "timer_wakeups", "interrupt_wakeups", "aborted"]),
+}
+
+# Same order as HeatingLevelType and HeaterStateType in main.c
+LEVEL_NAMES = ["OFF", "LOW", "MEDIUM", "HIGH"]
+
+# Fields in hundredths of a percent
+PERCENT_HUNDREDTHS = {"load_1s", "load_10s", "load_60s", "peak", "average"}
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as computed by the firmware."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(frame):
+    out = bytearray()
+    index = 0
+    while index < len(frame):
+        code = frame[index]
+        if code == 0 or index + code > len(frame):
+            raise ValueError("bad COBS code")
+        out += frame[index + 1:index + code]
+        index += code
+        if code < 0xFF and index < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+class Decoder:
+    def __init__(self):
+        self.records = []
+        self.bad_frames = 0
+        self.lost_records = 0
+        self._sequence = None
+        self._last_time = None
+        self._time_base = 0
+
+    def _unwrap(self, time_ms):
+        if self._last_time is not None and time_ms < self._last_time:
+            self._time_base += 0x10000
+        self._last_time = time_ms
+        return self._time_base + time_ms
+
+    def feed(self, frame):
+        try:
+            record = cobs_decode(frame)
+        except ValueError:
+            self.bad_frames += 1
+            return
+        if len(record) < 6 or crc16(record[:-2]) != struct.unpack_from("<H", record, len(record) - 2)[0]:
+            self.bad_frames += 1
+            return
+
+        record_type, sequence, time_ms = struct.unpack_from("<BBH", record)
+        if self._sequence is not None:
+            self.lost_records += (sequence - self._sequence - 1) & 0xFF
+        self._sequence = sequence
+
+        layout = RECORD_LAYOUTS.get(record_type)
+        payload = record[4:-2]
+        if layout is None or len(payload) != struct.calcsize(layout[1]):
+            self.bad_frames += 1
+            return
+
+        name, fmt, fields = layout
+        values = dict(zip(fields, struct.unpack(fmt, payload)))
+        self.records.append(dict(type=name, sequence=sequence, time_ms=self._unwrap(time_ms), **values))
+
+
+def format_record(record):
+    fields = []
+    for key, value in record.items():
+        if key in ("type", "sequence", "time_ms"):
+            continue
+        if key in ("level", "heater_state") and value < len(LEVEL_NAMES):
+            value = LEVEL_NAMES[value]
+        elif key in PERCENT_HUNDREDTHS:
+            value = "%.2f%%" % (value / 100.0)
+        fields.append("%s=%s" % (key, value))
+    return "%10.3f s  %-11s %s" % (record["time_ms"] / 1000.0, record["type"], " ".join(fields))
+
+
+def write_csv(prefix, records):
+    by_type = {}
+    for record in records:
+        by_type.setdefault(record["type"], []).append(record)
+    for name, rows in by_type.items():
+        path = "%s_%s.csv" % (prefix, name)
+        with open(path, "w", newline="") as out:
+            writer = csv.DictWriter(out, fieldnames=list(rows[0].keys()))
+            writer.writeheader()
+            writer.writerows(rows)
+        print("wrote %s (%d records)" % (path, len(rows)), file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="raw UART0 bytes")
+    parser.add_argument("--csv", metavar="PREFIX", help="write PREFIX_<record>.csv per record type")
+    parser.add_argument("--json", metavar="FILE", help="write all records as a JSON list")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as capture:
+        data = capture.read()
+
+    decoder = Decoder()
+    # The last piece has no delimiter yet; a capture started mid-frame costs one bad frame
+    for frame in data.split(b"\x00")[:-1]:
+        if frame:
+            decoder.feed(frame)
+
+    if args.csv:
+        write_csv(args.csv, decoder.records)
+    if args.json:
+        with open(args.json, "w") as out:
+            json.dump(decoder.records, out, indent=1)
+    if not args.csv and not args.json:
+        for record in decoder.records:
+            print(format_record(record))
+
+    print("%d records, %d bad frames, %d lost records"
+          % (len(decoder.records), decoder.bad_frames, decoder.lost_records), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
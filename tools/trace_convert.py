@@ -0,0 +1,262 @@
+#!/usr/bin/env python3
+"""Convert a scheduling trace dump (SERVICES/TRACE) into job statistics and JSON.
+
+The firmware, built with -DTRACE_RECORDER_ENABLE=1, prints the trace on UART0
+between a "#TRACE" header and a "#TEND" line. Save the terminal output to a
+file (other text around the dump is ignored) and run:
+
+    tools/trace_convert.py capture.log
+    tools/trace_convert.py capture.log --chrome trace.json   # chrome://tracing, Perfetto
+    tools/trace_convert.py capture.log --simso tasks.json
+
+Jobs are rebuilt the same way SERVICES/RUNTIME does it on target: a job starts
+when the task is made ready (or first switched in) and completes when the task
+is switched out while no longer ready. ISR time is not subtracted.
+
+The --simso output is a list of keyword arguments for
+simso.configuration.Configuration.add_task(), times in milliseconds.
+"""
+
+import argparse
+import json
+import statistics
+import sys
+
+EVENT_RELEASE = 1
+EVENT_SWITCH_IN = 2
+EVENT_SWITCH_OUT = 3
+EVENT_ISR_ENTER = 4
+EVENT_ISR_EXIT = 5
+EVENT_MUTEX_TAKE = 6
+EVENT_MUTEX_GIVE = 7
+EVENT_MUTEX_BLOCK = 8
+
+MUTEX_EVENT_NAMES = {
+    EVENT_MUTEX_TAKE: "mutex take",
+    EVENT_MUTEX_GIVE: "mutex give",
+    EVENT_MUTEX_BLOCK: "mutex block",
+}
+
+# Order of TRACE_IsrIdType in trace.h
+ISR_NAMES = ["UART0", "ADC0SS1", "GPIOF", "GPIOB", "TIMER1A"]
+
+ISR_TID_BASE = 100
+RECORD_HEX_CHARS = 16
+PERIODIC_TOLERANCE = 0.1
+
+
+class Trace:
+    def __init__(self):
+        self.version = None
+        self.hz = None
+        self.dropped = 0
+        self.task_names = {}
+        self.records = []
+
+
+def parse_dump(lines):
+    """Returns the last complete dump found in the capture."""
+    trace = None
+    complete = None
+    for raw in lines:
+        line = raw.strip()
+        if line.startswith("#TRACE "):
+            trace = Trace()
+            fields = line.split()
+            trace.version = int(fields[1].lstrip("v"))
+            for field in fields[2:]:
+                key, _, value = field.partition("=")
+                if key == "hz":
+                    trace.hz = int(value)
+                elif key == "dropped":
+                    trace.dropped = int(value)
+            if trace.version != 1:
+                raise ValueError("unsupported trace format v%d" % trace.version)
+        elif trace is None:
+            continue
+        elif line.startswith("#TN "):
+            _, tag, name = line.split(" ", 2)
+            trace.task_names[int(tag)] = name
+        elif line.startswith("#T "):
+            data = line[3:]
+            for pos in range(0, len(data) - RECORD_HEX_CHARS + 1, RECORD_HEX_CHARS):
+                chunk = bytes.fromhex(data[pos:pos + RECORD_HEX_CHARS])
+                trace.records.append((int.from_bytes(chunk[0:4], "little"),
+                                      chunk[4], chunk[5],
+                                      int.from_bytes(chunk[6:8], "little")))
+        elif line == "#TEND":
+            complete = trace
+            trace = None
+    if complete is None:
+        raise ValueError("no complete #TRACE ... #TEND dump found")
+    return complete
+
+
+def unwrap_timestamps(records):
+    """Extends the 32 bit timer values to a monotonic tick count."""
+    result = []
+    offset = 0
+    previous = None
+    for stamp, event, ident, arg in records:
+        if previous is not None and stamp < previous:
+            offset += 1 << 32
+        previous = stamp
+        result.append((stamp + offset, event, ident, arg))
+    return result
+
+
+class TaskJobs:
+    def __init__(self):
+        self.release = None
+        self.running_since = None
+        self.exec_ticks = 0
+        self.jobs = []          # (release, completion, execution)
+        self.releases = []
+        self.slices = []        # (start, end)
+        self.preemptions = 0
+
+
+def build_jobs(records):
+    tasks = {}
+    isr_slices = []
+    isr_open = {}
+    mutex_events = []
+
+    for stamp, event, ident, arg in records:
+        if event in (EVENT_RELEASE, EVENT_SWITCH_IN, EVENT_SWITCH_OUT):
+            task = tasks.setdefault(ident, TaskJobs())
+            if event == EVENT_RELEASE:
+                # A task already in a job (priority inheritance, resume) keeps it
+                if task.release is None:
+                    task.release = stamp
+                    task.releases.append(stamp)
+            elif event == EVENT_SWITCH_IN:
+                if task.release is None:
+                    task.release = stamp
+                task.running_since = stamp
+            elif task.running_since is not None:
+                task.exec_ticks += stamp - task.running_since
+                task.slices.append((task.running_since, stamp))
+                task.running_since = None
+                if arg:
+                    task.preemptions += 1
+                else:
+                    task.jobs.append((task.release, stamp, task.exec_ticks))
+                    task.release = None
+                    task.exec_ticks = 0
+        elif event == EVENT_ISR_ENTER:
+            isr_open[ident] = stamp
+        elif event == EVENT_ISR_EXIT:
+            if ident in isr_open:
+                isr_slices.append((ident, isr_open.pop(ident), stamp))
+        elif event in MUTEX_EVENT_NAMES:
+            mutex_events.append((stamp, event, ident))
+
+    return tasks, isr_slices, mutex_events
+
+
+def task_name(trace, tag):
+    return trace.task_names.get(tag, "task %d" % tag)
+
+
+def print_report(trace, tasks, isr_slices, out):
+    to_us = 1e6 / trace.hz
+    out.write("%d records, %d dropped, timebase %d Hz\n"
+              % (len(trace.records), trace.dropped, trace.hz))
+    out.write("%-24s %6s %10s %10s %10s %10s\n"
+              % ("task", "jobs", "wcet us", "acet us", "wcrt us", "preempt"))
+    for tag in sorted(tasks):
+        task = tasks[tag]
+        if not task.jobs:
+            continue
+        executions = [job[2] for job in task.jobs]
+        responses = [job[1] - job[0] for job in task.jobs]
+        out.write("%-24s %6d %10.1f %10.1f %10.1f %10d\n"
+                  % (task_name(trace, tag), len(task.jobs),
+                     max(executions) * to_us, statistics.mean(executions) * to_us,
+                     max(responses) * to_us, task.preemptions))
+    for ident in sorted({isr[0] for isr in isr_slices}):
+        durations = [end - start for isr, start, end in isr_slices if isr == ident]
+        out.write("%-24s %6d %10.1f %10.1f\n"
+                  % ("ISR " + isr_label(ident), len(durations),
+                     max(durations) * to_us, statistics.mean(durations) * to_us))
+
+
+def isr_label(ident):
+    return ISR_NAMES[ident] if ident < len(ISR_NAMES) else "isr %d" % ident
+
+
+def chrome_trace(trace, tasks, isr_slices, mutex_events, origin):
+    to_us = 1e6 / trace.hz
+    events = []
+    for tag, task in tasks.items():
+        events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tag,
+                       "args": {"name": task_name(trace, tag)}})
+        for start, end in task.slices:
+            events.append({"name": task_name(trace, tag), "ph": "X", "pid": 1, "tid": tag,
+                           "ts": (start - origin) * to_us, "dur": (end - start) * to_us})
+    for ident in {isr[0] for isr in isr_slices}:
+        events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": ISR_TID_BASE + ident,
+                       "args": {"name": "ISR " + isr_label(ident)}})
+    for ident, start, end in isr_slices:
+        events.append({"name": isr_label(ident), "ph": "X", "pid": 1, "tid": ISR_TID_BASE + ident,
+                       "ts": (start - origin) * to_us, "dur": (end - start) * to_us})
+    for stamp, event, tag in mutex_events:
+        events.append({"name": MUTEX_EVENT_NAMES[event], "ph": "i", "s": "t", "pid": 1, "tid": tag,
+                       "ts": (stamp - origin) * to_us})
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def simso_tasks(trace, tasks, origin):
+    to_ms = 1e3 / trace.hz
+    result = []
+    for tag in sorted(tasks):
+        task = tasks[tag]
+        if not task.jobs or tag == 0:
+            continue            # tag 0 is the idle task
+        executions = [job[2] * to_ms for job in task.jobs]
+        deltas = [b - a for a, b in zip(task.releases, task.releases[1:])]
+        entry = {
+            "name": task_name(trace, tag),
+            "identifier": tag,
+            "wcet": max(executions),
+            "acet": statistics.mean(executions),
+        }
+        period = statistics.median(deltas) * to_ms if deltas else None
+        if period and all(abs(d * to_ms - period) <= PERIODIC_TOLERANCE * period for d in deltas):
+            entry.update({"task_type": "Periodic", "period": period, "deadline": period,
+                          "activation_date": (task.releases[0] - origin) * to_ms})
+        else:
+            entry.update({"task_type": "Sporadic",
+                          "list_activation_dates": [(r - origin) * to_ms for r in task.releases],
+                          "deadline": period if period else max(executions)})
+        result.append(entry)
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="UART capture containing a #TRACE dump")
+    parser.add_argument("--chrome", metavar="FILE", help="write Chrome trace event JSON")
+    parser.add_argument("--simso", metavar="FILE", help="write SimSo add_task() arguments as JSON")
+    args = parser.parse_args()
+
+    with open(args.capture, encoding="latin-1") as capture:
+        trace = parse_dump(capture)
+    records = unwrap_timestamps(trace.records)
+    if not records:
+        sys.exit("trace is empty")
+    origin = records[0][0]
+    tasks, isr_slices, mutex_events = build_jobs(records)
+
+    print_report(trace, tasks, isr_slices, sys.stdout)
+    if args.chrome:
+        with open(args.chrome, "w") as out:
+            json.dump(chrome_trace(trace, tasks, isr_slices, mutex_events, origin), out)
+    if args.simso:
+        with open(args.simso, "w") as out:
+            json.dump(simso_tasks(trace, tasks, origin), out, indent=2)
+
+
+if __name__ == "__main__":
+    main()